@@ -0,0 +1,128 @@
+// the stand-in server accepts all pooled connections at once
+#define CPPHTTPLIB_LISTEN_BACKLOG 128
+
+#include "Benchmark.h"
+
+#include <thread>
+#include <vector>
+
+#include "CasperClient.h"
+
+using namespace Casper;
+
+namespace
+{
+constexpr size_t kQueries = 2000;
+
+nlohmann::json BalanceReply(const nlohmann::json& call)
+{
+    return {{"jsonrpc", "2.0"},
+            {"id", call.at("id")},
+            {"result", {{"api_version", "1.5.2"}, {"balance_value", "1000000"}, {"merkle_proof", "01"}}}};
+}
+
+/// Mean wall time of one query with `callers` threads each making blocking
+/// calls, one thread per query in flight.
+double MeasureBlocking(const std::string& host, size_t callers)
+{
+    ConnectionPoolConfig pool;
+    pool.max_connections = callers;
+    Client client(host, pool);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < callers; t++)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                for (size_t i = 0; i < kQueries / callers; i++)
+                {
+                    auto balance = client.GetAccountBalance("uref-" + std::to_string(i), "srh");
+                    Benchmark::Consume(balance.merkle_proof.size());
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / static_cast<double>(kQueries);
+}
+
+/// Mean wall time of one query with all of them started at once from one
+/// thread and sent by the executor.
+double MeasureAsync(const std::string& host, const AsyncConfig& config)
+{
+    ConnectionPoolConfig pool;
+    pool.max_connections = config.threads;
+    Client client(host, pool, config);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<AsyncCall<GetBalanceResult>> calls;
+    calls.reserve(kQueries);
+    for (size_t i = 0; i < kQueries; i++)
+    {
+        calls.push_back(client.GetAccountBalanceAsync("uref-" + std::to_string(i), "srh"));
+    }
+    for (auto& call : calls)
+    {
+        Benchmark::Consume(call.Get().merkle_proof.size());
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / static_cast<double>(kQueries);
+}
+
+} // namespace
+
+int main()
+{
+    // stand-in for a node answering single calls and batches
+    httplib::Server server;
+    server.Post("/rpc",
+                [](const httplib::Request& req, httplib::Response& res)
+                {
+                    auto calls = nlohmann::json::parse(req.body);
+                    if (!calls.is_array())
+                    {
+                        res.set_content(BalanceReply(calls).dump(), "application/json");
+                        return;
+                    }
+                    auto replies = nlohmann::json::array();
+                    for (const auto& call : calls)
+                    {
+                        replies.push_back(BalanceReply(call));
+                    }
+                    res.set_content(replies.dump(), "application/json");
+                });
+    server.new_task_queue = [] { return new httplib::ThreadPool(64); };
+    server.set_keep_alive_max_count(1000000);
+    server.set_tcp_nodelay(true);
+    int port = server.bind_to_any_port("127.0.0.1");
+    std::thread listener([&] { server.listen_after_bind(); });
+    while (!server.is_running())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::string host = "http://127.0.0.1:" + std::to_string(port);
+
+    std::printf("%zu balance queries\n", kQueries);
+    for (size_t callers : {1, 8, 64})
+    {
+        Benchmark::Report("blocking, " + std::to_string(callers) + " threads", MeasureBlocking(host, callers));
+    }
+
+    AsyncConfig uncoalesced;
+    uncoalesced.threads = 8;
+    uncoalesced.max_coalesced_calls = 1;
+    Benchmark::Report("async, 8 threads, one call per request", MeasureAsync(host, uncoalesced));
+
+    AsyncConfig coalesced;
+    coalesced.max_coalesced_calls = RpcBatch::DEFAULT_MAX_SIZE;
+    Benchmark::Report("async, 2 threads, coalesced batches", MeasureAsync(host, coalesced));
+
+    server.stop();
+    listener.join();
+    return 0;
+}
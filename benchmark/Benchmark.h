@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace Casper::Benchmark
+{
+/// <summary>
+/// Keeps the compiler from discarding a result that is otherwise unused.
+/// </summary>
+inline volatile uint64_t sink = 0;
+
+template <typename T>
+inline void Consume(const T& value)
+{
+    sink = sink + static_cast<uint64_t>(value);
+}
+
+/// <summary>
+/// Runs `op` `iterations` times after a short warm up and returns the mean
+/// time of one call in nanoseconds.
+/// </summary>
+template <typename Op>
+double Measure(size_t iterations, Op&& op)
+{
+    for (size_t i = 0; i < iterations / 10 + 1; i++)
+    {
+        op();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        op();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / static_cast<double>(iterations);
+}
+
+inline void Report(const std::string& name, double ns_per_op)
+{
+    std::printf("%-48s %12.1f ns/op\n", name.c_str(), ns_per_op);
+}
+
+} // namespace Casper::Benchmark
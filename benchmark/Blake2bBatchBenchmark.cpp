@@ -0,0 +1,79 @@
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "Types/Deploy.h"
+#include "Utils/Blake2bBatch.h"
+
+using namespace Casper;
+
+namespace
+{
+const char* KernelName(Blake2bKernel kernel)
+{
+    return kernel == Blake2bKernel::AVX2 ? "avx2" : "scalar";
+}
+
+/// Hashes `count` inputs of `size` bytes per call.
+void Run(const std::string& label, size_t size, size_t count, size_t iterations)
+{
+    std::vector<uint8_t> data(size * count);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    std::vector<std::span<const uint8_t>> inputs;
+    for (size_t i = 0; i < count; i++)
+    {
+        inputs.emplace_back(data.data() + size * i, size);
+    }
+    std::vector<uint8_t> digests(Blake2bBatch::DIGEST_SIZE * count);
+
+    for (auto kernel : {Blake2bKernel::Scalar, Blake2bKernel::AVX2})
+    {
+        if (!Blake2bBatch::IsSupported(kernel))
+        {
+            continue;
+        }
+        auto hash = [&]
+        {
+            Blake2bBatch::Hash(kernel, inputs, digests.data());
+            Benchmark::Consume(digests[0]);
+        };
+        double ns = Benchmark::Measure(iterations, hash);
+        Benchmark::Report(label + ", " + KernelName(kernel) + ", per input", ns / static_cast<double>(count));
+    }
+}
+
+} // namespace
+
+int main()
+{
+    Run("32 bytes (checksum)", 32, 1024, 200);
+    Run("43 bytes (account hash)", 43, 1024, 200);
+    Run("200 bytes (deploy header)", 200, 1024, 100);
+    Run("4096 bytes", 4096, 64, 100);
+
+    PublicKey account =
+        PublicKey::FromHexString("01cd807fb41345d8dd5a61da7991e1468173acbee53920e4dfe0d28cb8825ac664");
+    std::vector<Deploy> deploys;
+    for (uint64_t id = 0; id < 1000; id++)
+    {
+        DeployHeader header(account, "2022-01-01T00:00:00.000Z", "30m", 1, Hash32(), {}, "casper-test");
+        TransferDeployItem session(u512FromDec("2845678925"), AccountHashKey(account), id, true);
+        deploys.emplace_back(header, ModuleBytes(u512FromDec("100000000")), session);
+    }
+
+    std::string message;
+    auto validate_each = [&]
+    {
+        for (auto& deploy : deploys)
+        {
+            Benchmark::Consume(deploy.ValidateHashes(message));
+        }
+    };
+    Benchmark::Report("1000 deploys, ValidateHashes", Benchmark::Measure(20, validate_each));
+    Benchmark::Report("1000 deploys, ValidateHashesBatch",
+                      Benchmark::Measure(20, [&] { Benchmark::Consume(Deploy::ValidateHashesBatch(deploys)); }));
+    return 0;
+}
@@ -0,0 +1,181 @@
+#include "Benchmark.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "ByteSerializers/ByteWriter.h"
+#include "ByteSerializers/CLValueByteSerializer.h"
+#include "ByteSerializers/DeployByteSerializer.h"
+#include "Types/Deploy.h"
+#include "cryptopp/secblock.h"
+
+using namespace Casper;
+
+namespace
+{
+std::atomic<size_t> allocations{0};
+std::atomic<size_t> allocated_bytes{0};
+
+void CountAllocation(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+/// CryptoPP::SecByteBlock allocates through its allocator and not through
+/// operator new, this one counts those allocations too.
+template <typename T>
+class CountingAllocator : public CryptoPP::AllocatorWithCleanup<T>
+{
+public:
+    using Base = CryptoPP::AllocatorWithCleanup<T>;
+
+    typename Base::pointer allocate(typename Base::size_type size, const void* hint = nullptr)
+    {
+        if (size > 0)
+        {
+            CountAllocation(size * sizeof(T));
+        }
+        return Base::allocate(size, hint);
+    }
+};
+
+/// Allocates like CryptoPP::SecByteBlock, with the allocations counted.
+using CountedSecByteBlock = CryptoPP::SecBlock<CryptoPP::byte, CountingAllocator<CryptoPP::byte>>;
+
+struct AllocationCount
+{
+    double allocations;
+    double bytes;
+};
+
+/// Heap allocations and bytes allocated by `op`, averaged over `iterations`
+/// calls.
+template <typename Op>
+AllocationCount CountAllocations(size_t iterations, Op&& op)
+{
+    op();
+    size_t before = allocations.load(std::memory_order_relaxed);
+    size_t bytes_before = allocated_bytes.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < iterations; i++)
+    {
+        op();
+    }
+    return {static_cast<double>(allocations.load(std::memory_order_relaxed) - before) / iterations,
+            static_cast<double>(allocated_bytes.load(std::memory_order_relaxed) - bytes_before) / iterations};
+}
+
+void ReportAllocations(const std::string& name, AllocationCount count)
+{
+    std::printf("%-48s %12.1f allocs/op %12.1f bytes/op\n", name.c_str(), count.allocations, count.bytes);
+}
+
+/// The small buffers handled when a deploy is built: a public key, a hash and
+/// a signature, each copied once.
+template <typename Buffer>
+size_t CopySmallBuffers(const uint8_t* data)
+{
+    Buffer key(data, 33);
+    Buffer hash(data, 32);
+    Buffer signature(data, 65);
+    Buffer key_copy = key;
+    Buffer hash_copy = hash;
+    return key_copy.size() + hash_copy.size() + signature.size();
+}
+
+Deploy MakeDeploy(const PublicKey& account, const PublicKey& target)
+{
+    DeployHeader header(account, "2022-01-01T00:00:00.000Z", "30m", 1, Hash32(), {}, "casper-test");
+    ModuleBytes payment(u512FromDec("100000000"));
+    TransferDeployItem session(u512FromDec("2845678925"), AccountHashKey(target), 123456789012345u, true);
+    return Deploy(header, payment, session);
+}
+
+/// Bytes of a Map<String, U512> of `count` balances that fit in 64 bits, as
+/// found in contract state.
+ByteWriter MakeBalances(size_t count)
+{
+    ByteWriter bytes;
+    bytes.WriteU32(static_cast<uint32_t>(count));
+    char key[16];
+    for (size_t i = 0; i < count; i++)
+    {
+        std::snprintf(key, sizeof(key), "account-%04zu", i);
+        bytes.WriteString(key);
+        bytes.WriteByte(sizeof(uint64_t));
+        bytes.WriteU64(2500000000ull + i);
+    }
+    return bytes;
+}
+
+} // namespace
+
+void* operator new(size_t size)
+{
+    CountAllocation(size);
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    constexpr size_t kIterations = 20000;
+
+    uint8_t data[65];
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    auto copy_counted_sec_blocks = [&] { Benchmark::Consume(CopySmallBuffers<CountedSecByteBlock>(data)); };
+    auto copy_sec_blocks = [&] { Benchmark::Consume(CopySmallBuffers<CryptoPP::SecByteBlock>(data)); };
+    auto copy_bytes = [&] { Benchmark::Consume(CopySmallBuffers<Bytes>(data)); };
+    ReportAllocations("small buffers, CryptoPP::SecByteBlock",
+                      CountAllocations(kIterations, copy_counted_sec_blocks));
+    ReportAllocations("small buffers, Bytes", CountAllocations(kIterations, copy_bytes));
+    Benchmark::Report("small buffers, CryptoPP::SecByteBlock", Benchmark::Measure(kIterations * 10, copy_sec_blocks));
+    Benchmark::Report("small buffers, Bytes", Benchmark::Measure(kIterations * 10, copy_bytes));
+
+    PublicKey account =
+        PublicKey::FromHexString("01cd807fb41345d8dd5a61da7991e1468173acbee53920e4dfe0d28cb8825ac664");
+    PublicKey target =
+        PublicKey::FromHexString("02035724e2530c5c8f298ba41fe1cafa28294ab7b04d4f1ade025a4a268138570b3a");
+    DeployByteSerializer serializer;
+
+    ReportAllocations("deploy build",
+                      CountAllocations(1000, [&] { Benchmark::Consume(MakeDeploy(account, target).hash.bytes[0]); }));
+    Deploy deploy = MakeDeploy(account, target);
+    ReportAllocations("deploy serialization",
+                      CountAllocations(1000, [&] { Benchmark::Consume(serializer.ToBytes(deploy).size()); }));
+
+    // per entry of a parsed Map<String, U512>
+    constexpr size_t kBalances = 1000;
+    ByteWriter balances = MakeBalances(kBalances);
+    std::map<CLTypeRVA, CLTypeRVA> balances_type{{CLTypeEnum::String, CLTypeEnum::U512}};
+    CLValueByteSerializer value_serializer;
+    AllocationCount parse_balances = CountAllocations(
+        100,
+        [&]
+        {
+            CLTypeParsedRVA parsed =
+                value_serializer.ParsedFromBytes(std::span(balances.Data(), balances.Size()), balances_type);
+            Benchmark::Consume(parsed.which());
+        });
+    ReportAllocations("Map<String, U512> from bytes, per entry",
+                      {parse_balances.allocations / kBalances, parse_balances.bytes / kBalances});
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+
+#include "ByteSerializers/CLValueByteSerializer.h"
+#include "Types/CLTypeTable.h"
+
+using namespace Casper;
+
+namespace
+{
+/// The type tag encoding as it was done before the CLTypeTable: the inner
+/// types are copied at each level and converted to json for nothing. Works on
+/// the bare CLTypeRVA, building a CLType would intern it, a cost the old code
+/// never paid.
+void LegacyCLTypeToBytes(ByteSink& sb, const CLTypeRVA& innerType)
+{
+    nlohmann::json j;
+    to_json(j, innerType);
+
+    switch (innerType.which())
+    {
+    case 0:
+        sb.WriteByte(static_cast<uint8_t>(boost::get<CLTypeEnum>(innerType)));
+        break;
+    case 2:
+    {
+        std::map<CLTypeRVA, CLTypeRVA> mp = boost::get<std::map<CLTypeRVA, CLTypeRVA>>(innerType);
+        sb.WriteByte(17);
+        LegacyCLTypeToBytes(sb, mp.begin()->first);
+        LegacyCLTypeToBytes(sb, mp.begin()->second);
+        break;
+    }
+    case 3:
+    {
+        auto inner_type_rva = boost::get<std::map<std::string, CLTypeRVA>>(innerType);
+        sb.WriteByte(inner_type_rva.begin()->first == "Option" ? 13 : 14);
+        LegacyCLTypeToBytes(sb, inner_type_rva.begin()->second);
+        break;
+    }
+    default:
+        throw std::runtime_error("LegacyCLTypeToBytes: type not used by this benchmark");
+    }
+}
+
+/// List<Map<String, U512>>
+CLType MakeType()
+{
+    std::map<CLTypeRVA, CLTypeRVA> map_type;
+    map_type[CLTypeEnum::String] = CLTypeEnum::U512;
+    return CLType(CLTypeRVA(map_type), CLTypeEnum::List);
+}
+
+} // namespace
+
+int main()
+{
+    constexpr size_t kIterations = 200000;
+
+    CLValue value(CBytes(64), MakeType());
+    CLValueByteSerializer serializer;
+    ByteWriter writer(256);
+
+    double legacy = Benchmark::Measure(kIterations,
+                                       [&]()
+                                       {
+                                           writer.Clear();
+                                           LegacyCLTypeToBytes(writer, value.GetType().Type());
+                                           Benchmark::Consume(writer.Size());
+                                       });
+
+    double cached = Benchmark::Measure(kIterations,
+                                       [&]()
+                                       {
+                                           writer.Clear();
+                                           serializer.CLTypeToBytes(writer, value.GetType());
+                                           Benchmark::Consume(writer.Size());
+                                       });
+
+    double whole_value = Benchmark::Measure(kIterations,
+                                            [&]()
+                                            {
+                                                writer.Clear();
+                                                serializer.ToBytes(writer, value);
+                                                Benchmark::Consume(writer.Size());
+                                            });
+
+    std::printf("CLType List<Map<String, U512>>, %zu iterations\n", kIterations);
+    Benchmark::Report("type tags, json + copies (before)", legacy);
+    Benchmark::Report("type tags, CLTypeTable (after)", cached);
+    Benchmark::Report("whole CLValue argument (after)", whole_value);
+    return 0;
+}
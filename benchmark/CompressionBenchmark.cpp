@@ -0,0 +1,168 @@
+// Build with -DCASPER_SDK_HTTP_COMPRESSION=ON to compare compressed responses.
+
+#include "Benchmark.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "JsonRpc/Connection/HttpLibConnector.h"
+#include "nlohmann/json.hpp"
+
+using namespace Casper;
+
+namespace
+{
+constexpr size_t kIterations = 20;
+
+const std::string kRequest = R"({"id":1,"jsonrpc":"2.0","method":"state_get_auction_info"})";
+
+/// Stand-in for a state_get_auction_info result: a few MB of bids with hex
+/// keys and decimal amounts.
+std::string AuctionInfoResponse()
+{
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    auto next = [&seed]
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+    auto hex = [&next](size_t length)
+    {
+        std::string out;
+        while (out.size() < length)
+        {
+            out += "0123456789abcdef"[next() % 16];
+        }
+        return out;
+    };
+
+    nlohmann::json bids = nlohmann::json::array();
+    for (int i = 0; i < 4000; i++)
+    {
+        nlohmann::json delegators = nlohmann::json::array();
+        for (int d = 0; d < 3; d++)
+        {
+            delegators.push_back({{"public_key", "01" + hex(64)},
+                                  {"staked_amount", std::to_string(next() % 1000000000000ULL)},
+                                  {"bonding_purse", "uref-" + hex(64) + "-007"},
+                                  {"delegatee", "01" + hex(64)}});
+        }
+        bids.push_back({{"public_key", "01" + hex(64)},
+                        {"bid",
+                         {{"bonding_purse", "uref-" + hex(64) + "-007"},
+                          {"staked_amount", std::to_string(next() % 1000000000000000ULL)},
+                          {"delegation_rate", next() % 100},
+                          {"inactive", false},
+                          {"delegators", delegators}}}});
+    }
+    nlohmann::json auction_state = {{"state_root_hash", hex(64)}, {"block_height", 1800000}, {"bids", bids}};
+    nlohmann::json result = {{"api_version", "1.5.2"}, {"auction_state", auction_state}};
+    return nlohmann::json{{"jsonrpc", "2.0"}, {"id", 1}, {"result", result}}.dump();
+}
+
+/// Response body in one content encoding, compressed once up front as a
+/// proxy caching it would. httplib's own brotli runs at quality 11, far
+/// slower than a node or proxy would compress on the fly.
+struct EncodedBody
+{
+    std::string encoding;
+    std::string body;
+};
+
+std::vector<EncodedBody> EncodeAll(const std::string& body)
+{
+    std::vector<EncodedBody> encoded = {{"identity", body}};
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+    std::string gzip;
+    httplib::detail::gzip_compressor().compress(body.data(), body.size(), true,
+                                                [&](const char* data, size_t n)
+                                                {
+                                                    gzip.append(data, n);
+                                                    return true;
+                                                });
+    encoded.push_back({"gzip", gzip});
+#endif
+#ifdef CPPHTTPLIB_BROTLI_SUPPORT
+    std::string br(BrotliEncoderMaxCompressedSize(body.size()), '\0');
+    size_t br_size = br.size();
+    BrotliEncoderCompress(5, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_TEXT, body.size(),
+                          reinterpret_cast<const uint8_t*>(body.data()), &br_size,
+                          reinterpret_cast<uint8_t*>(br.data()));
+    br.resize(br_size);
+    encoded.push_back({"br", br});
+#endif
+    return encoded;
+}
+
+/// Mean time of one request, from sending it to having the parsed result.
+double MeasureRoundTrip(HttpLibConnector& connector)
+{
+    return Benchmark::Measure(kIterations,
+                              [&]
+                              {
+                                  auto response = nlohmann::json::parse(connector.Send(kRequest));
+                                  Benchmark::Consume(response.at("result").size());
+                              });
+}
+
+} // namespace
+
+int main()
+{
+    const std::string response = AuctionInfoResponse();
+    const std::vector<EncodedBody> encoded = EncodeAll(response);
+    std::atomic<size_t> serving{0};
+
+    // stand-in for a node behind a compressing proxy, serves the selected
+    // encoding; the content type keeps httplib from compressing it again
+    httplib::Server server;
+    server.Post("/rpc",
+                [&](const httplib::Request& req, httplib::Response& res)
+                {
+                    const EncodedBody& body = encoded[serving];
+                    bool accepted = req.get_header_value("Accept-Encoding").find(body.encoding) != std::string::npos;
+                    const EncodedBody& sent = accepted ? body : encoded[0];
+                    if (&sent != &encoded[0])
+                    {
+                        res.set_header("Content-Encoding", sent.encoding);
+                    }
+                    res.set_content(sent.body, "application/json; charset=utf-8");
+                });
+    server.set_tcp_nodelay(true);
+    int port = server.bind_to_any_port("127.0.0.1");
+    std::thread listener([&] { server.listen_after_bind(); });
+    while (!server.is_running())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::string host = "http://127.0.0.1:" + std::to_string(port);
+
+    std::printf("auction info response: %zu bytes of JSON, Accept-Encoding: \"%s\"\n", response.size(),
+                HttpLibConnector::AcceptEncoding().c_str());
+    if (encoded.size() == 1)
+    {
+        std::printf("built without CPPHTTPLIB_ZLIB_SUPPORT, only the identity encoding is measured\n");
+    }
+
+    for (size_t i = 0; i < encoded.size(); i++)
+    {
+        serving = i;
+        ConnectionPoolConfig config;
+        config.compression = i != 0;
+        HttpLibConnector connector(host, config);
+
+        // the estimate adds the transfer time of the body on a 100 Mbit/s link
+        double loopback = MeasureRoundTrip(connector);
+        double link = static_cast<double>(encoded[i].body.size()) * 8 / 1e8 * 1e9;
+        Benchmark::Report(encoded[i].encoding + ", loopback round trip", loopback);
+        Benchmark::Report(encoded[i].encoding + ", estimated at 100 Mbit/s", loopback + link);
+        std::printf("  %zu bytes on the wire\n", encoded[i].body.size());
+    }
+
+    server.stop();
+    listener.join();
+    return 0;
+}
@@ -0,0 +1,108 @@
+// the stand-in server accepts all pooled connections at once
+#define CPPHTTPLIB_LISTEN_BACKLOG 128
+
+#include "Benchmark.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "JsonRpc/Connection/HttpLibConnector.h"
+
+using namespace Casper;
+
+namespace
+{
+constexpr size_t kRequestsPerCaller = 200;
+
+const std::string kRequest = R"({"jsonrpc":"2.0","id":1,"method":"info_get_status","params":{}})";
+
+/// What HttpLibConnector did before the pool: one httplib::Client without
+/// keep-alive, shared by all callers behind a lock.
+class SingleConnection
+{
+public:
+    explicit SingleConnection(const std::string& host)
+        : _client(host)
+    {
+    }
+
+    std::string Send(const std::string& request)
+    {
+        std::lock_guard lock(_mutex);
+        auto res = _client.Post("/rpc", request, "application/json");
+        return res ? res->body : std::string();
+    }
+
+private:
+    std::mutex _mutex;
+    httplib::Client _client;
+};
+
+/// Mean wall time of one request with `callers` threads each sending
+/// kRequestsPerCaller requests.
+template <typename Connector>
+double MeasureConcurrent(Connector& connector, size_t callers)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < callers; t++)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                for (size_t i = 0; i < kRequestsPerCaller; i++)
+                {
+                    Benchmark::Consume(connector.Send(kRequest).size());
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / static_cast<double>(callers * kRequestsPerCaller);
+}
+
+} // namespace
+
+int main()
+{
+    // stand-in for a node: a fixed status-sized reply, one worker per caller
+    httplib::Server server;
+    std::string reply = R"({"jsonrpc":"2.0","id":1,"result":{"api_version":"1.4.5","peers":[]}})";
+    server.Post("/rpc", [&](const httplib::Request&, httplib::Response& res)
+                { res.set_content(reply, "application/json"); });
+    server.new_task_queue = [] { return new httplib::ThreadPool(64); };
+    server.set_keep_alive_max_count(1000000);
+    server.set_tcp_nodelay(true);
+    int port = server.bind_to_any_port("127.0.0.1");
+    std::thread listener([&] { server.listen_after_bind(); });
+    while (!server.is_running())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::string host = "http://127.0.0.1:" + std::to_string(port);
+
+    for (size_t callers : {1, 8, 64})
+    {
+        std::string suffix = ", " + std::to_string(callers) + " callers";
+
+        SingleConnection single(host);
+        Benchmark::Report("single connection" + suffix, MeasureConcurrent(single, callers));
+
+        ConnectionPoolConfig config;
+        config.max_connections = callers;
+        HttpLibConnector pooled(host, config);
+        Benchmark::Report("keep-alive pool" + suffix, MeasureConcurrent(pooled, callers));
+
+        ConnectionPoolStats stats = pooled.Stats();
+        std::printf("  pool: %zu connections, %llu reused, %llu waits\n", stats.open,
+                    static_cast<unsigned long long>(stats.reused), static_cast<unsigned long long>(stats.waits));
+    }
+
+    server.stop();
+    listener.join();
+    return 0;
+}
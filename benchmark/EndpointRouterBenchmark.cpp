@@ -0,0 +1,127 @@
+// the stand-in servers accept all pooled connections at once
+#define CPPHTTPLIB_LISTEN_BACKLOG 128
+
+#include "Benchmark.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "JsonRpc/Connection/EndpointRouter.h"
+
+using namespace Casper;
+
+namespace
+{
+constexpr size_t kCallers = 8;
+constexpr size_t kRequestsPerCaller = 100;
+
+const std::string kRequest = R"({"id":1,"jsonrpc":"2.0","method":"info_get_peers"})";
+
+/// Stand-in node answering after a fixed delay.
+class StandInNode
+{
+public:
+    explicit StandInNode(int latency_ms)
+    {
+        _server.Post("/rpc",
+                     [latency_ms](const httplib::Request&, httplib::Response& res)
+                     {
+                         std::this_thread::sleep_for(std::chrono::milliseconds(latency_ms));
+                         res.set_content(R"({"jsonrpc":"2.0","id":1,"result":{"peers":[]}})", "application/json");
+                     });
+        // a kept-alive connection holds a server thread until it is closed
+        _server.new_task_queue = [] { return new httplib::ThreadPool(64); };
+        _server.set_tcp_nodelay(true);
+        _port = _server.bind_to_any_port("127.0.0.1");
+        _listener = std::thread([this] { _server.listen_after_bind(); });
+        while (!_server.is_running())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    ~StandInNode()
+    {
+        _server.stop();
+        _listener.join();
+    }
+
+    std::string Host() const { return "http://127.0.0.1:" + std::to_string(_port); }
+
+private:
+    httplib::Server _server;
+    int _port = 0;
+    std::thread _listener;
+};
+
+/// Sends every request to the next node in turn, whatever its latency.
+class RoundRobin
+{
+public:
+    explicit RoundRobin(const std::vector<std::string>& hosts)
+    {
+        for (const auto& host : hosts)
+        {
+            _nodes.push_back(std::make_unique<HttpLibConnector>(host));
+        }
+    }
+
+    std::string Send(const std::string& request) { return _nodes[_next++ % _nodes.size()]->Send(request); }
+
+private:
+    std::vector<std::unique_ptr<HttpLibConnector>> _nodes;
+    std::atomic<size_t> _next{0};
+};
+
+/// Mean wall time of one request with kCallers threads sending at once.
+template <typename Connector>
+double MeasureConcurrent(Connector& connector)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kCallers; t++)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                for (size_t i = 0; i < kRequestsPerCaller; i++)
+                {
+                    Benchmark::Consume(connector.Send(kRequest).size());
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return elapsed.count() / static_cast<double>(kCallers * kRequestsPerCaller);
+}
+
+} // namespace
+
+int main()
+{
+    // two healthy nodes and one answering 20 ms late
+    StandInNode first(1);
+    StandInNode second(1);
+    StandInNode lagging(20);
+    std::vector<std::string> hosts = {first.Host(), second.Host(), lagging.Host()};
+
+    {
+        RoundRobin round_robin(hosts);
+        Benchmark::Report("round robin over 3 nodes, 1 slow", MeasureConcurrent(round_robin));
+    }
+
+    EndpointRouter router(hosts);
+    Benchmark::Report("EWMA routing over 3 nodes, 1 slow", MeasureConcurrent(router));
+
+    for (const auto& endpoint : router.Endpoints())
+    {
+        std::printf("  %s: %llu requests, %.2f ms average\n", endpoint.address.c_str(),
+                    static_cast<unsigned long long>(endpoint.requests), endpoint.latency_ms);
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "Benchmark.h"
+
+#include "Base.h"
+#include "Utils/HexCodec.h"
+
+#include <vector>
+
+using namespace Casper;
+
+namespace
+{
+/// The CryptoPP pipeline hexEncode and hexDecode used before HexCodec.
+std::string LegacyEncode(const CBytes& decoded)
+{
+    std::string encoded;
+    CryptoPP::StringSource ss(decoded.data(), decoded.size(), true,
+                              new CryptoPP::HexEncoder(new CryptoPP::StringSink(encoded), false));
+    return encoded;
+}
+
+CBytes LegacyDecode(const std::string& hex)
+{
+    CryptoPP::StringSource ss(hex, true, new CryptoPP::HexDecoder);
+    CBytes decoded((size_t)ss.MaxRetrievable());
+    ss.Get(decoded.data(), decoded.size());
+    return decoded;
+}
+
+const char* KernelName(HexKernel kernel)
+{
+    switch (kernel)
+    {
+    case HexKernel::SSE2:
+        return "sse2";
+    case HexKernel::AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+void Run(const std::string& label, size_t size, size_t iterations)
+{
+    CBytes data(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    std::string hex = hexEncode(data);
+    std::string text(2 * size, '\0');
+    std::vector<uint8_t> bytes(size);
+
+    auto report = [&](const std::string& name, double ns)
+    {
+        // bytes of binary data per nanosecond is GB/s
+        Benchmark::Report(label + " " + name, ns);
+        std::printf("%-48s %12.2f GB/s\n", "", static_cast<double>(size) / ns);
+    };
+
+    report("encode cryptopp", Benchmark::Measure(iterations, [&]() { Benchmark::Consume(LegacyEncode(data).size()); }));
+    report("decode cryptopp", Benchmark::Measure(iterations, [&]() { Benchmark::Consume(LegacyDecode(hex).size()); }));
+
+    for (auto kernel : {HexKernel::Scalar, HexKernel::SSE2, HexKernel::AVX2})
+    {
+        if (!HexCodec::IsSupported(kernel))
+        {
+            continue;
+        }
+        std::string name = KernelName(kernel);
+        report("encode " + name, Benchmark::Measure(iterations,
+                                                    [&]()
+                                                    {
+                                                        HexCodec::Encode(kernel, data.data(), size, text.data());
+                                                        Benchmark::Consume(text[0]);
+                                                    }));
+        report("decode " + name, Benchmark::Measure(iterations,
+                                                    [&]()
+                                                    {
+                                                        Benchmark::Consume(
+                                                            HexCodec::Decode(kernel, hex, bytes.data()));
+                                                    }));
+    }
+}
+
+} // namespace
+
+int main()
+{
+    Run("32 byte hash", 32, 1000000);
+    Run("1 MB wasm", 1 << 20, 50);
+    return 0;
+}
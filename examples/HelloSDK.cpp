@@ -194,8 +194,8 @@ void accountPutDeploy()
     Casper::Deploy t2(dp.header, dp.payment, dp.session);
     t2.AddApproval(approval);
 
-    t2.header.body_hash = Casper::CEP57Checksum::Encode(t2.ComputeBodyHash(t2.payment, t2.session));
-    t2.hash = Casper::CEP57Checksum::Encode(t2.ComputeHeaderHash(t2.header));
+    t2.header.body_hash = Casper::Hash32::FromBytes(t2.ComputeBodyHash(t2.payment, t2.session));
+    t2.hash = Casper::Hash32::FromBytes(t2.ComputeHeaderHash(t2.header));
     Casper::DeployByteSerializer sery;
     std::string deploy_bytes = Casper::hexEncode(sery.ToBytes(t2));
     std::reverse(deploy_bytes.begin(), deploy_bytes.end());
@@ -1,15 +1,97 @@
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <utility>
 #include "CasperClient.h"
 namespace Casper
 {
+namespace
+{
+/// Params of the calls that take a block hash, none for the latest block.
+nlohmann::json blockHashParams(const std::string& block_hash)
+{
+    if (block_hash.empty())
+    {
+        return nlohmann::json({});
+    }
+    return {{"block_identifier", {{"Hash", block_hash}}}};
+}
+
+nlohmann::json blockHeightParams(uint64_t block_height)
+{
+    return {{"block_identifier", {{"Height", block_height}}}};
+}
+
+nlohmann::json balanceParams(const std::string& purseURef, const std::string& stateRootHash)
+{
+    return {{"state_root_hash", stateRootHash}, {"purse_uref", purseURef}};
+}
+
+/// Error of a response to a whole batch that is not an array of responses.
+jsonrpccxx::JsonRpcException batchError(const nlohmann::json& response)
+{
+    if (jsonrpccxx::has_key_type(response, "error", nlohmann::json::value_t::object))
+    {
+        return jsonrpccxx::JsonRpcException::fromJson(response["error"]);
+    }
+    return jsonrpccxx::JsonRpcException(jsonrpccxx::parse_error, "invalid JSON response from server: expected array");
+}
+
+/// Routing of a client bound to one node.
+EndpointRouterConfig singleNode(const ConnectionPoolConfig& pool_config)
+{
+    EndpointRouterConfig config;
+    config.pool = pool_config;
+    return config;
+}
+
+/// Asynchronous call settings with the default thread count replaced by one
+/// thread per connection of the pools of all nodes.
+AsyncConfig asyncConfigFor(AsyncConfig async_config, const EndpointRouterConfig& router_config, size_t nodes)
+{
+    if (async_config.threads == 0)
+    {
+        async_config.threads = std::max<size_t>(1, router_config.pool.max_connections * nodes);
+    }
+    return async_config;
+}
+
+nlohmann::json queryGlobalStateParams(const std::string& key, const std::string& state_root_hash,
+                                      const std::string& path)
+{
+    return {{"state_identifier", {{"StateRootHash", state_root_hash}}},
+            {"key", key},
+            {"path", Client::splitPath(path)}};
+}
+
+} // namespace
 
 /// Construct a new Casper Client object
 Client::Client(std::string address, const LogConfig* const log_config)
-    : mAddress{std::move(address)}
-    , mHttpConnector{mAddress}
-    , mRpcClient{mHttpConnector, jsonrpccxx::version::v2}
+    : Client(std::move(address), ConnectionPoolConfig{}, log_config)
+{
+}
+
+/// Construct a new Casper Client object with the given connection pool settings
+Client::Client(std::string address, const ConnectionPoolConfig& pool_config, const LogConfig* const log_config)
+    : Client(std::move(address), pool_config, AsyncConfig{}, log_config)
+{
+}
+
+/// Construct a new Casper Client object with the given connection pool and asynchronous call settings
+Client::Client(std::string address, const ConnectionPoolConfig& pool_config, const AsyncConfig& async_config,
+               const LogConfig* const log_config)
+    : Client(std::vector<std::string>{std::move(address)}, singleNode(pool_config), async_config, log_config)
+{
+}
+
+/// Construct a new Casper Client object that spreads its calls over several nodes
+Client::Client(const std::vector<std::string>& addresses, const EndpointRouterConfig& router_config,
+               const AsyncConfig& async_config, const LogConfig* const log_config)
+    : mRouter{addresses, router_config}
+    , mRpcClient{mRouter}
+    , mExecutor{
+          std::make_unique<RpcExecutor>(mRouter, asyncConfigFor(async_config, router_config, addresses.size()))}
 {
     if (log_config)
     {
@@ -19,6 +101,30 @@ Client::Client(std::string address, const LogConfig* const log_config)
     }
 }
 
+/// Returns the counters of the connection pool.
+ConnectionPoolStats Client::GetConnectionStats() const
+{
+    return mRouter.PoolStats();
+}
+
+/// Returns the latency, error rate and health of each node.
+std::vector<EndpointStats> Client::GetEndpointStats() const
+{
+    return mRouter.Endpoints();
+}
+
+/// Cancels an asynchronous call.
+bool Client::CancelAsync(uint64_t id)
+{
+    return mExecutor->Cancel(id);
+}
+
+/// Asynchronous calls queued or in flight.
+size_t Client::GetPendingAsyncCalls() const
+{
+    return mExecutor->Pending();
+}
+
 /// Get a list of the nodes.
 InfoGetPeersResult Client::GetNodePeers()
 {
@@ -28,22 +134,27 @@ InfoGetPeersResult Client::GetNodePeers()
 /// Returns the state root hash at a given block
 GetStateRootHashResult Client::GetStateRootHash(const std::string& block_hash)
 {
-    nlohmann::json hashJSON{{"Hash", block_hash}};
-    nlohmann::json block_identifier{{"block_identifier", hashJSON}};
-
-    if (block_hash.empty())
-        block_identifier = nlohmann::json({});
-
-    return mRpcClient.CallMethodNamed<GetStateRootHashResult>(1, "chain_get_state_root_hash", block_identifier);
+    return mRpcClient.CallMethodNamed<GetStateRootHashResult>(1, "chain_get_state_root_hash",
+                                                              blockHashParams(block_hash));
 }
 
 /// Returns the state root hash at a given height
 GetStateRootHashResult Client::GetStateRootHash(uint64_t block_height)
 {
-    nlohmann::json heightJSON{{"Height", block_height}};
-    nlohmann::json block_identifier{{"block_identifier", heightJSON}};
+    return mRpcClient.CallMethodNamed<GetStateRootHashResult>(1, "chain_get_state_root_hash",
+                                                              blockHeightParams(block_height));
+}
 
-    return mRpcClient.CallMethodNamed<GetStateRootHashResult>(1, "chain_get_state_root_hash", block_identifier);
+/// Queues a state root hash call for the given block
+AsyncCall<GetStateRootHashResult> Client::GetStateRootHashAsync(const std::string& block_hash)
+{
+    return CallAsync<GetStateRootHashResult>("chain_get_state_root_hash", blockHashParams(block_hash));
+}
+
+uint64_t Client::GetStateRootHashAsync(const std::string& block_hash, AsyncCallback<GetStateRootHashResult> callback)
+{
+    return CallAsync<GetStateRootHashResult>("chain_get_state_root_hash", blockHashParams(block_hash),
+                                             std::move(callback));
 }
 
 /// Returns the deploy info.
@@ -73,6 +184,30 @@ GetDeployInfoResult Client::GetDeployInfo(const std::string& deploy_hash, int co
     // }
 }
 
+/// Queues a deploy info call.
+AsyncCall<GetDeployInfoResult> Client::GetDeployInfoAsync(const std::string& deploy_hash)
+{
+    return CallAsync<GetDeployInfoResult>("info_get_deploy", {{"deploy_hash", deploy_hash}});
+}
+
+uint64_t Client::GetDeployInfoAsync(const std::string& deploy_hash, AsyncCallback<GetDeployInfoResult> callback)
+{
+    return CallAsync<GetDeployInfoResult>("info_get_deploy", {{"deploy_hash", deploy_hash}}, std::move(callback));
+}
+
+/// Returns the info of the given deploys, sent as JSON-RPC batches.
+std::vector<BatchResult<GetDeployInfoResult>> Client::GetDeployInfos(const std::vector<std::string>& deploy_hashes,
+                                                                     size_t max_batch_size)
+{
+    RpcBatch batch;
+    for (const auto& deploy_hash : deploy_hashes)
+    {
+        batch.Add("info_get_deploy", {{"deploy_hash", deploy_hash}});
+    }
+    ExecuteBatch(batch, max_batch_size);
+    return batch.GetAll<GetDeployInfoResult>();
+}
+
 /// Returns the status info.
 GetStatusResult Client::GetStatusInfo()
 {
@@ -109,10 +244,40 @@ GetBlockResult Client::GetBlock(const std::string& block_hash)
 /// Returns the block at the block given by the block height.
 GetBlockResult Client::GetBlock(uint64_t block_height)
 {
-    nlohmann::json heightJSON{{"Height", block_height}};
-    nlohmann::json block_identifier{{"block_identifier", heightJSON}};
+    return mRpcClient.CallMethodNamed<GetBlockResult>(1, "chain_get_block", blockHeightParams(block_height));
+}
 
-    return mRpcClient.CallMethodNamed<GetBlockResult>(1, "chain_get_block", block_identifier);
+/// Queues a block call for the given block height.
+AsyncCall<GetBlockResult> Client::GetBlockAsync(uint64_t block_height)
+{
+    return CallAsync<GetBlockResult>("chain_get_block", blockHeightParams(block_height));
+}
+
+uint64_t Client::GetBlockAsync(uint64_t block_height, AsyncCallback<GetBlockResult> callback)
+{
+    return CallAsync<GetBlockResult>("chain_get_block", blockHeightParams(block_height), std::move(callback));
+}
+
+/// Returns the blocks of a height range, sent as JSON-RPC batches.
+std::vector<BatchResult<GetBlockResult>> Client::GetBlocks(uint64_t first_height, uint64_t last_height,
+                                                           size_t max_batch_size)
+{
+    if (first_height > last_height)
+    {
+        throw std::invalid_argument("GetBlocks: first_height is above last_height");
+    }
+
+    RpcBatch batch;
+    for (uint64_t height = first_height;; height++)
+    {
+        batch.Add("chain_get_block", blockHeightParams(height));
+        if (height == last_height)
+        {
+            break;
+        }
+    }
+    ExecuteBatch(batch, max_batch_size);
+    return batch.GetAll<GetBlockResult>();
 }
 
 /// Returns the era information at the block given by the block hash.
@@ -206,9 +371,142 @@ GetDictionaryItemResult Client::GetDictionaryItemByURef(const std::string& state
 /// Returns the balance of the given account.
 GetBalanceResult Client::GetAccountBalance(const std::string& purseURef, const std::string& stateRootHash)
 {
-    nlohmann::json paramsJSON{{"state_root_hash", stateRootHash}, {"purse_uref", purseURef}};
+    return mRpcClient.CallMethodNamed<GetBalanceResult>(1, "state_get_balance",
+                                                        balanceParams(purseURef, stateRootHash));
+}
+
+/// Queues a balance call for the given purse.
+AsyncCall<GetBalanceResult> Client::GetAccountBalanceAsync(const std::string& purseURef,
+                                                           const std::string& stateRootHash)
+{
+    return CallAsync<GetBalanceResult>("state_get_balance", balanceParams(purseURef, stateRootHash));
+}
 
-    return mRpcClient.CallMethodNamed<GetBalanceResult>(1, "state_get_balance", paramsJSON);
+uint64_t Client::GetAccountBalanceAsync(const std::string& purseURef, const std::string& stateRootHash,
+                                        AsyncCallback<GetBalanceResult> callback)
+{
+    return CallAsync<GetBalanceResult>("state_get_balance", balanceParams(purseURef, stateRootHash),
+                                       std::move(callback));
+}
+
+/// Returns the balances of the given purses, sent as JSON-RPC batches.
+std::vector<BatchResult<GetBalanceResult>> Client::GetAccountBalances(const std::vector<std::string>& purseURefs,
+                                                                      const std::string& stateRootHash,
+                                                                      size_t max_batch_size)
+{
+    RpcBatch batch;
+    for (const auto& purseURef : purseURefs)
+    {
+        batch.Add("state_get_balance", balanceParams(purseURef, stateRootHash));
+    }
+    ExecuteBatch(batch, max_batch_size);
+    return batch.GetAll<GetBalanceResult>();
+}
+
+/// Sends the queued calls as JSON-RPC batch requests and stores their results.
+void Client::ExecuteBatch(RpcBatch& batch, size_t max_batch_size)
+{
+    if (max_batch_size == 0)
+    {
+        throw std::invalid_argument("ExecuteBatch: max_batch_size must be at least 1");
+    }
+
+    // results of an earlier run must not outlive a failure of this one
+    auto& calls = batch._calls;
+    for (auto& call : calls)
+    {
+        call.result = nullptr;
+        call.error.reset();
+        call.done = false;
+    }
+
+    for (size_t begin = 0; begin < calls.size(); begin += max_batch_size)
+    {
+        size_t end = std::min(calls.size(), begin + max_batch_size);
+        // the index in the batch is the id, unique across all its requests
+        jsonrpccxx::BatchRequest request;
+        for (size_t i = begin; i < end; i++)
+        {
+            request.AddNamedMethodCall(static_cast<int>(i), calls[i].method, calls[i].params);
+        }
+
+        // a failure of the request as a whole fails each of its calls
+        auto failAll = [&](const jsonrpccxx::JsonRpcException& error)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                calls[i].error = error;
+                calls[i].done = true;
+            }
+        };
+
+        try
+        {
+            // the router skips the nodes that refused batches before, and
+            // there is none left for the calls to go one by one
+            std::optional<std::string> body = mRouter.SendBatch(request.Build().dump());
+            if (!body)
+            {
+                ExecuteOneByOne(batch, begin, end);
+                continue;
+            }
+
+            nlohmann::json response = nlohmann::json::parse(*body);
+            if (!response.is_array())
+            {
+                // a single error for the batch as a whole, e.g. a request
+                // too large, fails this batch only
+                failAll(batchError(response));
+                continue;
+            }
+
+            jsonrpccxx::BatchResponse batch_response(std::move(response));
+            for (size_t i = begin; i < end; i++)
+            {
+                try
+                {
+                    calls[i].result = batch_response.Get<nlohmann::json>(static_cast<int>(i));
+                }
+                catch (const jsonrpccxx::JsonRpcException& e)
+                {
+                    calls[i].error = e;
+                }
+                calls[i].done = true;
+            }
+        }
+        catch (const jsonrpccxx::JsonRpcException& e)
+        {
+            failAll(e);
+        }
+        catch (const nlohmann::json::exception& e)
+        {
+            failAll(jsonrpccxx::JsonRpcException(jsonrpccxx::parse_error,
+                                                 std::string("invalid JSON response from server: ") + e.what()));
+        }
+    }
+}
+
+/// Sends calls of a batch one request per call and stores their results.
+void Client::ExecuteOneByOne(RpcBatch& batch, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        auto& call = batch._calls[i];
+        try
+        {
+            call.result = mRpcClient.CallMethodNamed_JsonRepr(static_cast<int>(i), call.method, call.params);
+        }
+        catch (const jsonrpccxx::JsonRpcException& e)
+        {
+            call.error = e;
+        }
+        catch (const nlohmann::json::exception& e)
+        {
+            call.error = jsonrpccxx::JsonRpcException(jsonrpccxx::parse_error,
+                                                      std::string("invalid JSON response from server: ") + e.what());
+        }
+        call.done = true;
+    }
 }
 
 /// Returns the auction information for the given block hash.
@@ -253,12 +551,8 @@ std::vector<std::string> Client::splitPath(const std::string& path)
 QueryGlobalStateResult Client::QueryGlobalState(const std::string& key, const std::string& state_root_hash,
                                                 const std::string& path)
 {
-    std::vector<std::string> path_vec = splitPath(path);
-    nlohmann::json hashJSON{{"StateRootHash", state_root_hash}};
-
-    nlohmann::json paramsJSON{{"state_identifier", hashJSON}, {"key", key}, {"path", path_vec}};
-
-    return mRpcClient.CallMethodNamed<QueryGlobalStateResult>(1, "query_global_state", paramsJSON);
+    return mRpcClient.CallMethodNamed<QueryGlobalStateResult>(1, "query_global_state",
+                                                              queryGlobalStateParams(key, state_root_hash, path));
 }
 
 QueryGlobalStateResult Client::QueryGlobalState(GlobalStateKey key, const std::string& state_root_hash,
@@ -267,6 +561,20 @@ QueryGlobalStateResult Client::QueryGlobalState(GlobalStateKey key, const std::s
     return QueryGlobalState(key.ToString(), state_root_hash, path);
 }
 
+AsyncCall<QueryGlobalStateResult> Client::QueryGlobalStateAsync(const std::string& key,
+                                                                const std::string& state_root_hash,
+                                                                const std::string& path)
+{
+    return CallAsync<QueryGlobalStateResult>("query_global_state", queryGlobalStateParams(key, state_root_hash, path));
+}
+
+uint64_t Client::QueryGlobalStateAsync(const std::string& key, const std::string& state_root_hash,
+                                       const std::string& path, AsyncCallback<QueryGlobalStateResult> callback)
+{
+    return CallAsync<QueryGlobalStateResult>("query_global_state", queryGlobalStateParams(key, state_root_hash, path),
+                                             std::move(callback));
+}
+
 QueryGlobalStateResult Client::QueryGlobalStateWithBlockHash(const std::string& key, const std::string& block_hash,
                                                              const std::string& path)
 {
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <charconv>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <iostream>
 #include <sstream>
@@ -11,6 +13,8 @@
 #include <cryptopp/filters.h> // CryptoPP::StringSink
 #include <cryptopp/hex.h>     // CryptoPP::HexEncoder
 #include "nlohmann/json.hpp"
+#include "Utils/Bytes.h"
+#include "Utils/HexCodec.h"
 
 using uint512_t = math::wide_integer::uint512_t;
 using uint256_t = math::wide_integer::uint256_t;
@@ -23,31 +27,38 @@ inline bool iequals(const std::string& a, const std::string& b)
 
 namespace Casper
 {
-using CBytes = CryptoPP::SecByteBlock;
+/// <summary>
+/// Non-secret bytes. Private keys use CryptoPP::SecByteBlock instead.
+/// </summary>
+using CBytes = Bytes;
 using CHexEncoder = CryptoPP::HexEncoder;
 using CHexDecoder = CryptoPP::HexDecoder;
 using CStringSink = CryptoPP::StringSink;
 using CStringSource = CryptoPP::StringSource;
 
-inline CBytes hexDecode(const std::string& hex)
+inline CBytes hexDecode(std::string_view hex)
 {
-    CryptoPP::StringSource ss(hex, true, new CryptoPP::HexDecoder);
-    CBytes decoded((size_t)ss.MaxRetrievable());
-    ss.Get(decoded, decoded.size());
+    CBytes decoded(hex.size() / 2);
+    size_t size = HexCodec::Decode(hex, decoded.data(), HexMode::Lenient);
+    if (size != decoded.size())
+    {
+        decoded.resize(size);
+    }
     return decoded;
 }
 
-inline std::string hexEncode(CBytes decoded)
+inline std::string hexEncode(const uint8_t* data, size_t size)
 {
-    std::string encoded;
-
-    CryptoPP::StringSource ss(decoded, decoded.size(), true,
-                              new CryptoPP::HexEncoder(new CryptoPP::StringSink(encoded),
-                                                       false) // HexEncoder
-    );
+    std::string encoded(2 * size, '\0');
+    HexCodec::Encode(data, size, encoded.data());
     return encoded;
 }
 
+inline std::string hexEncode(const CBytes& decoded)
+{
+    return hexEncode(decoded.data(), decoded.size());
+}
+
 /*
 Numeric values consisting of 64 bits or less serialize in the two's complement
 representation with little-endian byte order, and the appropriate number of
@@ -81,211 +92,375 @@ inline void reverseHex(std::string& hex_input)
     std::reverse(hex_input.begin(), hex_input.end());
 }
 
-inline uint128_t u128FromHex(const std::string& hex_str)
+/*
+U128, U256 and U512 serialize as one length byte followed by the value in
+little-endian order, without its most significant zero bytes. The bytes are
+taken from and put into the limbs of the wide integer directly.
+*/
+template <typename T>
+constexpr size_t bigUnsignedMaxBytes = 1 + T::my_width2 / 8;
+
+/// <summary>
+/// Writes the bytesrepr form of `value` to `out`, which must have room for
+/// bigUnsignedMaxBytes<T> bytes. Returns the number of bytes written.
+/// </summary>
+template <typename T>
+inline size_t bigUnsignedToBytes(const T& value, uint8_t* out)
 {
-    auto len = hexToInteger<uint32_t>(hex_str.substr(0, 2));
+    using limb_type = typename T::limb_type;
 
-    if (len < 1)
+    size_t size = 0;
+    for (const limb_type limb : value.crepresentation())
     {
-        return 0;
+        for (size_t shift = 0; shift < sizeof(limb_type) * 8; shift += 8)
+        {
+            out[1 + size++] = static_cast<uint8_t>(limb >> shift);
+        }
     }
-
-    auto subHexStr = hex_str.substr(2, len * 2);
-    reverseHex(subHexStr);
-    subHexStr = "0x" + subHexStr;
-
-    return {subHexStr.c_str()};
+    while (size > 0 && out[size] == 0)
+    {
+        size--;
+    }
+    out[0] = static_cast<uint8_t>(size);
+    return 1 + size;
 }
 
-inline std::string u128ToHex(uint128_t value)
+/// <summary>
+/// Builds a value from `size` little-endian bytes, the length byte excluded.
+/// </summary>
+template <typename T>
+inline T bigUnsignedFromBytes(const uint8_t* data, size_t size)
 {
-    if (value == 0)
+    using limb_type = typename T::limb_type;
+
+    if (size > T::my_width2 / 8)
     {
-        // std::cout << "u128ToHex: value is 0" << std::endl;
-        return "00";
+        throw std::invalid_argument(std::to_string(size) + " bytes do not fit in a " + std::to_string(T::my_width2) +
+                                    " bit integer");
     }
 
-    std::stringstream ss;
-    ss << std::hex << value;
-    std::string u128_str;
-    u128_str = ss.str();
-
-    if (u128_str.length() % 2 != 0)
+    T value = 0;
+    auto& limbs = value.representation();
+    for (size_t i = 0; i < size; i++)
     {
-        u128_str = "0" + u128_str;
+        limbs[i / sizeof(limb_type)] |= static_cast<limb_type>(static_cast<limb_type>(data[i])
+                                                                << (8 * (i % sizeof(limb_type))));
     }
-
-    //
-    uint8_t bytes_length = u128_str.length() / 2;
-    std::string bytes_length_str = integerToHex<uint8_t>(bytes_length);
-
-    reverseHex(u128_str);
-    // std::cout << "u128_str: " << u128_str << std::endl;
-
-    // this string includes the length of the string and its hex representation
-    std::string encoded_u128_str = bytes_length_str + u128_str;
-
-    return encoded_u128_str;
+    return value;
 }
 
-inline std::string u128ToDec(uint128_t value)
+template <typename T>
+inline CBytes bigUnsignedToCBytes(const T& value)
 {
-    std::stringstream ss;
-    ss << value;
-    std::string u128_str;
-    u128_str = ss.str();
-
-    return u128_str;
+    uint8_t bytes[bigUnsignedMaxBytes<T>];
+    return CBytes(bytes, bigUnsignedToBytes(value, bytes));
 }
 
-inline uint128_t u128FromDec(std::string dec_str)
+template <typename T>
+inline std::string bigUnsignedToHex(const T& value)
 {
-    return uint128_t(dec_str.c_str());
+    return hexEncode(bigUnsignedToCBytes(value));
 }
 
-inline void to_json(nlohmann::json& j, const uint128_t& p)
+/// <summary>
+/// Parses a length prefixed hex string, anything after the value is ignored.
+/// </summary>
+template <typename T>
+inline T bigUnsignedFromHex(const std::string& hex_str)
 {
-    j = u128ToDec(p);
+    CBytes bytes = hexDecode(hex_str);
+    if (bytes.empty())
+    {
+        return 0;
+    }
+    if (bytes.size() < 1u + bytes[0])
+    {
+        throw std::invalid_argument("big integer hex string is shorter than its length byte");
+    }
+    return bigUnsignedFromBytes<T>(bytes.data() + 1, bytes[0]);
 }
 
-inline void from_json(const nlohmann::json& j, uint128_t& p)
-{
-    p = u128FromDec(j.get<std::string>());
-}
+/*
+Decimal conversion of U128, U256 and U512 works on the 32-bit limbs nine
+digits at a time, values that fit in 64 bits go through std::to_chars and
+std::from_chars directly. Where the compiler has a native 128-bit integer,
+values that fit in 128 bits are split into 19 digit chunks with it instead
+of going through the limbs; MSVC has none and takes the limb path.
+*/
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 NativeUInt128;
+#endif
 
-inline uint256_t u256FromHex(std::string hex_str)
+template <typename T>
+inline std::string bigUnsignedToDec(const T& value)
 {
-    uint32_t len = hexToInteger<uint32_t>(hex_str.substr(0, 2));
+    static_assert(std::is_same_v<typename T::limb_type, uint32_t>, "32-bit limbs expected");
+    constexpr uint32_t kChunk = 1000000000u;
+    constexpr int kChunkDigits = 9;
 
-    if (len < 1)
+    const auto& limbs = value.crepresentation();
+    size_t used = T::number_of_limbs;
+    while (used > 0 && limbs[used - 1] == 0)
     {
-        return uint256_t(0);
+        used--;
     }
 
-    hex_str = hex_str.substr(2, len * 2);
-    reverseHex(hex_str);
-    hex_str = "0x" + hex_str;
+#ifdef __SIZEOF_INT128__
+    if (used > 2 && used <= 4)
+    {
+        constexpr uint64_t kWideChunk = 10000000000000000000ull;
+        constexpr int kWideChunkDigits = 19;
+
+        NativeUInt128 rest = 0;
+        for (size_t i = used; i-- > 0;)
+        {
+            rest = (rest << 32) | limbs[i];
+        }
+
+        // above 64 bits, so at least one chunk and a non zero head
+        char chunks[2 * kWideChunkDigits];
+        char* const chunks_end = chunks + sizeof(chunks);
+        char* chunks_pos = chunks_end;
+        while ((rest >> 64) != 0)
+        {
+            auto chunk = static_cast<uint64_t>(rest % kWideChunk);
+            rest /= kWideChunk;
+            for (int digit = 0; digit < kWideChunkDigits; digit++)
+            {
+                *--chunks_pos = static_cast<char>('0' + chunk % 10);
+                chunk /= 10;
+            }
+        }
+
+        char head_digits[20];
+        auto result = std::to_chars(head_digits, head_digits + sizeof(head_digits), static_cast<uint64_t>(rest));
+        std::string dec;
+        dec.reserve((result.ptr - head_digits) + (chunks_end - chunks_pos));
+        dec.append(head_digits, result.ptr);
+        dec.append(chunks_pos, chunks_end);
+        return dec;
+    }
+#endif
 
-    return uint256_t(hex_str.c_str());
-}
+    uint32_t work[T::number_of_limbs];
+    std::copy(limbs.begin(), limbs.begin() + used, work);
 
-inline std::string u256ToHex(uint256_t value)
-{
-    if (value == 0)
+    // the nine digit chunks are written from the right
+    char buffer[T::my_width2 / 3 + 32];
+    char* const end = buffer + sizeof(buffer);
+    char* pos = end;
+    while (used > 2)
     {
-        // std::cout << "u256ToHex: value is 0" << std::endl;
-        return "00";
+        uint64_t remainder = 0;
+        for (size_t i = used; i-- > 0;)
+        {
+            uint64_t current = (remainder << 32) | work[i];
+            work[i] = static_cast<uint32_t>(current / kChunk);
+            remainder = current % kChunk;
+        }
+        while (used > 0 && work[used - 1] == 0)
+        {
+            used--;
+        }
+        for (int digit = 0; digit < kChunkDigits; digit++)
+        {
+            *--pos = static_cast<char>('0' + remainder % 10);
+            remainder /= 10;
+        }
     }
 
-    std::stringstream ss;
-    ss << std::hex << value;
-    std::string u256_str;
-    u256_str = ss.str();
+    // what is left fits in 64 bits
+    uint64_t head = (used > 0 ? work[0] : 0) | (static_cast<uint64_t>(used > 1 ? work[1] : 0) << 32);
+    if (head == 0 && pos != end)
+    {
+        while (pos + 1 != end && *pos == '0')
+        {
+            pos++;
+        }
+        return std::string(pos, end);
+    }
 
-    // std::cout << "u256_str1: " << u256_str << std::endl;
+    char head_digits[20];
+    auto result = std::to_chars(head_digits, head_digits + sizeof(head_digits), head);
+    std::string dec;
+    dec.reserve((result.ptr - head_digits) + (end - pos));
+    dec.append(head_digits, result.ptr);
+    dec.append(pos, end);
+    return dec;
+}
 
-    if (u256_str.length() % 2 != 0)
+template <typename T>
+inline T bigUnsignedFromDec(std::string_view dec_str)
+{
+    static_assert(std::is_same_v<typename T::limb_type, uint32_t>, "32-bit limbs expected");
+    constexpr uint64_t kPowers[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    constexpr size_t kChunkDigits = 9;
+
+    auto parse = [&dec_str](size_t offset, size_t count, auto& out)
+    {
+        const char* first = dec_str.data() + offset;
+        auto result = std::from_chars(first, first + count, out);
+        if (result.ec != std::errc() || result.ptr != first + count)
+        {
+            throw std::invalid_argument("invalid decimal number: " + std::string(dec_str));
+        }
+    };
+
+    if (dec_str.empty())
+    {
+        throw std::invalid_argument("invalid decimal number: empty string");
+    }
+
+    // up to 19 digits always fit in 64 bits
+    if (dec_str.size() <= 19)
     {
-        u256_str = "0" + u256_str;
+        uint64_t small = 0;
+        parse(0, dec_str.size(), small);
+        return T(small);
     }
 
-    // std::cout << "u256_str2: " << u256_str << std::endl;
-    //
-    uint8_t bytes_length = u256_str.length() / 2;
-    std::string bytes_length_str = integerToHex<uint8_t>(bytes_length);
+#ifdef __SIZEOF_INT128__
+    // up to 38 digits always fit in 128 bits
+    if (dec_str.size() <= 38)
+    {
+        uint64_t high = 0;
+        uint64_t low = 0;
+        parse(0, dec_str.size() - 19, high);
+        parse(dec_str.size() - 19, 19, low);
+        NativeUInt128 wide = static_cast<NativeUInt128>(high) * 10000000000000000000ull + low;
+
+        T value = 0;
+        auto& limbs = value.representation();
+        for (size_t i = 0; i < 4; i++)
+        {
+            limbs[i] = static_cast<uint32_t>(wide >> (32 * i));
+        }
+        return value;
+    }
+#endif
 
-    // std::cout << "u256_str3: " << u256_str << std::endl;
-    reverseHex(u256_str);
+    T value = 0;
+    auto& limbs = value.representation();
+    size_t offset = 0;
+    size_t count = dec_str.size() % kChunkDigits == 0 ? kChunkDigits : dec_str.size() % kChunkDigits;
+    while (offset < dec_str.size())
+    {
+        uint32_t chunk = 0;
+        parse(offset, count, chunk);
+
+        // value = value * 10^count + chunk
+        uint64_t carry = chunk;
+        for (auto& limb : limbs)
+        {
+            uint64_t current = static_cast<uint64_t>(limb) * kPowers[count] + carry;
+            limb = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        if (carry != 0)
+        {
+            throw std::out_of_range(std::string(dec_str) + " does not fit in a " + std::to_string(T::my_width2) +
+                                    " bit integer");
+        }
+
+        offset += count;
+        count = kChunkDigits;
+    }
+    return value;
+}
 
-    // this string includes the length of the string and its hex representation
-    std::string encoded_u256_str = bytes_length_str + u256_str;
+inline uint128_t u128FromHex(const std::string& hex_str)
+{
+    return bigUnsignedFromHex<uint128_t>(hex_str);
+}
 
-    return encoded_u256_str;
+inline std::string u128ToHex(const uint128_t& value)
+{
+    return bigUnsignedToHex(value);
 }
 
-inline std::string u256ToDec(uint256_t value)
+inline CBytes u128ToBytes(const uint128_t& value)
 {
-    std::stringstream ss;
-    ss << value;
-    std::string u256_str;
-    u256_str = ss.str();
-    return u256_str;
+    return bigUnsignedToCBytes(value);
 }
 
-inline uint256_t u256FromDec(std::string dec_str)
+inline std::string u128ToDec(const uint128_t& value)
 {
-    return uint256_t(dec_str.c_str());
+    return bigUnsignedToDec(value);
 }
 
-inline void to_json(nlohmann::json& j, const uint256_t& p)
+inline uint128_t u128FromDec(std::string_view dec_str)
 {
-    j = u256ToDec(p);
+    return bigUnsignedFromDec<uint128_t>(dec_str);
 }
 
-inline void from_json(const nlohmann::json& j, uint256_t& p)
+inline void to_json(nlohmann::json& j, const uint128_t& p)
 {
-    p = u256FromDec(j.get<std::string>());
+    j = u128ToDec(p);
 }
 
-inline uint512_t u512FromHex(std::string hex_str)
+inline void from_json(const nlohmann::json& j, uint128_t& p)
 {
-    uint32_t len = hexToInteger<uint32_t>(hex_str.substr(0, 2));
+    p = u128FromDec(j.get_ref<const std::string&>());
+}
 
-    if (len < 1)
-    {
-        return uint512_t(0);
-    }
+inline uint256_t u256FromHex(const std::string& hex_str)
+{
+    return bigUnsignedFromHex<uint256_t>(hex_str);
+}
 
-    hex_str = hex_str.substr(2, len * 2);
-    reverseHex(hex_str);
-    hex_str = "0x" + hex_str;
+inline std::string u256ToHex(const uint256_t& value)
+{
+    return bigUnsignedToHex(value);
+}
 
-    return uint512_t(hex_str.c_str());
+inline CBytes u256ToBytes(const uint256_t& value)
+{
+    return bigUnsignedToCBytes(value);
 }
 
-inline std::string u512ToHex(uint512_t value)
+inline std::string u256ToDec(const uint256_t& value)
 {
-    if (value == 0)
-    {
-        // std::cout << "u512ToHex: value is 0" << std::endl;
-        return "00";
-    }
+    return bigUnsignedToDec(value);
+}
 
-    std::stringstream ss;
-    ss << std::hex << value;
-    std::string u512_str;
-    u512_str = ss.str();
+inline uint256_t u256FromDec(std::string_view dec_str)
+{
+    return bigUnsignedFromDec<uint256_t>(dec_str);
+}
 
-    if (u512_str.length() % 2 != 0)
-    {
-        u512_str = "0" + u512_str;
-    }
+inline void to_json(nlohmann::json& j, const uint256_t& p)
+{
+    j = u256ToDec(p);
+}
 
-    //
-    uint8_t bytes_length = u512_str.length() / 2;
-    std::string bytes_length_str = integerToHex<uint8_t>(bytes_length);
+inline void from_json(const nlohmann::json& j, uint256_t& p)
+{
+    p = u256FromDec(j.get_ref<const std::string&>());
+}
 
-    // std::cout << "u512_str: " << u512_str << std::endl;
-    reverseHex(u512_str);
+inline uint512_t u512FromHex(const std::string& hex_str)
+{
+    return bigUnsignedFromHex<uint512_t>(hex_str);
+}
 
-    // this string includes the length of the string and its hex representation
-    std::string encoded_u512_str = bytes_length_str + u512_str;
+inline std::string u512ToHex(const uint512_t& value)
+{
+    return bigUnsignedToHex(value);
+}
 
-    return encoded_u512_str;
+inline CBytes u512ToBytes(const uint512_t& value)
+{
+    return bigUnsignedToCBytes(value);
 }
 
-inline std::string u512ToDec(uint512_t value)
+inline std::string u512ToDec(const uint512_t& value)
 {
-    std::stringstream ss;
-    ss << value;
-    std::string u512_str;
-    u512_str = ss.str();
-    return u512_str;
+    return bigUnsignedToDec(value);
 }
 
-inline uint512_t u512FromDec(std::string dec_str)
+inline uint512_t u512FromDec(std::string_view dec_str)
 {
-    return uint512_t(dec_str.c_str());
+    return bigUnsignedFromDec<uint512_t>(dec_str);
 }
 
 inline void to_json(nlohmann::json& j, const uint512_t& p)
@@ -295,7 +470,7 @@ inline void to_json(nlohmann::json& j, const uint512_t& p)
 
 inline void from_json(const nlohmann::json& j, uint512_t& p)
 {
-    p = u512FromDec(j.get<std::string>());
+    p = u512FromDec(j.get_ref<const std::string&>());
 }
 
 } // namespace Casper
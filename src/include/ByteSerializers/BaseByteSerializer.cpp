@@ -3,59 +3,63 @@
 namespace Casper
 {
 
-void BaseByteSerializer::WriteInteger(CBytes& sb, int value)
+void BaseByteSerializer::WriteInteger(ByteSink& sb, int value)
 {
-    CBytes bytes = hexDecode(i32Encode(value));
-    //    if (!BitConverter.IsLittleEndian) Array.Reverse(bytes);
-
-    sb += bytes;
+    sb.WriteI32(value);
 }
 
-void BaseByteSerializer::WriteUInteger(CBytes& sb, uint32_t value)
+void BaseByteSerializer::WriteUInteger(ByteSink& sb, uint32_t value)
 {
-    CBytes bytes = hexDecode(u32Encode(value));
-    //    if (!BitConverter.IsLittleEndian) Array.Reverse(bytes);
+    sb.WriteU32(value);
+}
 
-    sb += bytes;
+void BaseByteSerializer::WriteULong(ByteSink& sb, uint64_t value)
+{
+    sb.WriteU64(value);
 }
 
-void BaseByteSerializer::WriteULong(CBytes& sb, uint64_t value)
+void BaseByteSerializer::WriteByte(ByteSink& sb, uint8_t value)
 {
-    CBytes bytes = hexDecode(u64Encode(value));
-    //    if (!BitConverter.IsLittleEndian) Array.Reverse(bytes);
+    sb.WriteByte(value);
+}
 
-    sb += bytes;
+void BaseByteSerializer::WriteBytes(ByteSink& sb, const std::vector<uint8_t>& value)
+{
+    sb.WriteBytes(value);
 }
 
-void BaseByteSerializer::WriteByte(CBytes& sb, uint8_t value)
+void BaseByteSerializer::WriteBytes(ByteSink& sb, const CBytes& value)
 {
-    // std::cout << "byte write u8: " << u8Encode(value) << std::endl;
-    CBytes bytes = hexDecode(u8Encode(value));
-    sb += bytes;
+    sb.WriteBytes(value);
 }
 
-void BaseByteSerializer::WriteBytes(CBytes& sb, const std::vector<uint8_t>& value)
+void BaseByteSerializer::WriteString(ByteSink& sb, const std::string& value)
 {
-    // TODO: CHECK BELOW!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-    CBytes bytes(value.size());
-    for (size_t i = 0; i < value.size(); i++)
-    {
-        bytes[i] = value[i];
-    }
-    sb += bytes;
+    sb.WriteString(value);
 }
 
-void BaseByteSerializer::WriteBytes(CBytes& sb, const CBytes& value)
+void BaseByteSerializer::WriteHash(ByteSink& sb, const Hash32& value)
 {
-    sb += value;
+    sb.Write(value.data(), Hash32::SIZE);
 }
 
-void BaseByteSerializer::WriteString(CBytes& sb, const std::string& value)
+PublicKey BaseByteSerializer::ReadPublicKey(ByteReader& reader)
 {
-    CBytes bytes = hexDecode(stringEncode(value));
-    //    if (!BitConverter.IsLittleEndian) Array.Reverse(bytes);
+    uint8_t algo = reader.ReadByte();
+    if (algo != KeyAlgo::ED25519 && algo != KeyAlgo::SECP256K1)
+    {
+        throw std::invalid_argument("Invalid key algorithm identifier.");
+    }
 
-    sb += bytes;
+    KeyAlgo key_algo = static_cast<KeyAlgo::Value>(algo);
+    auto raw_bytes = reader.ReadBytes(KeyAlgo::GetKeySizeInBytes(key_algo) - 1);
+    return PublicKey::FromRawBytes(ToCBytes(raw_bytes), key_algo);
+}
+
+Hash32 BaseByteSerializer::ReadHash(ByteReader& reader)
+{
+    auto bytes = reader.ReadBytes(Hash32::SIZE);
+    return Hash32::FromBytes(bytes.data(), bytes.size());
 }
 
 } // namespace Casper
@@ -1,7 +1,11 @@
 #pragma once
 #include "Base.h"
 
+#include "ByteSerializers/ByteReader.h"
+#include "ByteSerializers/ByteSink.h"
+#include "ByteSerializers/ByteWriter.h"
 #include "Types/CLConverter.h"
+#include "Types/Hash32.h"
 #include "Utils/CryptoUtil.h"
 #include "Utils/CEP57Checksum.h"
 
@@ -11,19 +15,25 @@ namespace Casper
 class BaseByteSerializer
 {
 protected:
-    static void WriteInteger(CBytes& sb, int value);
+    static void WriteInteger(ByteSink& sb, int value);
 
-    static void WriteUInteger(CBytes& sb, uint32_t value);
+    static void WriteUInteger(ByteSink& sb, uint32_t value);
 
-    static void WriteULong(CBytes& sb, uint64_t value);
+    static void WriteULong(ByteSink& sb, uint64_t value);
 
-    static void WriteByte(CBytes& sb, uint8_t value);
+    static void WriteByte(ByteSink& sb, uint8_t value);
 
-    static void WriteBytes(CBytes& sb, const std::vector<uint8_t>& value);
+    static void WriteBytes(ByteSink& sb, const std::vector<uint8_t>& value);
 
-    static void WriteBytes(CBytes& sb, const CBytes& value);
+    static void WriteBytes(ByteSink& sb, const CBytes& value);
 
-    static void WriteString(CBytes& sb, const std::string& value);
+    static void WriteString(ByteSink& sb, const std::string& value);
+
+    static void WriteHash(ByteSink& sb, const Hash32& value);
+
+    static PublicKey ReadPublicKey(ByteReader& reader);
+
+    static Hash32 ReadHash(ByteReader& reader);
 };
 
 } // namespace Casper
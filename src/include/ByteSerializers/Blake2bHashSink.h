@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Base.h"
+#include "ByteSerializers/ByteSink.h"
+
+#include <cryptopp/blake2.h>
+
+namespace Casper
+{
+/// <summary>
+/// ByteSink that feeds everything written to it into a BLAKE2b digest, so a
+/// value can be hashed while it is being serialized, without buffering it.
+/// </summary>
+class Blake2bHashSink : public ByteSink
+{
+public:
+    /// <summary>
+    /// Creates a sink producing a digest of `digestSize` bytes (32 for deploy
+    /// and account hashes).
+    /// </summary>
+    explicit Blake2bHashSink(unsigned int digestSize = 32u)
+        : _digest(digestSize)
+    {
+    }
+
+    void Write(const uint8_t* data, size_t size) override { _digest.Update(data, size); }
+
+    /// <summary>
+    /// Returns the digest of the bytes written so far and resets the sink.
+    /// </summary>
+    CBytes Final()
+    {
+        CBytes hash(_digest.DigestSize());
+        _digest.Final(hash.data());
+        return hash;
+    }
+
+private:
+    CryptoPP::BLAKE2b _digest;
+};
+
+} // namespace Casper
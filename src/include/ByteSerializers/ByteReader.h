@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "Base.h"
+#include "Utils/StringUtil.h"
+
+namespace Casper
+{
+/// <summary>
+/// Cursor over a bytesrepr encoded buffer. Reads little-endian values and
+/// hands out views into the input, the buffer must outlive the reader and
+/// every span or string_view obtained from it.
+/// </summary>
+class ByteReader
+{
+public:
+    explicit ByteReader(std::span<const uint8_t> data)
+        : _data(data)
+    {
+    }
+
+    [[nodiscard]] size_t Position() const { return _position; }
+
+    [[nodiscard]] size_t Remaining() const { return _data.size() - _position; }
+
+    [[nodiscard]] bool IsEmpty() const { return _position == _data.size(); }
+
+    uint8_t ReadByte() { return Take(1)[0]; }
+
+    int32_t ReadI32() { return ReadLittleEndian<int32_t>(); }
+
+    uint32_t ReadU32() { return ReadLittleEndian<uint32_t>(); }
+
+    int64_t ReadI64() { return ReadLittleEndian<int64_t>(); }
+
+    uint64_t ReadU64() { return ReadLittleEndian<uint64_t>(); }
+
+    /// <summary>
+    /// Returns a view of the next `size` bytes.
+    /// </summary>
+    std::span<const uint8_t> ReadBytes(size_t size) { return Take(size); }
+
+    /// <summary>
+    /// Returns a view of a u32 length prefixed byte sequence.
+    /// </summary>
+    std::span<const uint8_t> ReadSizedBytes() { return Take(ReadU32()); }
+
+    /// <summary>
+    /// Returns a view of a u32 length prefixed UTF-8 string. Throws if the
+    /// bytes are not valid UTF-8.
+    /// </summary>
+    std::string_view ReadString()
+    {
+        size_t offset = _position;
+        auto bytes = ReadSizedBytes();
+        std::string_view str(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+        if (!StringUtil::isValidUtf8(str))
+        {
+            throw std::runtime_error("ByteReader: invalid UTF-8 string at offset " + std::to_string(offset));
+        }
+        return str;
+    }
+
+    /// <summary>
+    /// Returns a view of everything not consumed yet.
+    /// </summary>
+    std::span<const uint8_t> ReadRemaining() { return Take(Remaining()); }
+
+private:
+    std::span<const uint8_t> Take(size_t size)
+    {
+        if (size > Remaining())
+        {
+            throw std::runtime_error("ByteReader: unexpected end of input, " + std::to_string(size) +
+                                     " bytes requested at offset " + std::to_string(_position) + " but only " +
+                                     std::to_string(Remaining()) + " left");
+        }
+        auto view = _data.subspan(_position, size);
+        _position += size;
+        return view;
+    }
+
+    template <typename T>
+    T ReadLittleEndian()
+    {
+        uint8_t bytes[sizeof(T)];
+        auto view = Take(sizeof(T));
+        std::copy(view.begin(), view.end(), bytes);
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    std::span<const uint8_t> _data;
+    size_t _position = 0;
+};
+
+/// <summary>
+/// Copies a view returned by ByteReader into an owning CBytes.
+/// </summary>
+inline CBytes ToCBytes(std::span<const uint8_t> view)
+{
+    return CBytes(view.data(), view.size());
+}
+
+} // namespace Casper
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Base.h"
+
+namespace Casper
+{
+/// <summary>
+/// Destination for bytesrepr output. Implementations only provide Write(),
+/// the typed helpers encode values in little-endian order on top of it.
+/// </summary>
+class ByteSink
+{
+public:
+    virtual ~ByteSink() = default;
+
+    /// <summary>
+    /// Consumes `size` bytes starting at `data`.
+    /// </summary>
+    virtual void Write(const uint8_t* data, size_t size) = 0;
+
+    void WriteByte(uint8_t value) { Write(&value, 1); }
+
+    void WriteI32(int32_t value) { WriteLittleEndian(value); }
+
+    void WriteU32(uint32_t value) { WriteLittleEndian(value); }
+
+    void WriteI64(int64_t value) { WriteLittleEndian(value); }
+
+    void WriteU64(uint64_t value) { WriteLittleEndian(value); }
+
+    void WriteBytes(const uint8_t* data, size_t size) { Write(data, size); }
+
+    void WriteBytes(const CBytes& value) { Write(value.data(), value.size()); }
+
+    void WriteBytes(const std::vector<uint8_t>& value) { Write(value.data(), value.size()); }
+
+    /// <summary>
+    /// Writes a string as a u32 byte length followed by its UTF-8 bytes.
+    /// </summary>
+    void WriteString(const std::string& value)
+    {
+        WriteU32(static_cast<uint32_t>(value.size()));
+        Write(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+    }
+
+private:
+    template <typename T>
+    void WriteLittleEndian(T value)
+    {
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        Write(bytes, sizeof(T));
+    }
+};
+
+} // namespace Casper
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "Types/CLTypeTable.h"
+#include "Types/CLValue.h"
+#include "Types/Deploy.h"
+#include "Types/ExecutableDeployItem.h"
+#include "Types/NamedArg.h"
+
+namespace Casper
+{
+/// <summary>
+/// Computes the exact bytesrepr length of a value without serializing it.
+/// Every SizeOf() mirrors the matching ByteSerializer::ToBytes().
+/// </summary>
+struct ByteSizeCalculator
+{
+    /// <summary>
+    /// Walks the tree of the type. A CLType is not built for it, that would
+    /// intern types from node responses into the CLTypeTable.
+    /// </summary>
+    static size_t SizeOf(const CLTypeRVA& type)
+    {
+        // every type starts with its one byte tag
+        switch (type.which())
+        {
+        case 2:
+        {
+            const auto& mp = boost::get<std::map<CLTypeRVA, CLTypeRVA>>(type);
+            return 1 + SizeOf(mp.begin()->first) + SizeOf(mp.begin()->second);
+        }
+        case 3:
+        {
+            const auto& inner = *boost::get<std::map<std::string, CLTypeRVA>>(type).begin();
+            if (inner.first == "Result")
+            {
+                const auto& result = boost::get<std::map<std::string, CLTypeRVA>>(inner.second);
+                return 1 + SizeOf(result.at("Ok")) + SizeOf(result.at("Err"));
+            }
+            return 1 + SizeOf(inner.second);
+        }
+        case 4:
+        {
+            size_t size = 1;
+            for (const auto& item : boost::get<std::map<std::string, std::vector<CLTypeRVA>>>(type).begin()->second)
+            {
+                size += SizeOf(item);
+            }
+            return size;
+        }
+        case 5:
+            return 1 + sizeof(int32_t);
+        default:
+            return 1;
+        }
+    }
+
+    static size_t SizeOf(const CLType& type)
+    {
+        if (type.Handle() == CL_TYPE_NOT_INTERNED)
+        {
+            return CLTypeTable::Encode(type.Type()).size();
+        }
+        return CLTypeTable::Instance().Get(type.Handle()).bytes.size();
+    }
+
+    static size_t SizeOf(const CLValue& value)
+    {
+        return sizeof(int32_t) + value.GetBytes().size() + SizeOf(value.GetType());
+    }
+
+    static size_t SizeOf(const NamedArg& arg) { return SizeOfString(arg.name) + SizeOf(arg.value); }
+
+    static size_t SizeOf(const std::vector<NamedArg>& args)
+    {
+        size_t size = sizeof(uint32_t);
+        for (const auto& arg : args)
+        {
+            size += SizeOf(arg);
+        }
+        return size;
+    }
+
+    static size_t SizeOf(const ExecutableDeployItem& item)
+    {
+        // every variant starts with its one byte tag
+        size_t size = 1;
+        if (item.module_bytes.has_value())
+        {
+            const auto& module = item.module_bytes.value();
+            size += sizeof(int32_t) + module.module_bytes.size() + SizeOf(module.args);
+        }
+        else if (item.stored_contract_by_hash.has_value())
+        {
+            const auto& contract = item.stored_contract_by_hash.value();
+            size += SizeOfHex(contract.hash) + SizeOfString(contract.entry_point) + SizeOf(contract.args);
+        }
+        else if (item.stored_contract_by_name.has_value())
+        {
+            const auto& contract = item.stored_contract_by_name.value();
+            size += SizeOfString(contract.name) + SizeOfString(contract.entry_point) + SizeOf(contract.args);
+        }
+        else if (item.stored_versioned_contract_by_hash.has_value())
+        {
+            const auto& contract = item.stored_versioned_contract_by_hash.value();
+            size += SizeOfHex(contract.hash) + SizeOfVersion(contract.version) + SizeOfString(contract.entry_point) +
+                    SizeOf(contract.args);
+        }
+        else if (item.stored_versioned_contract_by_name.has_value())
+        {
+            const auto& contract = item.stored_versioned_contract_by_name.value();
+            size += SizeOfString(contract.name) + SizeOfVersion(contract.version) +
+                    SizeOfString(contract.entry_point) + SizeOf(contract.args);
+        }
+        else if (item.transfer.has_value())
+        {
+            size += SizeOf(item.transfer.value().args);
+        }
+        else
+        {
+            throw std::runtime_error("Unsupported ExecutableDeployItem type");
+        }
+        return size;
+    }
+
+    static size_t SizeOf(const DeployHeader& header)
+    {
+        // account, then timestamp, ttl and gas price as u64
+        size_t size = 1 + header.account.raw_bytes.size() + 3 * sizeof(uint64_t);
+        size += Hash32::SIZE + sizeof(int32_t) + header.dependencies.size() * Hash32::SIZE;
+        return size + SizeOfString(header.chain_name);
+    }
+
+    static size_t SizeOf(const DeployApproval& approval)
+    {
+        return 1 + approval.signer.raw_bytes.size() + 1 + approval.signature.raw_bytes.size();
+    }
+
+    static size_t SizeOf(const Deploy& deploy)
+    {
+        size_t size = SizeOf(deploy.header) + Hash32::SIZE + SizeOf(deploy.payment) + SizeOf(deploy.session);
+        size += sizeof(int32_t);
+        for (const auto& approval : deploy.approvals)
+        {
+            size += SizeOf(approval);
+        }
+        return size;
+    }
+
+private:
+    static size_t SizeOfString(const std::string& value) { return sizeof(uint32_t) + value.size(); }
+
+    static size_t SizeOfHex(const std::string& hex) { return hex.size() / 2; }
+
+    static size_t SizeOfVersion(const std::optional<uint32_t>& version)
+    {
+        return version.has_value() ? 1 + sizeof(uint32_t) : 1;
+    }
+};
+
+} // namespace Casper
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Base.h"
+#include "ByteSerializers/ByteSink.h"
+
+namespace Casper
+{
+/// <summary>
+/// Growable output buffer for bytesrepr serialization. Values are appended
+/// in little-endian order directly, without going through hex strings.
+/// </summary>
+class ByteWriter : public ByteSink
+{
+public:
+    ByteWriter() = default;
+
+    /// <summary>
+    /// Creates a writer with room for at least `capacity` bytes.
+    /// </summary>
+    explicit ByteWriter(size_t capacity) { _buffer.reserve(capacity); }
+
+    /// <summary>
+    /// Makes sure the buffer can hold `capacity` bytes without reallocating.
+    /// </summary>
+    void Reserve(size_t capacity) { _buffer.reserve(capacity); }
+
+    void Write(const uint8_t* data, size_t size) override { _buffer.insert(_buffer.end(), data, data + size); }
+
+    [[nodiscard]] const uint8_t* Data() const { return _buffer.data(); }
+
+    [[nodiscard]] size_t Size() const { return _buffer.size(); }
+
+    void Clear() { _buffer.clear(); }
+
+    /// <summary>
+    /// Copies the written bytes into a new CBytes.
+    /// </summary>
+    [[nodiscard]] CBytes ToBytes() const { return CBytes(_buffer.data(), _buffer.size()); }
+
+private:
+    std::vector<uint8_t> _buffer;
+};
+
+} // namespace Casper
@@ -1,167 +1,447 @@
 #pragma once
 #include "ByteSerializers/BaseByteSerializer.h"
+#include "ByteSerializers/ByteSizeCalculator.h"
+#include "ByteSerializers/GlobalStateKeyByteSerializer.h"
+#include "Types/CLTypeTable.h"
 #include "Types/CLValue.h"
+#include <algorithm>
 #include <boost/variant/get.hpp>
 namespace Casper
 {
 struct CLValueByteSerializer : public BaseByteSerializer
 {
-    ///
+    /// <summary>
+    /// Deepest nesting of Option, List, Map, Tuple and Result types that
+    /// CLTypeFromBytes accepts, the same limit as the node's bytesrepr.
+    /// </summary>
+    static constexpr size_t MAX_TYPE_DEPTH = 50;
+
+    /// <summary>
+    /// List and Map elements accepted in one value beyond one per byte of the
+    /// value. Every count read draws from this budget for the whole decode,
+    /// so elements that take up no bytes (Unit, tuples of those) can not add
+    /// up to more than this however the Lists holding them are nested.
+    /// </summary>
+    static constexpr uint32_t MAX_ZERO_WIDTH_ELEMENTS = 1 << 16;
+
     CBytes ToBytes(const CLValue& source)
     {
-        // ByteQueue byte_queue;
-        CBytes bytes;
+        ByteWriter bytes(ByteSizeCalculator::SizeOf(source));
+        ToBytes(bytes, source);
+        return bytes.ToBytes();
+    }
+
+    void ToBytes(ByteSink& bytes, const CLValue& source)
+    {
         // serialize data length (4 bytes)
         //
-        WriteInteger(bytes, source.bytes.size());
-        // std::cout << "CLValueByteSerializer::ToBytes: source.bytes.size() = "
-        //          << source.bytes.size() << std::endl;
+        WriteInteger(bytes, source.GetBytes().size());
+
         // serialize data
         //
+        WriteBytes(bytes, source.GetBytes());
 
-        // std::cout << "CLValueByteSerializer::ToBytes: source.bytes = "
-        //           << hexEncode(source.bytes) << std::endl;
-        WriteBytes(bytes, source.bytes);
-        // std::cout << "CLValueByteSerializer::ToBytes: source.bytes.size() = "
-        //          << source.bytes.size() << std::endl;
         // serialize type and inner types (if any) recursively
         //
-        // std::cout << "hexencode to bytes:" << hexEncode(bytes) << std::endl;
-        // nlohmann::json jjj;
-        // to_json(jjj, source.parsed);
-        // std::cout << "CLValueByteSerializer::ToBytes: source.parsed = "
-        //  << jjj.dump(2) << std::endl;
-
-        CLTypeToBytes(bytes, source.cl_type, source.parsed.parsed);
-        // std::cout << "CLValueByteSerializer::ToBytes: after CLTypeToBytes"
-        //           << hexEncode(bytes) << std::endl;
-        return bytes;
+        CLTypeToBytes(bytes, source.GetType());
     }
 
-    void CLTypeToBytes(CBytes& sb, CLType innerType, CLTypeParsedRVA parsed)
+    /// <summary>
+    /// Writes the type tags. The encoding of each distinct type is computed
+    /// once by the CLTypeTable, later calls only look it up. Types left out
+    /// of the full table are encoded each time.
+    /// </summary>
+    void CLTypeToBytes(ByteSink& sb, const CLType& type)
     {
-        // std::cout << "CLTypeToBytes1: " << std::endl;
-        int type_idx = innerType.type.which();
-        SPDLOG_DEBUG("CLTypeToBytes idx: {}", type_idx);
+        if (type.Handle() == CL_TYPE_NOT_INTERNED)
+        {
+            std::vector<uint8_t> bytes = CLTypeTable::Encode(type.Type());
+            sb.Write(bytes.data(), bytes.size());
+            return;
+        }
 
-        nlohmann::json j;
-        to_json(j, innerType);
-        // std::cout << "CLTypeToBytes json: " << j.dump(2) << std::endl;
+        const CLTypeDescriptor& descriptor = CLTypeTable::Instance().Get(type.Handle());
+        sb.Write(descriptor.bytes.data(), descriptor.bytes.size());
+    }
 
-        if (type_idx == 0)
+    CLValue FromBytes(std::span<const uint8_t> bytes)
+    {
+        ByteReader reader(bytes);
+        return FromBytes(reader);
+    }
+
+    CLValue FromBytes(ByteReader& reader)
+    {
+        // data length and data, followed by the type tags. The data is
+        // decoded now so that malformed values are rejected here.
+        //
+        auto value_bytes = reader.ReadSizedBytes();
+        CLTypeRVA type = CLTypeFromBytes(reader);
+        CLTypeParsedRVA parsed = ParsedFromBytes(value_bytes, type);
+
+        return CLValue(ToCBytes(value_bytes), type, std::move(parsed));
+    }
+
+    CLTypeRVA CLTypeFromBytes(ByteReader& reader, size_t depth = 0)
+    {
+        if (depth > MAX_TYPE_DEPTH)
         {
-            CLTypeEnum type = boost::get<CLTypeEnum>(innerType.type);
-            WriteByte(sb, static_cast<uint8_t>(type));
+            throw std::invalid_argument("CLTypeFromBytes: types nested deeper than " +
+                                        std::to_string(MAX_TYPE_DEPTH) + " levels");
         }
-        else if (type_idx == 1)
+
+        uint8_t tag = reader.ReadByte();
+        switch (static_cast<CLTypeEnum>(tag))
+        {
+        case CLTypeEnum::Option:
+        case CLTypeEnum::List:
         {
-            throw std::runtime_error("CLTypeToBytes: type_idx = 1 not implemented");
+            std::string name = tag == static_cast<uint8_t>(CLTypeEnum::Option) ? "Option" : "List";
+            std::map<std::string, CLTypeRVA> wrapper;
+            wrapper[name] = CLTypeFromBytes(reader, depth + 1);
+            return wrapper;
         }
-        else if (type_idx == 2)
+        case CLTypeEnum::ByteArray:
         {
-            WriteByte(sb, 17);
-            std::map<CLTypeRVA, CLTypeRVA> mp = boost::get<std::map<CLTypeRVA, CLTypeRVA>>(innerType.type);
-            if (parsed.which() == 16)
-            {
-                CLTypeToBytes(sb, mp.begin()->first, parsed);
-                CLTypeToBytes(sb, mp.begin()->second, parsed);
-            }
-            else
-            {
-                std::map<CLTypeParsedRVA, CLTypeParsedRVA> mp2 =
-                    boost::get<std::map<CLTypeParsedRVA, CLTypeParsedRVA>>(parsed);
+            std::map<std::string, int32_t> byte_array;
+            byte_array["ByteArray"] = reader.ReadI32();
+            return byte_array;
+        }
+        case CLTypeEnum::Result:
+        {
+            std::map<std::string, CLTypeRVA> ok_err;
+            ok_err["Ok"] = CLTypeFromBytes(reader, depth + 1);
+            ok_err["Err"] = CLTypeFromBytes(reader, depth + 1);
 
-                CLTypeToBytes(sb, mp.begin()->first, mp2.begin()->first);
-                CLTypeToBytes(sb, mp.begin()->second, mp2.begin()->second);
-            }
+            std::map<std::string, CLTypeRVA> wrapper;
+            wrapper["Result"] = ok_err;
+            return wrapper;
         }
-        else if (type_idx == 3)
+        case CLTypeEnum::Map:
         {
-            auto inner_type_rva = boost::get<std::map<std::string, CLTypeRVA>>(innerType.type);
-            // std::cout << "3-1" << std::endl;
-            std::string inner_type_name = inner_type_rva.begin()->first;
-            // std::cout << "3-2" << std::endl;
-            CLTypeRVA inner_type_rva_value = inner_type_rva.begin()->second;
-            // std::cout << "3-3" << std::endl;
-            if (inner_type_name == "Option")
+            CLTypeRVA key_type = CLTypeFromBytes(reader, depth + 1);
+            CLTypeRVA value_type = CLTypeFromBytes(reader, depth + 1);
+
+            std::map<CLTypeRVA, CLTypeRVA> mp;
+            mp[key_type] = value_type;
+            return mp;
+        }
+        case CLTypeEnum::Tuple1:
+        case CLTypeEnum::Tuple2:
+        case CLTypeEnum::Tuple3:
+        {
+            size_t count = tag - static_cast<uint8_t>(CLTypeEnum::Tuple1) + 1;
+            std::vector<CLTypeRVA> inner_types;
+            for (size_t i = 0; i < count; i++)
             {
-                WriteByte(sb, 13);
-                // if (parsed.which() != 14) {
-                // std::cout << "3-option" << std::endl;
-                CLTypeToBytes(sb, inner_type_rva_value, parsed);
-                // }
+                inner_types.push_back(CLTypeFromBytes(reader, depth + 1));
             }
-            else if (inner_type_name == "List")
+
+            std::map<std::string, std::vector<CLTypeRVA>> tuple;
+            tuple["Tuple" + std::to_string(count)] = inner_types;
+            return tuple;
+        }
+        default:
+            if (tag > static_cast<uint8_t>(CLTypeEnum::PublicKey))
             {
-                WriteByte(sb, 14);
-                // std::cout << "3-4" << std::endl;
+                throw std::runtime_error("CLTypeFromBytes: unknown type tag " + std::to_string(tag));
+            }
+            return static_cast<CLTypeEnum>(tag);
+        }
+    }
 
-                // Option None, parsed is nullptr case
+    /// <summary>
+    /// Decodes all of the value bytes of the given type, throws if any are
+    /// left over.
+    /// </summary>
+    CLTypeParsedRVA ParsedFromBytes(std::span<const uint8_t> bytes, const CLTypeRVA& type)
+    {
+        ByteReader reader(bytes);
+        CLTypeParsedRVA parsed = ParsedFromBytes(reader, type);
+        if (!reader.IsEmpty())
+        {
+            throw std::runtime_error("CLValue FromBytes: " + std::to_string(reader.Remaining()) +
+                                     " unexpected bytes after the value");
+        }
+        return parsed;
+    }
 
-                // std::cout << "3-5" << std::endl;
+    /// <summary>
+    /// Decodes the value bytes of the given type into the representation
+    /// produced by from_json for the same value. A value of type Any takes up
+    /// the rest of the bytes, so Any is only accepted as the whole value and
+    /// not inside a List, Map, Tuple, Option or Result.
+    /// </summary>
+    CLTypeParsedRVA ParsedFromBytes(ByteReader& reader, const CLTypeRVA& type)
+    {
+        if (type.which() == 0 && boost::get<CLTypeEnum>(type) == CLTypeEnum::Any)
+        {
+            // the layout is unknown, the value takes up the rest of the bytes
+            reader.ReadRemaining();
+            return std::monostate{};
+        }
 
-                // TODO: Check if this is correct, maybe whole list can be serialized
-                CLTypeToBytes(sb, inner_type_rva_value, parsed);
-                // std::cout << "3-6" << std::endl;
-            }
-            else if (inner_type_name == "Result")
-            {
-                WriteByte(sb, 16);
-                std::map<std::string, CLTypeRVA> inner_type_rva2 =
-                    boost::get<std::map<std::string, CLTypeRVA>>(inner_type_rva_value);
+        size_t elements = reader.Remaining() + MAX_ZERO_WIDTH_ELEMENTS;
+        return ParsedFromBytes(reader, type, elements);
+    }
 
-                CLTypeToBytes(sb, inner_type_rva2.at("Ok"), parsed);
-                CLTypeToBytes(sb, inner_type_rva2.at("Err"), parsed);
+private:
+    /// <summary>
+    /// ParsedFromBytes() drawing the element counts of the Lists and Maps
+    /// from `elements`, the budget left for the whole value.
+    /// </summary>
+    CLTypeParsedRVA ParsedFromBytes(ByteReader& reader, const CLTypeRVA& type, size_t& elements)
+    {
+        int type_idx = type.which();
+        if (type_idx == 0)
+        {
+            switch (boost::get<CLTypeEnum>(type))
+            {
+            case CLTypeEnum::Bool:
+                return ReadBool(reader.ReadByte());
+            case CLTypeEnum::I32:
+                return reader.ReadI32();
+            case CLTypeEnum::I64:
+                return reader.ReadI64();
+            case CLTypeEnum::U8:
+                return reader.ReadByte();
+            case CLTypeEnum::U32:
+                return reader.ReadU32();
+            case CLTypeEnum::U64:
+                return reader.ReadU64();
+            case CLTypeEnum::U128:
+                return ReadBigUnsigned<uint128_t>(reader);
+            case CLTypeEnum::U256:
+                return ReadBigUnsigned<uint256_t>(reader);
+            case CLTypeEnum::U512:
+                return CLTypeParsedU512(ReadBigUnsigned<uint512_t>(reader));
+            case CLTypeEnum::Unit:
+                return std::monostate{};
+            case CLTypeEnum::String:
+                return std::string(reader.ReadString());
+            case CLTypeEnum::Key:
+            {
+                GlobalStateKeyByteSerializer keySerializer;
+                return keySerializer.FromBytes(reader);
+            }
+            case CLTypeEnum::URef:
+                return URef(ToCBytes(reader.ReadBytes(33)));
+            case CLTypeEnum::PublicKey:
+                return ReadPublicKey(reader);
+            case CLTypeEnum::Any:
+                // where a nested Any ends is unknown, the bytes after it can not be read
+                throw std::runtime_error("ParsedFromBytes: Any inside another type is not supported");
+            default:
+                throw std::runtime_error("ParsedFromBytes: unsupported type");
             }
-            else
+        }
+        else if (type_idx == 2)
+        {
+            const auto& mp = boost::get<std::map<CLTypeRVA, CLTypeRVA>>(type);
+            std::map<CLTypeParsedRVA, CLTypeParsedRVA> parsed_map;
+
+            // the keys are distinct, so at most one of a type that takes up no bytes
+            uint32_t count = ReadCount(reader, mp.begin()->first, 1, "Map", elements);
+            for (uint32_t i = 0; i < count; i++)
             {
-                throw std::runtime_error("CLTypeToBytes: inner_type_name = " + inner_type_name + " not implemented");
+                CLTypeParsedRVA key = ParsedFromBytes(reader, mp.begin()->first, elements);
+                parsed_map.insert_or_assign(std::move(key), ParsedFromBytes(reader, mp.begin()->second, elements));
             }
+            return parsed_map;
         }
-        else if (type_idx == 4)
+        else if (type_idx == 3)
         {
-            auto inner_type_rva = boost::get<std::map<std::string, std::vector<CLTypeRVA>>>(innerType.type);
-            std::string inner_type_name = inner_type_rva.begin()->first;
-            if (inner_type_name == "Tuple1")
+            const auto& inner = *boost::get<std::map<std::string, CLTypeRVA>>(type).begin();
+            if (inner.first == "Option")
             {
-                WriteByte(sb, 18);
-                CLTypeToBytes(sb, inner_type_rva.begin()->second.at(0), parsed);
+                if (!ReadTag(reader, "Option"))
+                {
+                    return std::monostate{};
+                }
+                return ParsedFromBytes(reader, inner.second, elements);
             }
-            else if (inner_type_name == "Tuple2")
+            else if (inner.first == "List")
             {
-                WriteByte(sb, 19);
-                CLTypeToBytes(sb, inner_type_rva.begin()->second.at(0), parsed);
-                CLTypeToBytes(sb, inner_type_rva.begin()->second.at(1), parsed);
+                uint32_t count = ReadCount(reader, inner.second, MAX_ZERO_WIDTH_ELEMENTS, "List", elements);
+                if (inner.second.which() == 0)
+                {
+                    if (auto array = ParsedArrayFromBytes(reader, boost::get<CLTypeEnum>(inner.second), count))
+                    {
+                        return std::move(*array);
+                    }
+                }
+
+                std::vector<CLTypeParsedRVA> parsed_list;
+                parsed_list.reserve(std::min<size_t>(count, reader.Remaining()));
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    parsed_list.push_back(ParsedFromBytes(reader, inner.second, elements));
+                }
+                return parsed_list;
             }
-            else if (inner_type_name == "Tuple3")
+            else if (inner.first == "Result")
             {
-                WriteByte(sb, 20);
-                CLTypeToBytes(sb, inner_type_rva.begin()->second.at(0), parsed);
-                CLTypeToBytes(sb, inner_type_rva.begin()->second.at(1), parsed);
-                CLTypeToBytes(sb, inner_type_rva.begin()->second.at(2), parsed);
+                const auto& ok_err = boost::get<std::map<std::string, CLTypeRVA>>(inner.second);
+                if (ReadTag(reader, "Result"))
+                {
+                    return ParsedFromBytes(reader, ok_err.at("Ok"), elements);
+                }
+                return ParsedFromBytes(reader, ok_err.at("Err"), elements);
             }
-            else
+            throw std::runtime_error("ParsedFromBytes: inner_type_name = " + inner.first + " not implemented");
+        }
+        else if (type_idx == 4)
+        {
+            std::vector<CLTypeParsedRVA> parsed_tuple;
+            for (const auto& item : boost::get<std::map<std::string, std::vector<CLTypeRVA>>>(type).begin()->second)
             {
-                throw std::runtime_error("Unknown inner type with idx:4 not tuple");
+                parsed_tuple.push_back(ParsedFromBytes(reader, item, elements));
             }
+            return parsed_tuple;
         }
         else if (type_idx == 5)
         {
-            // std::cout << "CLTypeToBytes: type_idx = 5 " << std::endl;
-            auto inner_type_rva = boost::get<std::map<std::string, int32_t>>(innerType.type);
-            // std::cout << "after get inner_type_rva" << std::endl;
-            std::string inner_type_name = inner_type_rva.begin()->first;
-            // std::cout << "after get inner_type_name" << std::endl;
-            if (inner_type_name == "ByteArray")
+            int32_t size = boost::get<std::map<std::string, int32_t>>(type).begin()->second;
+            return hexEncode(ToCBytes(reader.ReadBytes(size)));
+        }
+
+        throw std::runtime_error("ParsedFromBytes: type_idx = " + std::to_string(type_idx) + " not implemented");
+    }
+
+    /// <summary>
+    /// True if a value of the type may be encoded in no bytes at all. Any is
+    /// not nested, so it is never an element.
+    /// </summary>
+    static bool IsZeroWidth(const CLTypeRVA& type)
+    {
+        switch (type.which())
+        {
+        case 0:
+        {
+            return boost::get<CLTypeEnum>(type) == CLTypeEnum::Unit;
+        }
+        case 4:
+        {
+            const auto& items = boost::get<std::map<std::string, std::vector<CLTypeRVA>>>(type).begin()->second;
+            return std::all_of(items.begin(), items.end(), IsZeroWidth);
+        }
+        case 5:
+            return boost::get<std::map<std::string, int32_t>>(type).begin()->second == 0;
+        default:
+            // Option, Result, List and Map start with a tag or a count
+            return false;
+        }
+    }
+
+    /// <summary>
+    /// Reads the element count of a List or Map and takes it from the
+    /// `elements` budget of the value. Each element of a type that takes up
+    /// at least one byte needs one of the remaining bytes, elements of other
+    /// types are limited to `max_zero_width`.
+    /// </summary>
+    static uint32_t ReadCount(ByteReader& reader, const CLTypeRVA& element_type, uint32_t max_zero_width,
+                              const std::string& type_name, size_t& elements)
+    {
+        uint32_t count = reader.ReadU32();
+        size_t limit = std::min<size_t>(IsZeroWidth(element_type) ? max_zero_width : reader.Remaining(), elements);
+        if (count > limit)
+        {
+            throw std::runtime_error("ParsedFromBytes: " + type_name + " of " + std::to_string(count) +
+                                     " elements, at most " + std::to_string(limit) + " fit");
+        }
+        elements -= count;
+        return count;
+    }
+
+    /// <summary>
+    /// Reads the `count` elements of a List of `element_type` into a
+    /// CLTypeParsedArray. Returns nothing, with the reader left where it was,
+    /// if the type can not be stored that way or a U128, U256 or U512 value
+    /// does not fit in 64 bits.
+    /// </summary>
+    std::optional<CLTypeParsedArray> ParsedArrayFromBytes(ByteReader& reader, CLTypeEnum element_type, uint32_t count)
+    {
+        size_t element_size = CLTypeParsedArray::ElementSize(element_type);
+        if (element_size == 0)
+        {
+            return std::nullopt;
+        }
+
+        CLTypeParsedArray array(element_type);
+        if (!CLTypeParsedArray::IsBigUnsigned(element_type))
+        {
+            // the bytesrepr of fixed width elements is already the array layout
+            auto bytes = reader.ReadBytes(static_cast<size_t>(count) * element_size);
+            if (element_type == CLTypeEnum::Bool)
+            {
+                std::for_each(bytes.begin(), bytes.end(), ReadBool);
+            }
+            array.Append(bytes);
+            return array;
+        }
+
+        ByteReader start = reader;
+        array.Reserve(std::min<size_t>(count, reader.Remaining()));
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint8_t size = reader.ReadByte();
+            if (size > sizeof(uint64_t))
             {
-                WriteByte(sb, 15);
-                WriteInteger(sb, inner_type_rva.begin()->second);
+                reader = start;
+                return std::nullopt;
             }
-            else
+
+            auto bytes = reader.ReadBytes(size);
+            uint64_t value = 0;
+            for (size_t b = size; b-- > 0;)
             {
-                throw std::runtime_error("Unknown type with idx:5 not bytearray");
+                value = (value << 8) | bytes[b];
             }
+            array.PushBack(value);
         }
+        return array;
+    }
+
+    /// <summary>
+    /// A Bool is serialized as 0 or 1, any other byte is malformed.
+    /// </summary>
+    static bool ReadBool(uint8_t byte)
+    {
+        if (byte > 1)
+        {
+            throw std::runtime_error("ParsedFromBytes: invalid Bool byte " + std::to_string(byte));
+        }
+        return byte == 1;
+    }
+
+    /// <summary>
+    /// The tag of an Option (1 = Some) or Result (1 = Ok), any byte above 1 is malformed.
+    /// </summary>
+    static bool ReadTag(ByteReader& reader, const std::string& type_name)
+    {
+        uint8_t tag = reader.ReadByte();
+        if (tag > 1)
+        {
+            throw std::runtime_error("ParsedFromBytes: invalid " + type_name + " tag " + std::to_string(tag));
+        }
+        return tag == 1;
+    }
+
+    /// <summary>
+    /// Reads a U128/U256/U512: one length byte and that many little-endian bytes.
+    /// </summary>
+    template <typename T>
+    T ReadBigUnsigned(ByteReader& reader)
+    {
+        uint8_t size = reader.ReadByte();
+        if (size > sizeof(T))
+        {
+            throw std::runtime_error("ParsedFromBytes: " + std::to_string(size) + " bytes do not fit in a " +
+                                     std::to_string(sizeof(T) * 8) + " bit integer");
+        }
+
+        auto bytes = reader.ReadBytes(size);
+        return bigUnsignedFromBytes<T>(bytes.data(), bytes.size());
     }
 };
 
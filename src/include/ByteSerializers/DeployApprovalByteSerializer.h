@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ByteSerializers/BaseByteSerializer.h"
+#include "ByteSerializers/ByteSizeCalculator.h"
 #include "Types/DeployApproval.h"
 
 namespace Casper
@@ -9,11 +10,38 @@ struct DeployApprovalByteSerializer : public BaseByteSerializer
 {
     CBytes ToBytes(const DeployApproval& source)
     {
-        CBytes bytes;
+        ByteWriter bytes(ByteSizeCalculator::SizeOf(source));
+        ToBytes(bytes, source);
+        return bytes.ToBytes();
+    }
+
+    void ToBytes(ByteSink& bytes, const DeployApproval& source)
+    {
         WriteBytes(bytes, source.signer.GetBytes());
         WriteBytes(bytes, source.signature.GetBytes());
-        return bytes;
+    }
+
+    DeployApproval FromBytes(std::span<const uint8_t> bytes)
+    {
+        ByteReader reader(bytes);
+        return FromBytes(reader);
+    }
+
+    DeployApproval FromBytes(ByteReader& reader)
+    {
+        PublicKey signer = ReadPublicKey(reader);
+
+        // both key algorithms produce 64 byte signatures
+        uint8_t algo = reader.ReadByte();
+        if (algo != KeyAlgo::ED25519 && algo != KeyAlgo::SECP256K1)
+        {
+            throw std::invalid_argument("Wrong signature algorithm identifier");
+        }
+        auto signature = reader.ReadBytes(64);
+
+        return DeployApproval(signer,
+                              Signature::FromRawBytes(ToCBytes(signature), static_cast<KeyAlgo::Value>(algo)));
     }
 };
 
-} // namespace Casper
\ No newline at end of file
+} // namespace Casper
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ByteSerializers/ByteSizeCalculator.h"
 #include "ByteSerializers/DeployApprovalByteSerializer.h"
 #include "ByteSerializers/ExecutableDeployItemByteSerializer.h"
 #include "Types/Deploy.h"
@@ -11,65 +12,112 @@ struct DeployByteSerializer : public BaseByteSerializer
 {
     CBytes ToBytes(const DeployHeader& source)
     {
-        CBytes bytes;
+        ByteWriter bytes(ByteSizeCalculator::SizeOf(source));
+        ToBytes(bytes, source);
+        return bytes.ToBytes();
+    }
 
+    void ToBytes(ByteSink& bytes, const DeployHeader& source)
+    {
         WriteBytes(bytes, source.account.GetBytes());
-        // std::cout << "acc:" << hexEncode(source.account.GetBytes()) << std::endl;
-        //  replace with source.timestamp
-        /*
-        std::chrono::milliseconds timestmp =
-            std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::system_clock::now().time_since_epoch());
-    */
+
         uint64_t ttp = strToTimestamp(source.timestamp);
         WriteULong(bytes, ttp);
-        // std::cout << "Timestamp " << ttp << std::endl;
-        // std::cout << "after Timestamp:" << hexEncode(bytes) << std::endl;
-        //  TODO: Create date util, use it with source.ttl
-        WriteULong(bytes, 1800000);
-        // std::cout << "after ttl:" << hexEncode(bytes) << std::endl;
+
+        WriteULong(bytes, strToDuration(source.ttl));
+
         WriteULong(bytes, source.gas_price);
-        // std::cout << "after gas price:" << hexEncode(bytes) << std::endl;
-        // std::cout << "body hash " << source.body_hash << std::endl;
-        WriteBytes(bytes, hexDecode(source.body_hash));
-        // std::cout << "after body hash:" << hexEncode(bytes) << std::endl;
+
+        WriteHash(bytes, source.body_hash);
+
         WriteInteger(bytes, source.dependencies.size());
         for (auto& dependency : source.dependencies)
         {
-            WriteBytes(bytes, hexDecode(dependency));
+            WriteHash(bytes, dependency);
         }
-        // std::cout << "after dependencies:" << hexEncode(bytes) << std::endl;
 
         WriteString(bytes, source.chain_name);
-        // std::cout << "after chain name:" << hexEncode(bytes) << std::endl;
-        return bytes;
     }
 
     CBytes ToBytes(const Deploy& source)
     {
-        CBytes bytes;
+        ByteWriter bytes(ByteSizeCalculator::SizeOf(source));
+        ToBytes(bytes, source);
+        return bytes.ToBytes();
+    }
 
+    void ToBytes(ByteSink& bytes, const Deploy& source)
+    {
         ExecutableDeployItemByteSerializer itemSerializer;
         DeployApprovalByteSerializer approvalSerializer;
 
-        WriteBytes(bytes, ToBytes(source.header));
+        ToBytes(bytes, source.header);
 
-        WriteBytes(bytes, hexDecode(source.hash));
+        WriteHash(bytes, source.hash);
 
-        WriteBytes(bytes, itemSerializer.ToBytes(source.payment));
+        itemSerializer.ToBytes(bytes, source.payment);
 
-        WriteBytes(bytes, itemSerializer.ToBytes(source.session));
+        itemSerializer.ToBytes(bytes, source.session);
 
         // add the approvals
         //
         WriteInteger(bytes, source.approvals.size());
         for (const auto& approval : source.approvals)
         {
-            WriteBytes(bytes, approvalSerializer.ToBytes(approval));
+            approvalSerializer.ToBytes(bytes, approval);
+        }
+    }
+
+    DeployHeader HeaderFromBytes(std::span<const uint8_t> bytes)
+    {
+        ByteReader reader(bytes);
+        return HeaderFromBytes(reader);
+    }
+
+    DeployHeader HeaderFromBytes(ByteReader& reader)
+    {
+        DeployHeader header;
+        header.account = ReadPublicKey(reader);
+        header.timestamp = timestampToStr(reader.ReadU64());
+        header.ttl = durationToStr(reader.ReadU64());
+        header.gas_price = reader.ReadU64();
+        header.body_hash = ReadHash(reader);
+
+        uint32_t count = reader.ReadU32();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            header.dependencies.push_back(ReadHash(reader));
+        }
+
+        header.chain_name = reader.ReadString();
+        return header;
+    }
+
+    Deploy FromBytes(std::span<const uint8_t> bytes)
+    {
+        ByteReader reader(bytes);
+        return FromBytes(reader);
+    }
+
+    Deploy FromBytes(ByteReader& reader)
+    {
+        ExecutableDeployItemByteSerializer itemSerializer;
+        DeployApprovalByteSerializer approvalSerializer;
+
+        Deploy deploy;
+        deploy.header = HeaderFromBytes(reader);
+        deploy.hash = ReadHash(reader);
+        deploy.payment = itemSerializer.FromBytes(reader);
+        deploy.session = itemSerializer.FromBytes(reader);
+
+        uint32_t count = reader.ReadU32();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            deploy.approvals.push_back(approvalSerializer.FromBytes(reader));
         }
 
-        return bytes;
+        return deploy;
     }
 };
 
-} // namespace Casper
\ No newline at end of file
+} // namespace Casper
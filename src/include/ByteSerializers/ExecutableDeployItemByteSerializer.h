@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ByteSerializers/BaseByteSerializer.h"
+#include "ByteSerializers/ByteSizeCalculator.h"
 #include "ByteSerializers/NamedArgByteSerializer.h"
 #include "Types/ExecutableDeployItem.h"
 
@@ -10,18 +11,20 @@ struct ExecutableDeployItemByteSerializer : public BaseByteSerializer
 {
     CBytes ToBytes(const ExecutableDeployItem& source)
     {
-        CBytes bytes;
-        NamedArgByteSerializer namedArgSerializer;
+        ByteWriter bytes(ByteSizeCalculator::SizeOf(source));
+        ToBytes(bytes, source);
+        return bytes.ToBytes();
+    }
 
+    void ToBytes(ByteSink& bytes, const ExecutableDeployItem& source)
+    {
         uint8_t source_tag = 0;
-        // std::cout << "ExecutableDeployItemByteSerializer: " << std::endl;
         if (source.module_bytes.has_value())
         {
-            // std::cout << "has module bytes" << std::endl;
             source_tag = 0;
             WriteByte(bytes, source_tag);
 
-            auto item = source.module_bytes.value();
+            const auto& item = source.module_bytes.value();
             if (item.module_bytes.size() == 0 || item.module_bytes.data() == nullptr)
             {
                 WriteInteger(bytes, 0);
@@ -32,51 +35,36 @@ struct ExecutableDeployItemByteSerializer : public BaseByteSerializer
                 WriteBytes(bytes, item.module_bytes);
             }
 
-            bytes += hexDecode(u32Encode(item.args.size()));
-            for (auto arg : item.args)
-            {
-                WriteBytes(bytes, namedArgSerializer.ToBytes(arg));
-            }
+            WriteArgs(bytes, item.args);
         }
         else if (source.stored_contract_by_hash.has_value())
         {
-            // std::cout << "has stored contract by hash" << std::endl;
             source_tag = 1;
             WriteByte(bytes, source_tag);
 
-            auto item = source.stored_contract_by_hash.value();
+            const auto& item = source.stored_contract_by_hash.value();
             WriteBytes(bytes, hexDecode(item.hash));
             WriteString(bytes, item.entry_point);
 
-            bytes += hexDecode(u32Encode(item.args.size()));
-            for (auto arg : item.args)
-            {
-                WriteBytes(bytes, namedArgSerializer.ToBytes(arg));
-            }
+            WriteArgs(bytes, item.args);
         }
         else if (source.stored_contract_by_name.has_value())
         {
-            // std::cout << "has stored contract by name" << std::endl;
             source_tag = 2;
             WriteByte(bytes, source_tag);
 
-            auto item = source.stored_contract_by_name.value();
+            const auto& item = source.stored_contract_by_name.value();
             WriteString(bytes, item.name);
             WriteString(bytes, item.entry_point);
 
-            bytes += hexDecode(u32Encode(item.args.size()));
-            for (auto arg : item.args)
-            {
-                WriteBytes(bytes, namedArgSerializer.ToBytes(arg));
-            }
+            WriteArgs(bytes, item.args);
         }
         else if (source.stored_versioned_contract_by_hash.has_value())
         {
-            // std::cout << "has stored versioned contract by hash" << std::endl;
             source_tag = 3;
             WriteByte(bytes, source_tag);
 
-            auto item = source.stored_versioned_contract_by_hash.value();
+            const auto& item = source.stored_versioned_contract_by_hash.value();
             WriteBytes(bytes, CryptoUtil::hexDecode(item.hash));
 
             if (item.version.has_value())
@@ -91,19 +79,14 @@ struct ExecutableDeployItemByteSerializer : public BaseByteSerializer
 
             WriteString(bytes, item.entry_point);
 
-            bytes += hexDecode(u32Encode(item.args.size()));
-            for (auto arg : item.args)
-            {
-                WriteBytes(bytes, namedArgSerializer.ToBytes(arg));
-            }
+            WriteArgs(bytes, item.args);
         }
         else if (source.stored_versioned_contract_by_name.has_value())
         {
-            // std::cout << "has stored versioned contract by name" << std::endl;
             source_tag = 4;
             WriteByte(bytes, source_tag);
 
-            auto item = source.stored_versioned_contract_by_name.value();
+            const auto& item = source.stored_versioned_contract_by_name.value();
             WriteString(bytes, item.name);
 
             if (item.version.has_value())
@@ -118,46 +101,125 @@ struct ExecutableDeployItemByteSerializer : public BaseByteSerializer
 
             WriteString(bytes, item.entry_point);
 
-            bytes += hexDecode(u32Encode(item.args.size()));
-            for (auto arg : item.args)
-            {
-                WriteBytes(bytes, namedArgSerializer.ToBytes(arg));
-            }
+            WriteArgs(bytes, item.args);
         }
         else if (source.transfer.has_value())
         {
-            // std::cout << "has transfer" << std::endl;
             source_tag = 5;
             WriteByte(bytes, source_tag);
 
-            // std::cout << "after tag" << std::endl;
-            TransferDeployItem item = source.transfer.value();
-
-            bytes += hexDecode(u32Encode(item.args.size()));
-
-            // std::cout << "after bytes write" << std::endl;
-            // std::cout << "args size: " << item.args.size() << std::endl;
-
-            for (NamedArg arg : item.args)
-            {
-                // std::cout << "arg loop in transfer" << std::endl;
-                // nlohmann::json j;
-                // to_json(j, arg);
-                // std::cout << j.dump(2) << std::endl;
-                WriteBytes(bytes, namedArgSerializer.ToBytes(arg));
-                // std::cout << "after bytes write" << std::endl;
-            }
+            WriteArgs(bytes, source.transfer.value().args);
         }
         else
         {
             nlohmann::json j;
-            // std::cout << "before source\n";
             to_json(j, source);
             throw std::runtime_error("Unsupported ExecutableDeployItem type: " + j.dump(2));
         }
-        // std::cout << "before executableserializer return" << std::endl;
-        return bytes;
+    }
+
+    ExecutableDeployItem FromBytes(std::span<const uint8_t> bytes)
+    {
+        ByteReader reader(bytes);
+        return FromBytes(reader);
+    }
+
+    ExecutableDeployItem FromBytes(ByteReader& reader)
+    {
+        uint8_t source_tag = reader.ReadByte();
+        switch (source_tag)
+        {
+        case 0:
+        {
+            ModuleBytes item;
+            item.module_bytes = ToCBytes(reader.ReadSizedBytes());
+            item.args = ReadArgs(reader);
+            return item;
+        }
+        case 1:
+        {
+            StoredContractByHash item;
+            item.hash = hexEncode(ToCBytes(reader.ReadBytes(32)));
+            item.entry_point = reader.ReadString();
+            item.args = ReadArgs(reader);
+            return item;
+        }
+        case 2:
+        {
+            StoredContractByName item;
+            item.name = reader.ReadString();
+            item.entry_point = reader.ReadString();
+            item.args = ReadArgs(reader);
+            return item;
+        }
+        case 3:
+        {
+            StoredVersionedContractByHash item;
+            item.hash = hexEncode(ToCBytes(reader.ReadBytes(32)));
+            item.version = ReadVersion(reader);
+            item.entry_point = reader.ReadString();
+            item.args = ReadArgs(reader);
+            return item;
+        }
+        case 4:
+        {
+            StoredVersionedContractByName item;
+            item.name = reader.ReadString();
+            item.version = ReadVersion(reader);
+            item.entry_point = reader.ReadString();
+            item.args = ReadArgs(reader);
+            return item;
+        }
+        case 5:
+        {
+            TransferDeployItem item;
+            item.args = ReadArgs(reader);
+            return item;
+        }
+        default:
+            throw std::runtime_error("Unsupported ExecutableDeployItem tag: " + std::to_string(source_tag));
+        }
+    }
+
+private:
+    void WriteArgs(ByteSink& bytes, const std::vector<NamedArg>& args)
+    {
+        NamedArgByteSerializer namedArgSerializer;
+
+        WriteUInteger(bytes, args.size());
+        for (const auto& arg : args)
+        {
+            namedArgSerializer.ToBytes(bytes, arg);
+        }
+    }
+
+    std::vector<NamedArg> ReadArgs(ByteReader& reader)
+    {
+        NamedArgByteSerializer namedArgSerializer;
+
+        std::vector<NamedArg> args;
+        uint32_t count = reader.ReadU32();
+        args.reserve(std::min<size_t>(count, reader.Remaining()));
+        for (uint32_t i = 0; i < count; i++)
+        {
+            args.push_back(namedArgSerializer.FromBytes(reader));
+        }
+        return args;
+    }
+
+    std::optional<uint32_t> ReadVersion(ByteReader& reader)
+    {
+        uint8_t tag = reader.ReadByte();
+        if (tag > 1)
+        {
+            throw std::runtime_error("Invalid Option tag of the version: " + std::to_string(tag));
+        }
+        if (tag == 0)
+        {
+            return std::nullopt;
+        }
+        return reader.ReadU32();
     }
 };
 
-} // namespace Casper
\ No newline at end of file
+} // namespace Casper
@@ -9,20 +9,53 @@ struct GlobalStateKeyByteSerializer : public BaseByteSerializer
 {
     CBytes ToBytes(const GlobalStateKey& source)
     {
-        CBytes bytes;
+        ByteWriter bytes;
+        ToBytes(bytes, source);
+        return bytes.ToBytes();
+    }
 
-        WriteByte(bytes, (CryptoPP::byte)source.key_identifier);
+    void ToBytes(ByteSink& bytes, const GlobalStateKey& source)
+    {
+        WriteByte(bytes, static_cast<uint8_t>(source.key_identifier));
 
-        WriteBytes(bytes, source.raw_bytes);
+        bytes.WriteBytes(source.payload.data(), source.PayloadSize());
 
-        if (source.ToString().find("uref-") != std::string::npos)
+        if (source.key_identifier == KeyIdentifier::URef)
         {
-            URef uref(source.ToString());
-            WriteByte(bytes, (CryptoPP::byte)uref.access_rights);
+            WriteByte(bytes, static_cast<uint8_t>(source.access_rights));
         }
+    }
 
-        return bytes;
+    GlobalStateKey FromBytes(std::span<const uint8_t> bytes)
+    {
+        ByteReader reader(bytes);
+        return FromBytes(reader);
+    }
+
+    GlobalStateKey FromBytes(ByteReader& reader)
+    {
+        uint8_t identifier = reader.ReadByte();
+        if (identifier > static_cast<uint8_t>(KeyIdentifier::Dictionary))
+        {
+            throw std::invalid_argument("Key not valid. Unknown key identifier.");
+        }
+
+        GlobalStateKey key;
+        key.key_identifier = static_cast<KeyIdentifier>(identifier);
+        auto payload = reader.ReadBytes(key.PayloadSize());
+        std::copy(payload.begin(), payload.end(), key.payload.begin());
+
+        if (key.key_identifier == KeyIdentifier::URef)
+        {
+            uint8_t rights = reader.ReadByte();
+            if (rights > static_cast<uint8_t>(AccessRights::READ_ADD_WRITE))
+            {
+                throw std::invalid_argument("Key not valid. Invalid access rights.");
+            }
+            key.access_rights = static_cast<AccessRights>(rights);
+        }
+        return key;
     }
 };
 
-} // namespace Casper
\ No newline at end of file
+} // namespace Casper
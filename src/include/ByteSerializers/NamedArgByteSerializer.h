@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ByteSerializers/BaseByteSerializer.h"
+#include "ByteSerializers/ByteSizeCalculator.h"
 #include "ByteSerializers/CLValueByteSerializer.h"
 #include "Types/NamedArg.h"
 #include "Utils/StringUtil.h"
@@ -10,22 +11,32 @@ struct NamedArgByteSerializer : public BaseByteSerializer
 {
     CBytes ToBytes(const NamedArg& source)
     {
-        CBytes bytes;
-        // std::cout << "NamedArgByteSerializer: " << std::endl;
-        CBytes bName = hexDecode(StringUtil::getStringBytesWithoutLength(source.name));
-        // std::cout << "before write integer len:" << bName.size() << std::endl;
-        WriteInteger(bytes, bName.size());
-        WriteBytes(bytes, bName);
+        ByteWriter bytes(ByteSizeCalculator::SizeOf(source));
+        ToBytes(bytes, source);
+        return bytes.ToBytes();
+    }
+
+    void ToBytes(ByteSink& bytes, const NamedArg& source)
+    {
+        WriteString(bytes, source.name);
+
+        CLValueByteSerializer valueSerializer;
+        valueSerializer.ToBytes(bytes, source.value);
+    }
+
+    NamedArg FromBytes(std::span<const uint8_t> bytes)
+    {
+        ByteReader reader(bytes);
+        return FromBytes(reader);
+    }
+
+    NamedArg FromBytes(ByteReader& reader)
+    {
+        std::string name(reader.ReadString());
 
-        // std::cout << "before write clvalue" << std::endl;
         CLValueByteSerializer valueSerializer;
-        // std::cout << source.name << std::endl;
-        // std::cout << hexEncode(valueSerializer.ToBytes(source.value)) <<
-        // std::endl;
-        WriteBytes(bytes, valueSerializer.ToBytes(source.value));
-        // std::cout << "after write clvalue" << std::endl;
-        return bytes;
+        return NamedArg(name, valueSerializer.FromBytes(reader));
     }
 };
 
-} // namespace Casper
\ No newline at end of file
+} // namespace Casper
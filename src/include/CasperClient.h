@@ -1,10 +1,15 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include <string>
 
 // http connection
+#include "JsonRpc/AsyncCall.h"
+#include "JsonRpc/Connection/EndpointRouter.h"
 #include "JsonRpc/Connection/HttpLibConnector.h"
+#include "JsonRpc/RpcBatch.h"
+#include "JsonRpc/RpcExecutor.h"
 
 // json rpc result types
 #include "JsonRpc/ResultTypes/GetAuctionInfoResult.h"
@@ -35,6 +40,7 @@
 #include "Utils/LogConfigurator.h"
 
 // external libraries
+#include "jsonrpccxx/batchclient.hpp"
 #include "jsonrpccxx/client.hpp"
 #include "magic_enum/magic_enum.hpp"
 #include "nlohmann/json.hpp"
@@ -47,9 +53,33 @@ namespace Casper
 class Client
 {
 private:
-    std::string mAddress;
-    HttpLibConnector mHttpConnector;
-    jsonrpccxx::JsonRpcClient mRpcClient;
+    EndpointRouter mRouter;
+    jsonrpccxx::BatchClient mRpcClient;
+    std::unique_ptr<RpcExecutor> mExecutor;
+
+    /// Sends calls [begin, end) of a batch one request per call and stores
+    /// their results.
+    void ExecuteOneByOne(RpcBatch& batch, size_t begin, size_t end);
+
+    /// The result of an asynchronous call converted to T. Never throws, a
+    /// result that can not be converted becomes an error, so that every call
+    /// completes.
+    template <typename T>
+    static BatchResult<T> ConvertResult(const BatchResult<nlohmann::json>& result)
+    {
+        if (!result.Ok())
+        {
+            return BatchResult<T>(*result.Error());
+        }
+        try
+        {
+            return BatchResult<T>::FromJson(result.Value());
+        }
+        catch (const std::exception& e)
+        {
+            return BatchResult<T>(jsonrpccxx::JsonRpcException(jsonrpccxx::internal_error, e.what()));
+        }
+    }
 
 public:
     /**
@@ -60,6 +90,107 @@ public:
      */
     Client(std::string address, const LogConfig* const log_config = nullptr);
 
+    /**
+     * @brief Construct a new Casper Client object with the given connection
+     * pool settings. A Client can be called from several threads at once, up
+     * to pool_config.max_connections requests are in flight together.
+     *
+     * @param address is a URL of the node like 'http://127.0.0.1:7777'. Default
+     * endpoint is '/rpc'.
+     * @param pool_config connection pool size and timeouts.
+     */
+    Client(std::string address, const ConnectionPoolConfig& pool_config, const LogConfig* const log_config = nullptr);
+
+    /**
+     * @brief Construct a new Casper Client object with the given connection
+     * pool and asynchronous call settings.
+     *
+     * @param address is a URL of the node like 'http://127.0.0.1:7777'. Default
+     * endpoint is '/rpc'.
+     * @param pool_config connection pool size and timeouts.
+     * @param async_config threads and batch size of the asynchronous calls.
+     */
+    Client(std::string address, const ConnectionPoolConfig& pool_config, const AsyncConfig& async_config,
+           const LogConfig* const log_config = nullptr);
+
+    /**
+     * @brief Construct a new Casper Client object that spreads its calls over
+     * several nodes, see EndpointRouter.
+     *
+     * @param addresses URLs of the nodes like 'http://127.0.0.1:7777'.
+     * @param router_config latency and error tracking, probes and height
+     * pinning.
+     * @param async_config threads and batch size of the asynchronous calls.
+     */
+    Client(const std::vector<std::string>& addresses, const EndpointRouterConfig& router_config,
+           const AsyncConfig& async_config = {}, const LogConfig* const log_config = nullptr);
+
+    /**
+     * @brief Queues an rpc call, sent by the executor threads together with
+     * the other queued calls. Returns at once.
+     *
+     * @param method name of the rpc method, e.g. "chain_get_block".
+     * @param params named parameters of the call.
+     * @return AsyncCall<T> to wait for, co_await or cancel the call.
+     */
+    template <typename T>
+    AsyncCall<T> CallAsync(std::string method, nlohmann::json params = nlohmann::json::object())
+    {
+        auto state = std::make_shared<typename AsyncCall<T>::State>();
+        AsyncCall<T> call(*mExecutor, state);
+        call._id = mExecutor->Submit(std::move(method), std::move(params),
+                                     [state](BatchResult<nlohmann::json> result)
+                                     { state->Complete(ConvertResult<T>(result)); });
+        return call;
+    }
+
+    /**
+     * @brief Queues an rpc call whose result is passed to a callback, on an
+     * executor thread. Returns at once.
+     *
+     * @param method name of the rpc method, e.g. "chain_get_block".
+     * @param params named parameters of the call.
+     * @param callback receives the result or error.
+     * @return uint64_t id of the call, for CancelAsync().
+     */
+    template <typename T>
+    uint64_t CallAsync(std::string method, nlohmann::json params, AsyncCallback<T> callback)
+    {
+        return mExecutor->Submit(std::move(method), std::move(params),
+                                 [callback = std::move(callback)](BatchResult<nlohmann::json> result)
+                                 { callback(ConvertResult<T>(result)); });
+    }
+
+    /**
+     * @brief Cancels an asynchronous call, it completes with an RPC_CANCELLED
+     * error.
+     *
+     * @param id id of the call.
+     * @return true if the call was cancelled, false if it had already
+     * completed.
+     */
+    bool CancelAsync(uint64_t id);
+
+    /**
+     * @brief Asynchronous calls queued or in flight.
+     */
+    size_t GetPendingAsyncCalls() const;
+
+    /**
+     * @brief Returns the counters of the connection pool, summed over the
+     * nodes.
+     *
+     * @return ConnectionPoolStats with the open, idle and in use connections.
+     */
+    ConnectionPoolStats GetConnectionStats() const;
+
+    /**
+     * @brief Returns the latency, error rate and health of each node.
+     *
+     * @return std::vector<EndpointStats> in the order of the addresses.
+     */
+    std::vector<EndpointStats> GetEndpointStats() const;
+
     /**
      * @brief Get a list of the nodes.
      *
@@ -86,6 +217,15 @@ public:
      */
     GetStateRootHashResult GetStateRootHash(uint64_t block_height);
 
+    /**
+     * @brief Asynchronous GetStateRootHash().
+     *
+     * @param block_hash Block hash string of the node. Use empty string to get
+     * the state root hash of the latest block.
+     */
+    AsyncCall<GetStateRootHashResult> GetStateRootHashAsync(const std::string& block_hash = "");
+    uint64_t GetStateRootHashAsync(const std::string& block_hash, AsyncCallback<GetStateRootHashResult> callback);
+
     /**
      * @brief Returns the deploy info.
      *
@@ -95,6 +235,24 @@ public:
      */
     GetDeployInfoResult GetDeployInfo(const std::string& deploy_hash, int counter = 0);
 
+    /**
+     * @brief Asynchronous GetDeployInfo().
+     *
+     * @param deploy_hash Hash string of the deploy.
+     */
+    AsyncCall<GetDeployInfoResult> GetDeployInfoAsync(const std::string& deploy_hash);
+    uint64_t GetDeployInfoAsync(const std::string& deploy_hash, AsyncCallback<GetDeployInfoResult> callback);
+
+    /**
+     * @brief Returns the info of many deploys, sent as JSON-RPC batches.
+     *
+     * @param deploy_hashes Hash strings of the deploys.
+     * @param max_batch_size Most calls sent in one request.
+     * @return One GetDeployInfoResult or error per hash, in the same order.
+     */
+    std::vector<BatchResult<GetDeployInfoResult>> GetDeployInfos(const std::vector<std::string>& deploy_hashes,
+                                                                 size_t max_batch_size = RpcBatch::DEFAULT_MAX_SIZE);
+
     /**
      * @brief Returns the status info.
      *
@@ -132,6 +290,23 @@ public:
      */
     GetBlockResult GetBlock(uint64_t block_height);
 
+    /**
+     * @brief Asynchronous GetBlock().
+     * @param block_height The height of the block as a uint64_t.
+     */
+    AsyncCall<GetBlockResult> GetBlockAsync(uint64_t block_height);
+    uint64_t GetBlockAsync(uint64_t block_height, AsyncCallback<GetBlockResult> callback);
+
+    /**
+     * @brief Returns the blocks of a height range, sent as JSON-RPC batches.
+     * @param first_height Height of the first block.
+     * @param last_height Height of the last block, included.
+     * @param max_batch_size Most calls sent in one request.
+     * @return One GetBlockResult or error per height, in height order.
+     */
+    std::vector<BatchResult<GetBlockResult>> GetBlocks(uint64_t first_height, uint64_t last_height,
+                                                       size_t max_batch_size = RpcBatch::DEFAULT_MAX_SIZE);
+
     /**
      * @brief Returns the era information.
      * @param block_hash Block hash string of the node. Use empty string to get
@@ -235,6 +410,40 @@ public:
      */
     GetBalanceResult GetAccountBalance(const std::string& purseURef, const std::string& stateRootHash);
 
+    /**
+     * @brief Asynchronous GetAccountBalance().
+     * @param purseURef The purse URef of the account as a string.
+     * @param stateRootHash The hash of the state root.
+     */
+    AsyncCall<GetBalanceResult> GetAccountBalanceAsync(const std::string& purseURef, const std::string& stateRootHash);
+    uint64_t GetAccountBalanceAsync(const std::string& purseURef, const std::string& stateRootHash,
+                                    AsyncCallback<GetBalanceResult> callback);
+
+    /**
+     * @brief Returns the balances of many purses, sent as JSON-RPC batches.
+     * @param purseURefs The purse URefs as strings.
+     * @param stateRootHash The hash of the state root.
+     * @param max_batch_size Most calls sent in one request.
+     * @return One GetBalanceResult or error per purse, in the same order.
+     */
+    std::vector<BatchResult<GetBalanceResult>> GetAccountBalances(const std::vector<std::string>& purseURefs,
+                                                                  const std::string& stateRootHash,
+                                                                  size_t max_batch_size = RpcBatch::DEFAULT_MAX_SIZE);
+
+    /**
+     * @brief Sends the queued calls of a batch as JSON-RPC 2.0 batch requests
+     * of at most max_batch_size calls each, and stores the result or error of
+     * every call in the batch. A request that fails as a whole fails each of
+     * its calls. A node answering a batch with a single method-not-found or
+     * invalid-request error, as nodes without batch support do, gets no more
+     * batches; when no node left takes them the calls are sent one request
+     * each instead.
+     *
+     * @param batch The queued calls.
+     * @param max_batch_size Most calls sent in one request.
+     */
+    void ExecuteBatch(RpcBatch& batch, size_t max_batch_size = RpcBatch::DEFAULT_MAX_SIZE);
+
     /**
      * @brief Get the Auction Info object
      *
@@ -268,6 +477,15 @@ public:
     QueryGlobalStateResult QueryGlobalState(GlobalStateKey key, const std::string& state_root_hash = "",
                                             const std::string& path = "");
 
+    /**
+     * @brief Asynchronous QueryGlobalState().
+     */
+    AsyncCall<QueryGlobalStateResult> QueryGlobalStateAsync(const std::string& key,
+                                                            const std::string& state_root_hash = "",
+                                                            const std::string& path = "");
+    uint64_t QueryGlobalStateAsync(const std::string& key, const std::string& state_root_hash, const std::string& path,
+                                   AsyncCallback<QueryGlobalStateResult> callback);
+
     QueryGlobalStateResult QueryGlobalStateWithBlockHash(const std::string& key, const std::string& block_hash,
                                                          const std::string& path = "");
 
@@ -0,0 +1,160 @@
+#pragma once
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "JsonRpc/RpcBatch.h"
+#include "JsonRpc/RpcExecutor.h"
+
+namespace Casper
+{
+/// Receives the result or error of an asynchronous call, on an executor
+/// thread. It must not block on another call, see AsyncCall.
+template <typename T>
+using AsyncCallback = std::function<void(BatchResult<T>)>;
+
+/**
+ * @brief Handle of an asynchronous call started by Client::CallAsync() or one
+ * of the Client::...Async() methods. The result is read with Get(), through a
+ * std::future, or with co_await in a C++20 coroutine, which is resumed on the
+ * executor thread that received the result. The handle must not be cancelled
+ * after the Client is destroyed.
+ *
+ * Until the coroutine suspends again or returns, that executor thread sends
+ * no other call. The coroutine should co_await further calls and not wait for
+ * them with Get(), Future().get() or a blocking Client method: with every
+ * executor thread blocked that way, the calls they wait for are never sent.
+ *
+ * @tparam T result type of the call.
+ */
+template <typename T>
+class AsyncCall
+{
+public:
+    /**
+     * @brief Id of the call, unique for its Client and sent as its JSON-RPC id.
+     */
+    uint64_t Id() const { return _id; }
+
+    /**
+     * @brief Cancels the call, it completes with an RPC_CANCELLED error.
+     *
+     * @return true if the call was cancelled, false if it had already
+     * completed.
+     */
+    bool Cancel() { return _executor->Cancel(_id); }
+
+    /**
+     * @brief True once the result or error has arrived.
+     */
+    bool Ready() const
+    {
+        std::lock_guard lock(_state->mutex);
+        return _state->result.has_value();
+    }
+
+    /**
+     * @brief Waits for the call and returns its result, throws its
+     * JsonRpcException if it failed.
+     */
+    T Get() const
+    {
+        std::unique_lock lock(_state->mutex);
+        _state->arrived.wait(lock, [this] { return _state->result.has_value(); });
+        return _state->result->Value();
+    }
+
+    /**
+     * @brief A std::future of the result. Only one future can be taken from a
+     * call.
+     */
+    std::future<T> Future()
+    {
+        std::lock_guard lock(_state->mutex);
+        _state->promise.emplace();
+        if (_state->result)
+        {
+            _state->Fulfil();
+        }
+        return _state->promise->get_future();
+    }
+
+    bool await_ready() const { return Ready(); }
+
+    /// Suspends the coroutine unless the result arrived in the meantime. It
+    /// is resumed on an executor thread and must not block it, see above.
+    bool await_suspend(std::coroutine_handle<> waiter)
+    {
+        std::lock_guard lock(_state->mutex);
+        if (_state->result)
+        {
+            return false;
+        }
+        _state->waiter = waiter;
+        return true;
+    }
+
+    T await_resume() const { return Get(); }
+
+private:
+    friend class Client;
+
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable arrived;
+        std::optional<BatchResult<T>> result;
+        std::optional<std::promise<T>> promise;
+        std::coroutine_handle<> waiter;
+
+        /// Sets the promise from the result, the caller holds mutex.
+        void Fulfil()
+        {
+            if (result->Ok())
+            {
+                promise->set_value(result->Value());
+            }
+            else
+            {
+                promise->set_exception(std::make_exception_ptr(*result->Error()));
+            }
+        }
+
+        void Complete(BatchResult<T> value)
+        {
+            std::coroutine_handle<> resume;
+            {
+                std::lock_guard lock(mutex);
+                result.emplace(std::move(value));
+                if (promise)
+                {
+                    Fulfil();
+                }
+                resume = std::exchange(waiter, nullptr);
+            }
+            arrived.notify_all();
+            if (resume)
+            {
+                resume.resume();
+            }
+        }
+    };
+
+    AsyncCall(RpcExecutor& executor, std::shared_ptr<State> state)
+        : _executor(&executor),
+          _state(std::move(state))
+    {
+    }
+
+    RpcExecutor* _executor;
+    std::shared_ptr<State> _state;
+    uint64_t _id = 0;
+};
+
+} // namespace Casper
@@ -0,0 +1,405 @@
+#include "JsonRpc/Connection/EndpointRouter.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "nlohmann/json.hpp"
+
+namespace Casper
+{
+namespace
+{
+const std::string kStatusRequest = R"({"id":0,"jsonrpc":"2.0","method":"info_get_status"})";
+
+double elapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Probes give up well before a request would, a stalled node must not hold
+/// the probe thread for long.
+ConnectionPoolConfig probePool(const EndpointRouterConfig& config)
+{
+    ConnectionPoolConfig pool = config.pool;
+    pool.max_connections = 1;
+    pool.connect_timeout = std::min(pool.connect_timeout, config.probe_interval);
+    pool.read_timeout = std::min(pool.read_timeout, config.probe_interval);
+    pool.write_timeout = std::min(pool.write_timeout, config.probe_interval);
+    return pool;
+}
+
+/// Runs a function when the scope is left, however it is left.
+template <typename F>
+class ScopeExit
+{
+public:
+    explicit ScopeExit(F f) : _f(std::move(f)) {}
+    ~ScopeExit() { _f(); }
+
+    ScopeExit(const ScopeExit&) = delete;
+    ScopeExit& operator=(const ScopeExit&) = delete;
+
+private:
+    F _f;
+};
+
+/// True if `call` is a request object for one of `methods`.
+bool callsOneOf(const nlohmann::json& call, const std::unordered_set<std::string>& methods)
+{
+    if (!call.is_object())
+    {
+        return false;
+    }
+    auto method = call.find("method");
+    return method != call.end() && method->is_string() && methods.count(method->get_ref<const std::string&>()) != 0;
+}
+
+/// True if the response to a batch is a single method-not-found or
+/// invalid-request error, what a node without batch support answers. Other
+/// single errors fail the batch but say nothing about the node.
+bool refusesBatch(const std::string& response)
+{
+    auto first = response.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos || response[first] != '{')
+    {
+        return false;
+    }
+    nlohmann::json parsed = nlohmann::json::parse(response, nullptr, false);
+    auto error = parsed.is_object() ? parsed.find("error") : parsed.end();
+    if (error == parsed.end() || !error->is_object())
+    {
+        return false;
+    }
+    auto code = error->find("code");
+    return code != error->end() && code->is_number_integer() &&
+           (*code == jsonrpccxx::method_not_found || *code == jsonrpccxx::invalid_request);
+}
+
+} // namespace
+
+EndpointRouter::EndpointRouter(const std::vector<std::string>& addresses, const EndpointRouterConfig& config)
+    : _config(config)
+{
+    if (addresses.empty())
+    {
+        throw std::invalid_argument("EndpointRouter: at least one address is required");
+    }
+    if (_config.ewma_weight <= 0 || _config.ewma_weight > 1)
+    {
+        throw std::invalid_argument("EndpointRouter: ewma_weight must be in (0, 1]");
+    }
+
+    ConnectionPoolConfig probe_pool = probePool(_config);
+    for (const auto& address : addresses)
+    {
+        _endpoints.push_back(std::make_unique<Endpoint>(address, _config.pool, probe_pool));
+    }
+
+    if (_config.pin_height_sensitive_calls)
+    {
+        std::lock_guard lock(_mutex);
+        StartProbing();
+    }
+}
+
+EndpointRouter::~EndpointRouter()
+{
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    if (_prober.joinable())
+    {
+        _prober.join();
+    }
+}
+
+std::string EndpointRouter::Send(const std::string& request)
+{
+    return *Route(request, false);
+}
+
+std::optional<std::string> EndpointRouter::SendBatch(const std::string& request)
+{
+    return Route(request, true);
+}
+
+std::optional<std::string> EndpointRouter::Route(const std::string& request, bool batch)
+{
+    bool height_sensitive = _config.pin_height_sensitive_calls && IsHeightSensitive(request);
+    size_t attempts = std::max<size_t>(_config.max_attempts, 1);
+
+    // nodes refusing a batch are skipped without counting as an attempt
+    size_t failures = 0;
+    std::vector<size_t> tried;
+    while (true)
+    {
+        size_t index;
+        {
+            std::lock_guard lock(_mutex);
+            index = Pick(height_sensitive, batch, tried);
+            if (index == _endpoints.size())
+            {
+                return std::nullopt;
+            }
+            _endpoints[index]->stats.in_flight++;
+        }
+        tried.push_back(index);
+        Endpoint& endpoint = *_endpoints[index];
+
+        // the node is released and the outcome recorded on every way out, a
+        // connector may throw more than JsonRpcException
+        bool ok = false;
+        bool refused = false;
+        double latency_ms = 0;
+        ScopeExit release(
+            [&]
+            {
+                std::lock_guard lock(_mutex);
+                endpoint.stats.in_flight--;
+                if (refused)
+                {
+                    endpoint.stats.batch_supported = false;
+                }
+                Record(endpoint, ok, latency_ms);
+            });
+
+        auto start = std::chrono::steady_clock::now();
+        try
+        {
+            std::string response = endpoint.connector.Send(request);
+            ok = true;
+            latency_ms = elapsedMs(start);
+            if (batch && refusesBatch(response))
+            {
+                refused = true;
+                continue;
+            }
+            return response;
+        }
+        catch (const jsonrpccxx::JsonRpcException&)
+        {
+            if (++failures >= attempts || tried.size() >= _endpoints.size())
+            {
+                throw;
+            }
+        }
+    }
+}
+
+std::vector<EndpointStats> EndpointRouter::Endpoints() const
+{
+    std::lock_guard lock(_mutex);
+    std::vector<EndpointStats> stats;
+    stats.reserve(_endpoints.size());
+    for (const auto& endpoint : _endpoints)
+    {
+        stats.push_back(endpoint->stats);
+    }
+    return stats;
+}
+
+ConnectionPoolStats EndpointRouter::PoolStats() const
+{
+    ConnectionPoolStats total;
+    for (const auto& endpoint : _endpoints)
+    {
+        ConnectionPoolStats stats = endpoint->connector.Stats();
+        total.open += stats.open;
+        total.idle += stats.idle;
+        total.in_use += stats.in_use;
+        total.requests += stats.requests;
+        total.created += stats.created;
+        total.reused += stats.reused;
+        total.evicted += stats.evicted;
+        total.failed += stats.failed;
+        total.waits += stats.waits;
+    }
+    return total;
+}
+
+size_t EndpointRouter::Pick(bool height_sensitive, bool batch, const std::vector<size_t>& tried) const
+{
+    std::optional<uint64_t> top;
+    if (height_sensitive)
+    {
+        for (const auto& endpoint : _endpoints)
+        {
+            if (endpoint->stats.healthy && endpoint->stats.height && (!top || *endpoint->stats.height > *top))
+            {
+                top = endpoint->stats.height;
+            }
+        }
+    }
+
+    // healthy and caught up, then healthy, then any node not tried yet
+    for (int pass = height_sensitive ? 0 : 1; pass < 3; pass++)
+    {
+        size_t best = _endpoints.size();
+        double best_score = std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < _endpoints.size(); i++)
+        {
+            const EndpointStats& stats = _endpoints[i]->stats;
+            if (std::find(tried.begin(), tried.end(), i) != tried.end())
+            {
+                continue;
+            }
+            if (batch && !stats.batch_supported)
+            {
+                continue;
+            }
+            if (pass < 2 && !stats.healthy)
+            {
+                continue;
+            }
+            if (pass == 0 && top && (!stats.height || *stats.height + _config.max_height_lag < *top))
+            {
+                continue;
+            }
+
+            double score = stats.latency_ms * static_cast<double>(stats.in_flight + 1);
+            if (!_endpoints[i]->measured)
+            {
+                // a node without samples yet is tried first, with one call
+                // at a time until its first response sets its latency
+                score = stats.in_flight == 0 ? 0 : std::numeric_limits<double>::max();
+            }
+            if (score < best_score)
+            {
+                best = i;
+                best_score = score;
+            }
+        }
+        if (best < _endpoints.size())
+        {
+            return best;
+        }
+    }
+
+    if (batch)
+    {
+        return _endpoints.size();
+    }
+
+    // not reached, Route() stops before every node was tried
+    throw std::logic_error("EndpointRouter: no node left to try");
+}
+
+bool EndpointRouter::IsHeightSensitive(std::string_view request) const
+{
+    // a request that does not parse fails on the node, wherever it goes
+    nlohmann::json parsed = nlohmann::json::parse(request, nullptr, false);
+    if (parsed.is_array())
+    {
+        return std::any_of(parsed.begin(), parsed.end(), [this](const nlohmann::json& call)
+                           { return callsOneOf(call, _config.height_sensitive_methods); });
+    }
+    return callsOneOf(parsed, _config.height_sensitive_methods);
+}
+
+void EndpointRouter::Record(Endpoint& endpoint, bool ok, double latency_ms)
+{
+    endpoint.stats.requests++;
+    if (!ok)
+    {
+        endpoint.stats.failures++;
+    }
+    Rate(endpoint, ok, latency_ms);
+}
+
+void EndpointRouter::Rate(Endpoint& endpoint, bool ok, double latency_ms)
+{
+    EndpointStats& stats = endpoint.stats;
+    double weight = _config.ewma_weight;
+
+    if (ok)
+    {
+        stats.latency_ms = endpoint.measured ? (1 - weight) * stats.latency_ms + weight * latency_ms : latency_ms;
+        endpoint.measured = true;
+        stats.error_rate *= 1 - weight;
+        return;
+    }
+
+    stats.error_rate = (1 - weight) * stats.error_rate + weight;
+    if (stats.healthy && stats.error_rate > _config.max_error_rate)
+    {
+        stats.healthy = false;
+        stats.ejections++;
+        StartProbing();
+    }
+}
+
+void EndpointRouter::StartProbing()
+{
+    if (!_prober.joinable())
+    {
+        _prober = std::thread([this] { Probe(); });
+    }
+}
+
+void EndpointRouter::Probe()
+{
+    std::unique_lock lock(_mutex);
+    while (!_stopping)
+    {
+        std::vector<Endpoint*> targets;
+        for (const auto& endpoint : _endpoints)
+        {
+            if (!endpoint->stats.healthy || _config.pin_height_sensitive_calls)
+            {
+                targets.push_back(endpoint.get());
+            }
+        }
+
+        lock.unlock();
+        for (Endpoint* endpoint : targets)
+        {
+            std::optional<uint64_t> height;
+            bool ok = false;
+            try
+            {
+                auto status = nlohmann::json::parse(endpoint->prober.Send(kStatusRequest));
+                ok = status.contains("result");
+                auto info = status.value("result", nlohmann::json::object()).value("last_added_block_info",
+                                                                                   nlohmann::json::object());
+                if (info.contains("height"))
+                {
+                    height = info.at("height").get<uint64_t>();
+                }
+            }
+            catch (const std::exception&)
+            {
+                ok = false;
+            }
+
+            std::lock_guard relock(_mutex);
+            if (!ok)
+            {
+                if (endpoint->stats.healthy)
+                {
+                    Rate(*endpoint, false, 0);
+                }
+                continue;
+            }
+            if (height)
+            {
+                endpoint->stats.height = height;
+            }
+            if (!endpoint->stats.healthy)
+            {
+                // back in rotation with a clean slate
+                endpoint->stats.healthy = true;
+                endpoint->stats.error_rate = 0;
+                endpoint->measured = false;
+            }
+        }
+        lock.lock();
+
+        _wake.wait_for(lock, _config.probe_interval, [this] { return _stopping; });
+    }
+}
+
+} // namespace Casper
@@ -0,0 +1,207 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "JsonRpc/Connection/HttpLibConnector.h"
+#include "jsonrpccxx/iclientconnector.hpp"
+
+namespace Casper
+{
+/**
+ * @brief Settings of the routing of calls between several nodes.
+ *
+ */
+struct EndpointRouterConfig
+{
+    /// Connection pool of each node.
+    ConnectionPoolConfig pool;
+
+    /// Weight of the newest sample in the moving averages of latency and
+    /// error rate, between 0 and 1.
+    double ewma_weight = 0.3;
+
+    /// A node whose average error rate goes above this is ejected: it gets
+    /// no calls until a status probe succeeds.
+    double max_error_rate = 0.5;
+
+    /// Nodes a call is tried on when the request fails in transport.
+    size_t max_attempts = 2;
+
+    /// Time between two rounds of status probes.
+    std::chrono::milliseconds probe_interval{5000};
+
+    /// Sends the height sensitive calls only to nodes whose last block is
+    /// at most max_height_lag below the highest one seen. The heights come
+    /// from the status probes, which then go to every node.
+    bool pin_height_sensitive_calls = false;
+    uint64_t max_height_lag = 0;
+
+    /// Methods pinned to caught up nodes.
+    std::unordered_set<std::string> height_sensitive_methods = {"chain_get_block",
+                                                                "chain_get_block_transfers",
+                                                                "chain_get_state_root_hash",
+                                                                "chain_get_era_info_by_switch_block",
+                                                                "state_get_item",
+                                                                "state_get_balance",
+                                                                "state_get_dictionary_item",
+                                                                "state_get_auction_info",
+                                                                "query_global_state",
+                                                                "info_get_deploy"};
+};
+
+/**
+ * @brief State of one node, returned by EndpointRouter::Endpoints().
+ *
+ */
+struct EndpointStats
+{
+    std::string address;
+
+    /// False while the node is ejected.
+    bool healthy = true;
+
+    /// Moving averages of the request latency and of the transport errors,
+    /// the errors include failed status probes.
+    double latency_ms = 0;
+    double error_rate = 0;
+
+    /// Requests sent and failed, status probes are not counted.
+    uint64_t requests = 0;
+    uint64_t failures = 0;
+    uint64_t ejections = 0;
+    size_t in_flight = 0;
+
+    /// Height of the last block of the node, from its last status probe.
+    std::optional<uint64_t> height;
+
+    /// False once the node answered a batch with a single method-not-found
+    /// or invalid-request error, it gets no more batches.
+    bool batch_supported = true;
+};
+
+/**
+ * @brief Connector that spreads the calls of one Client over several nodes.
+ * Each call goes to the healthy node with the lowest average latency,
+ * weighted by the calls it already has in flight. Nodes failing in transport
+ * are ejected and probed with "info_get_status" in the background until they
+ * answer again. A request that fails in transport is retried on the next
+ * best node.
+ *
+ */
+class EndpointRouter : public jsonrpccxx::IClientConnector
+{
+public:
+    /**
+     * @brief Construct a new Endpoint Router object.
+     *
+     * @param addresses URLs of the nodes like 'http://127.0.0.1:7777'.
+     * @param config routing and probing settings.
+     */
+    explicit EndpointRouter(const std::vector<std::string>& addresses, const EndpointRouterConfig& config = {});
+
+    /**
+     * @brief Stops the background probes.
+     */
+    ~EndpointRouter();
+
+    EndpointRouter(const EndpointRouter&) = delete;
+    EndpointRouter& operator=(const EndpointRouter&) = delete;
+
+    /**
+     * @brief Send the request to the best node for it.
+     *
+     * @param request
+     * @return std::string
+     */
+    std::string Send(const std::string& request) override;
+
+    /**
+     * @brief Send a JSON-RPC batch to the best node that takes batches. A node
+     * answering it with a single method-not-found or invalid-request error is
+     * marked as without batch support, and the batch goes to the next node.
+     *
+     * @param request the batch, a JSON array of calls.
+     * @return std::optional<std::string> the response, or nothing if no node
+     * left takes batches and the calls have to be sent one by one.
+     */
+    std::optional<std::string> SendBatch(const std::string& request);
+
+    /**
+     * @brief State of every node, in the order they were given.
+     *
+     * @return std::vector<EndpointStats>
+     */
+    std::vector<EndpointStats> Endpoints() const;
+
+    /**
+     * @brief Connection pool counters summed over all nodes.
+     *
+     * @return ConnectionPoolStats
+     */
+    ConnectionPoolStats PoolStats() const;
+
+private:
+    struct Endpoint
+    {
+        Endpoint(const std::string& address, const ConnectionPoolConfig& pool, const ConnectionPoolConfig& probe_pool)
+            : connector(address, pool),
+              prober(address, probe_pool)
+        {
+            stats.address = address;
+        }
+
+        HttpLibConnector connector;
+
+        /// Separate connection with short timeouts for the status probes.
+        HttpLibConnector prober;
+
+        EndpointStats stats;
+        bool measured = false;
+    };
+
+    /// Sends the request, and for a batch moves on from the nodes refusing
+    /// it. Returns nothing for a batch no node left takes.
+    std::optional<std::string> Route(const std::string& request, bool batch);
+
+    /// Best node for the request not in `tried`, skipping the nodes without
+    /// batch support for a batch. Returns _endpoints.size() if no node is
+    /// left for a batch. The caller holds _mutex.
+    size_t Pick(bool height_sensitive, bool batch, const std::vector<size_t>& tried) const;
+
+    /// True if the request, or a call of the batch, is for one of the height
+    /// sensitive methods.
+    bool IsHeightSensitive(std::string_view request) const;
+
+    /// Counts a request and updates the averages, the caller holds _mutex.
+    void Record(Endpoint& endpoint, bool ok, double latency_ms);
+
+    /// Updates the averages and ejects a node failing too often, without
+    /// counting a request. Also used for failed probes. The caller holds
+    /// _mutex.
+    void Rate(Endpoint& endpoint, bool ok, double latency_ms);
+
+    /// Loop of the probe thread.
+    void Probe();
+
+    /// Starts the probe thread if it is not running, the caller holds _mutex.
+    void StartProbing();
+
+    EndpointRouterConfig _config;
+    std::vector<std::unique_ptr<Endpoint>> _endpoints;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _wake;
+    bool _stopping = false;
+    std::thread _prober;
+};
+
+} // namespace Casper
@@ -0,0 +1,166 @@
+#include "JsonRpc/Connection/HttpLibConnector.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Casper
+{
+HttpLibConnector::HttpLibConnector(const std::string& host, const ConnectionPoolConfig& config)
+    : _host(host),
+      _config(config)
+{
+    if (_config.max_connections == 0)
+    {
+        throw std::invalid_argument("HttpLibConnector: max_connections must be at least 1");
+    }
+}
+
+std::string HttpLibConnector::Send(const std::string& request)
+{
+    auto client = Checkout();
+    auto res = [&]
+    {
+        try
+        {
+            return client->Post("/rpc", request, "application/json");
+        }
+        catch (...)
+        {
+            Return(std::move(client), false);
+            throw;
+        }
+    }();
+
+    if (res == nullptr)
+    {
+        Return(std::move(client), false);
+        throw jsonrpccxx::JsonRpcException(-32003, "client connector error, result is Empty! error: " +
+                                                       httplib::to_string(res.error()));
+    }
+    Return(std::move(client), true);
+
+    if (res->status != 200)
+    {
+        throw jsonrpccxx::JsonRpcException(-32003, "client connector error, received status != 200, status: " +
+                                                       std::to_string(res->status) + ", reason: " + res->reason);
+    }
+
+    return std::move(res->body);
+}
+
+const std::string& HttpLibConnector::AcceptEncoding()
+{
+    static const std::string encodings = []
+    {
+        std::string list;
+#ifdef CPPHTTPLIB_BROTLI_SUPPORT
+        list += "br";
+#endif
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+        list += list.empty() ? "gzip, deflate" : ", gzip, deflate";
+#endif
+        return list;
+    }();
+    return encodings;
+}
+
+ConnectionPoolStats HttpLibConnector::Stats() const
+{
+    std::lock_guard lock(_mutex);
+    ConnectionPoolStats stats = _stats;
+    stats.open = _open;
+    stats.idle = _idle.size();
+    stats.in_use = _open - _idle.size();
+    return stats;
+}
+
+std::unique_ptr<httplib::Client> HttpLibConnector::Checkout()
+{
+    std::unique_lock lock(_mutex);
+    EvictIdle(std::chrono::steady_clock::now());
+    _stats.requests++;
+
+    if (_idle.empty() && _open >= _config.max_connections)
+    {
+        _stats.waits++;
+        _returned.wait(lock, [this] { return !_idle.empty() || _open < _config.max_connections; });
+    }
+
+    if (!_idle.empty())
+    {
+        auto client = std::move(_idle.back().client);
+        _idle.pop_back();
+        _stats.reused++;
+        return client;
+    }
+
+    _open++;
+    _stats.created++;
+    lock.unlock();
+
+    // the slot is taken, it must be given back if the client can not be made,
+    // e.g. for an unsupported scheme
+    try
+    {
+        // httplib connects on the first request, this does not block
+        auto client = std::make_unique<httplib::Client>(_host);
+        client->set_keep_alive(true);
+        // a kept-alive socket would otherwise hold the body back until the
+        // headers are acknowledged
+        client->set_tcp_nodelay(true);
+        client->set_connection_timeout(_config.connect_timeout);
+        client->set_read_timeout(_config.read_timeout);
+        client->set_write_timeout(_config.write_timeout);
+        if (_config.compression && !AcceptEncoding().empty())
+        {
+            // httplib inflates the body chunk by chunk as it is read
+            client->set_default_headers({{"Accept-Encoding", AcceptEncoding()}});
+        }
+        return client;
+    }
+    catch (...)
+    {
+        // no connection was made and no request sent, so neither is counted
+        lock.lock();
+        _open--;
+        _stats.created--;
+        _stats.requests--;
+        lock.unlock();
+        _returned.notify_one();
+        throw;
+    }
+}
+
+void HttpLibConnector::Return(std::unique_ptr<httplib::Client> client, bool reusable)
+{
+    {
+        std::lock_guard lock(_mutex);
+        if (reusable)
+        {
+            _idle.push_back({std::move(client), std::chrono::steady_clock::now()});
+        }
+        else
+        {
+            _open--;
+            _stats.failed++;
+        }
+    }
+    _returned.notify_one();
+}
+
+void HttpLibConnector::EvictIdle(std::chrono::steady_clock::time_point now)
+{
+    auto fresh = std::find_if(_idle.begin(), _idle.end(),
+                              [&](const IdleConnection& idle) { return now - idle.since < _config.idle_timeout; });
+    size_t expired = static_cast<size_t>(fresh - _idle.begin());
+    if (expired == 0)
+    {
+        return;
+    }
+
+    _idle.erase(_idle.begin(), fresh);
+    _open -= expired;
+    _stats.evicted += expired;
+}
+
+} // namespace Casper
@@ -1,29 +1,87 @@
 #pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "JsonRpc/Connection/httplib.h"
 #include "jsonrpccxx/iclientconnector.hpp"
 #include "jsonrpccxx/server.hpp"
 
+namespace Casper
+{
 /**
- * @brief Wrapper class for the Http Client Connection class in jsonrpccxx.
+ * @brief Settings of the connection pool behind HttpLibConnector.
  *
  */
-namespace Casper
+struct ConnectionPoolConfig
 {
+    /// Most connections open at once, further callers wait for one to be
+    /// returned to the pool.
+    size_t max_connections = 8;
+
+    /// Pooled connections unused for this long are closed.
+    std::chrono::milliseconds idle_timeout{30000};
+
+    std::chrono::milliseconds connect_timeout{5000};
+    std::chrono::milliseconds read_timeout{30000};
+    std::chrono::milliseconds write_timeout{30000};
+
+    /// Asks the node for compressed responses, in the encodings httplib.h is
+    /// built with (see HttpLibConnector::AcceptEncoding()). Has no effect
+    /// when it is built with none.
+    bool compression = true;
+};
+
+/**
+ * @brief Counters of the connection pool, returned by HttpLibConnector::Stats().
+ *
+ */
+struct ConnectionPoolStats
+{
+    /// Connections open now, idle in the pool or checked out by a request.
+    size_t open = 0;
+    size_t idle = 0;
+    size_t in_use = 0;
+
+    /// Requests sent since the connector was created.
+    uint64_t requests = 0;
+
+    /// Connections opened, and requests that took an already open one.
+    uint64_t created = 0;
+    uint64_t reused = 0;
+
+    /// Idle connections closed after idle_timeout.
+    uint64_t evicted = 0;
+
+    /// Requests without a response, their connection is closed.
+    uint64_t failed = 0;
+
+    /// Requests that waited because max_connections were in use.
+    uint64_t waits = 0;
+};
+
+/**
+ * @brief Wrapper class for the Http Client Connection class in jsonrpccxx.
+ * Requests are sent over a bounded pool of keep-alive connections, each
+ * request checks one out for its duration, so one connector (and the
+ * Casper::Client using it) can be called from many threads at once.
+ *
+ */
 class HttpLibConnector : public jsonrpccxx::IClientConnector
 {
 public:
     /**
      * @brief Construct a new Http Lib Connector object. Explicit to prevent
-     * implicit conversion.
+     * implicit conversion. No connection is opened until the first request.
      *
      * @param host
+     * @param config pool size and timeouts.
      */
-    explicit HttpLibConnector(const std::string& host)
-        : httpClient(host.c_str())
-    {
-    }
+    explicit HttpLibConnector(const std::string& host, const ConnectionPoolConfig& config = {});
 
     /**
      * @brief Send the request to the server via the Http Client Connection class.
@@ -31,26 +89,52 @@ public:
      * @param request
      * @return std::string
      */
-    std::string Send(const std::string& request) override
+    std::string Send(const std::string& request) override;
+
+    /**
+     * @brief Current pool counters.
+     *
+     * @return ConnectionPoolStats
+     */
+    ConnectionPoolStats Stats() const;
+
+    /**
+     * @brief Value of the Accept-Encoding header sent when compression is on:
+     * "br" with CPPHTTPLIB_BROTLI_SUPPORT, "gzip, deflate" with
+     * CPPHTTPLIB_ZLIB_SUPPORT, empty without either.
+     *
+     * @return const std::string&
+     */
+    static const std::string& AcceptEncoding();
+
+private:
+    struct IdleConnection
     {
+        std::unique_ptr<httplib::Client> client;
+        std::chrono::steady_clock::time_point since;
+    };
 
-        auto res = httpClient.Post("/rpc", request, "application/json");
+    /// Takes an idle connection, or opens one if fewer than max_connections
+    /// are open, or waits for one to be returned.
+    std::unique_ptr<httplib::Client> Checkout();
 
-        if (res == nullptr)
-        {
-            throw jsonrpccxx::JsonRpcException(-32003, "client connector error, result is Empty!");
-        }
-        else if (res->status != 200)
-        {
-            throw jsonrpccxx::JsonRpcException(-32003, "client connector error, received status != 200, status: " +
-                                                           std::to_string(res->status) + ", reason: " + res->reason);
-        }
+    /// Puts a connection back in the pool, or closes it if it failed.
+    void Return(std::unique_ptr<httplib::Client> client, bool reusable);
 
-        return res->body;
-    }
+    /// Closes the connections idle for longer than idle_timeout, the caller
+    /// holds _mutex.
+    void EvictIdle(std::chrono::steady_clock::time_point now);
 
-private:
-    /// httplib::Client object to send the request to the server as an RPC call.
-    httplib::Client httpClient;
+    std::string _host;
+    ConnectionPoolConfig _config;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _returned;
+
+    /// Oldest first, requests take the most recently used connection so the
+    /// ones at the front are left to expire when the load drops.
+    std::vector<IdleConnection> _idle;
+    size_t _open = 0;
+    ConnectionPoolStats _stats;
 };
 } // namespace Casper
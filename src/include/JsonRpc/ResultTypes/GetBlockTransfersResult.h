@@ -2,6 +2,7 @@
 
 #include "Base.h"
 #include "JsonRpc/ResultTypes/RpcResult.h"
+#include "Types/Hash32.h"
 #include "Types/Transfer.h"
 
 namespace Casper
@@ -13,7 +14,7 @@ struct GetBlockTransfersResult : public RpcResult
     /// <summary>
     /// The block hash, if found.
     /// </summary>
-    std::optional<std::string> block_hash = std::nullopt;
+    std::optional<Hash32> block_hash = std::nullopt;
 
     /// <summary>
     /// The block's transfers, if found.
@@ -55,7 +56,7 @@ inline void from_json(const nlohmann::json& j, GetBlockTransfersResult& p)
     nlohmann::from_json(j, static_cast<RpcResult&>(p));
     if (j.find("block_hash") != j.end() && !j.at("block_hash").is_null())
     {
-        j.at("block_hash").get_to(p.block_hash);
+        p.block_hash = j.at("block_hash").get<Hash32>();
     }
 
     if (j.find("transfers") != j.end() && !j.at("transfers").is_null())
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RpcResult.h"
+#include "Types/Hash32.h"
 
 namespace Casper
 {
@@ -11,7 +12,7 @@ struct GetStateRootHashResult : public RpcResult
     /// <summary>
     /// Hex-encoded hash of the state root.
     /// </summary>
-    std::string state_root_hash;
+    Hash32 state_root_hash;
 
     GetStateRootHashResult() = default;
 };
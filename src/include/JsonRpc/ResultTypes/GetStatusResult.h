@@ -2,6 +2,7 @@
 
 #include "RpcResult.h"
 #include "Types/BlockInfo.h"
+#include "Types/Hash32.h"
 #include "Types/NextUpgrade.h"
 #include "Types/Peer.h"
 
@@ -19,7 +20,7 @@ struct GetStatusResult : public RpcResult
     /// <summary>
     /// The state root hash used at the start of the current session.
     /// </summary>
-    std::string starting_state_root_hash;
+    Hash32 starting_state_root_hash;
 
     /// <summary>
     /// The node ID and network address of each connected peer.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RpcResult.h"
+#include "Types/Hash32.h"
 
 namespace Casper
 {
@@ -11,7 +12,7 @@ struct PutDeployResult : public RpcResult
     /// <summary>
     /// The deploy hash.
     /// </summary>
-    std::string deploy_hash;
+    Hash32 deploy_hash;
 
     PutDeployResult() = default;
 };
@@ -3,6 +3,7 @@
 #include "Base.h"
 #include "JsonRpc/ResultTypes/RpcResult.h"
 #include "Types/ExecutionResult.h"
+#include "Types/Hash32.h"
 
 namespace Casper
 {
@@ -13,7 +14,7 @@ struct SpeculativeExecResult : public RpcResult
     /// <summary>
     /// The block hash
     /// </summary>
-    std::string block_hash;
+    Hash32 block_hash;
 
     /// <summary>
     /// Execution result.
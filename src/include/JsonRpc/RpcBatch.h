@@ -0,0 +1,150 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "jsonrpccxx/common.hpp"
+#include "nlohmann/json.hpp"
+
+namespace Casper
+{
+/**
+ * @brief Outcome of one call of a batch: its result, or the error the node
+ * returned for that call alone.
+ *
+ * @tparam T result type of the call.
+ */
+template <typename T>
+class BatchResult
+{
+public:
+    explicit BatchResult(T value)
+        : _value(std::move(value))
+    {
+    }
+
+    explicit BatchResult(jsonrpccxx::JsonRpcException error)
+        : _error(std::move(error))
+    {
+    }
+
+    /**
+     * @brief Converts the result of a call to T, a result of the wrong shape
+     * or with an invalid value (e.g. a malformed hash) becomes a parse_error.
+     */
+    static BatchResult FromJson(const nlohmann::json& result)
+    {
+        try
+        {
+            return BatchResult(result.get<T>());
+        }
+        catch (const std::exception& e)
+        {
+            return BatchResult(jsonrpccxx::JsonRpcException(jsonrpccxx::parse_error,
+                                                            "invalid return type: " + std::string(e.what())));
+        }
+    }
+
+    bool Ok() const { return _value.has_value(); }
+
+    /**
+     * @brief The result of the call. Throws the call's JsonRpcException if it
+     * failed.
+     */
+    const T& Value() const
+    {
+        if (!_value)
+        {
+            throw *_error;
+        }
+        return *_value;
+    }
+
+    /**
+     * @brief The error of the call, empty if it succeeded.
+     */
+    const std::optional<jsonrpccxx::JsonRpcException>& Error() const { return _error; }
+
+private:
+    std::optional<T> _value;
+    std::optional<jsonrpccxx::JsonRpcException> _error;
+};
+
+/**
+ * @brief Calls queued to be sent as JSON-RPC 2.0 batches by
+ * Client::ExecuteBatch(). Each call gets its index in the batch as its id,
+ * the results are read back by index once the batch has been executed.
+ *
+ */
+class RpcBatch
+{
+public:
+    /// Calls per request unless the caller sets another limit.
+    static constexpr size_t DEFAULT_MAX_SIZE = 100;
+
+    /**
+     * @brief Queues a call.
+     *
+     * @param method name of the rpc method, e.g. "chain_get_block".
+     * @param params named parameters of the call.
+     * @return size_t index of the call in the batch.
+     */
+    size_t Add(std::string method, nlohmann::json params = nlohmann::json::object())
+    {
+        _calls.push_back({std::move(method), std::move(params), nullptr, std::nullopt, false});
+        return _calls.size() - 1;
+    }
+
+    size_t Size() const { return _calls.size(); }
+
+    /**
+     * @brief Result of call `index` converted to T, or its error.
+     */
+    template <typename T>
+    BatchResult<T> Get(size_t index) const
+    {
+        const Call& call = _calls.at(index);
+        if (!call.done)
+        {
+            return BatchResult<T>(
+                jsonrpccxx::JsonRpcException(jsonrpccxx::internal_error, "the batch has not been executed"));
+        }
+        if (call.error)
+        {
+            return BatchResult<T>(*call.error);
+        }
+        return BatchResult<T>::FromJson(call.result);
+    }
+
+    /**
+     * @brief Results of all calls, in the order they were added.
+     */
+    template <typename T>
+    std::vector<BatchResult<T>> GetAll() const
+    {
+        std::vector<BatchResult<T>> results;
+        results.reserve(_calls.size());
+        for (size_t i = 0; i < _calls.size(); i++)
+        {
+            results.push_back(Get<T>(i));
+        }
+        return results;
+    }
+
+private:
+    friend class Client;
+
+    struct Call
+    {
+        std::string method;
+        nlohmann::json params;
+        nlohmann::json result;
+        std::optional<jsonrpccxx::JsonRpcException> error;
+        bool done;
+    };
+
+    std::vector<Call> _calls;
+};
+
+} // namespace Casper
@@ -0,0 +1,287 @@
+#include "JsonRpc/RpcExecutor.h"
+
+#include <spdlog/spdlog.h>
+
+#include <stdexcept>
+#include <utility>
+
+#include "jsonrpccxx/batchclient.hpp"
+
+namespace Casper
+{
+namespace
+{
+/// Result or error of the response to a single call.
+BatchResult<nlohmann::json> singleResult(const nlohmann::json& response)
+{
+    if (jsonrpccxx::has_key_type(response, "error", nlohmann::json::value_t::object))
+    {
+        return BatchResult<nlohmann::json>(jsonrpccxx::JsonRpcException::fromJson(response["error"]));
+    }
+    if (jsonrpccxx::has_key_type(response, "error", nlohmann::json::value_t::string))
+    {
+        return BatchResult<nlohmann::json>(
+            jsonrpccxx::JsonRpcException(jsonrpccxx::internal_error, response["error"].get<std::string>()));
+    }
+    if (jsonrpccxx::has_key(response, "result"))
+    {
+        return BatchResult<nlohmann::json>(response["result"]);
+    }
+    return BatchResult<nlohmann::json>(jsonrpccxx::JsonRpcException(
+        jsonrpccxx::internal_error, R"(invalid server response: neither "result" nor "error" fields found)"));
+}
+
+/// Delivers a result, a throwing completion must not take the thread down.
+void complete(const RpcExecutor::Completion& done, BatchResult<nlohmann::json> result)
+{
+    try
+    {
+        done(std::move(result));
+    }
+    catch (const std::exception& e)
+    {
+        SPDLOG_ERROR("RpcExecutor: completion threw: {}", e.what());
+    }
+}
+
+} // namespace
+
+RpcExecutor::RpcExecutor(EndpointRouter& connector, const AsyncConfig& config)
+    : _connector(connector),
+      _config(config)
+{
+    if (_config.threads == 0 || _config.max_coalesced_calls == 0)
+    {
+        throw std::invalid_argument("RpcExecutor: threads and max_coalesced_calls must be at least 1");
+    }
+}
+
+RpcExecutor::~RpcExecutor()
+{
+    std::vector<Completion> queued;
+    {
+        std::lock_guard lock(_mutex);
+        _stopping = true;
+        for (auto it = _calls.begin(); it != _calls.end();)
+        {
+            if (it->second.sent)
+            {
+                ++it;
+                continue;
+            }
+            queued.push_back(std::move(it->second.done));
+            it = _calls.erase(it);
+        }
+        _queue.clear();
+    }
+    _queued.notify_all();
+
+    for (const auto& done : queued)
+    {
+        complete(done, BatchResult<nlohmann::json>(
+                           jsonrpccxx::JsonRpcException(RPC_CANCELLED, "the client was destroyed")));
+    }
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+uint64_t RpcExecutor::Submit(std::string method, nlohmann::json params, Completion done)
+{
+    uint64_t id;
+    {
+        std::lock_guard lock(_mutex);
+        if (_threads.empty())
+        {
+            for (size_t i = 0; i < _config.threads; i++)
+            {
+                _threads.emplace_back([this] { Run(); });
+            }
+        }
+
+        id = _next_id++;
+        _calls.emplace(id, Call{std::move(method), std::move(params), std::move(done)});
+        _queue.push_back(id);
+    }
+    _queued.notify_one();
+    return id;
+}
+
+bool RpcExecutor::Cancel(uint64_t id)
+{
+    Completion done;
+    {
+        std::lock_guard lock(_mutex);
+        auto it = _calls.find(id);
+        if (it == _calls.end())
+        {
+            return false;
+        }
+        // a queued id is left in _queue and skipped when it is taken
+        done = std::move(it->second.done);
+        _calls.erase(it);
+    }
+
+    complete(done, BatchResult<nlohmann::json>(jsonrpccxx::JsonRpcException(RPC_CANCELLED, "the call was cancelled")));
+    return true;
+}
+
+size_t RpcExecutor::Pending() const
+{
+    std::lock_guard lock(_mutex);
+    return _calls.size();
+}
+
+void RpcExecutor::Run()
+{
+    std::unique_lock lock(_mutex);
+    while (true)
+    {
+        _queued.wait(lock, [this] { return _stopping || !_queue.empty(); });
+        if (_stopping)
+        {
+            return;
+        }
+
+        std::vector<uint64_t> ids;
+        std::vector<nlohmann::json> requests;
+        while (!_queue.empty() && ids.size() < _config.max_coalesced_calls)
+        {
+            uint64_t id = _queue.front();
+            _queue.pop_front();
+            auto it = _calls.find(id);
+            if (it == _calls.end())
+            {
+                continue;
+            }
+
+            Call& call = it->second;
+            call.sent = true;
+            requests.push_back({{"jsonrpc", "2.0"},
+                                {"id", id},
+                                {"method", std::move(call.method)},
+                                {"params", std::move(call.params)}});
+            ids.push_back(id);
+        }
+        if (!_queue.empty())
+        {
+            _queued.notify_one();
+        }
+        if (ids.empty())
+        {
+            continue;
+        }
+
+        lock.unlock();
+        auto results = Send(ids, std::move(requests));
+        lock.lock();
+
+        // calls cancelled while in flight are already completed
+        std::vector<std::pair<Completion, BatchResult<nlohmann::json>>> completed;
+        completed.reserve(ids.size());
+        for (size_t i = 0; i < ids.size(); i++)
+        {
+            auto it = _calls.find(ids[i]);
+            if (it != _calls.end())
+            {
+                completed.emplace_back(std::move(it->second.done), std::move(results[i]));
+                _calls.erase(it);
+            }
+        }
+
+        lock.unlock();
+        for (auto& [done, result] : completed)
+        {
+            complete(done, std::move(result));
+        }
+        lock.lock();
+    }
+}
+
+std::vector<BatchResult<nlohmann::json>> RpcExecutor::Send(const std::vector<uint64_t>& ids,
+                                                           std::vector<nlohmann::json> requests)
+{
+    std::vector<BatchResult<nlohmann::json>> results;
+    results.reserve(ids.size());
+
+    // a failure of the request as a whole fails each of its calls
+    auto failAll = [&](const jsonrpccxx::JsonRpcException& error)
+    {
+        results.clear();
+        results.resize(ids.size(), BatchResult<nlohmann::json>(error));
+        return results;
+    };
+
+    try
+    {
+        if (requests.size() == 1)
+        {
+            results.push_back(singleResult(nlohmann::json::parse(_connector.Send(requests[0].dump()))));
+            return results;
+        }
+
+        std::optional<std::string> body = _connector.SendBatch(nlohmann::json(requests).dump());
+        if (!body)
+        {
+            // no node left takes batches, each call goes on its own
+            for (const auto& request : requests)
+            {
+                try
+                {
+                    results.push_back(singleResult(nlohmann::json::parse(_connector.Send(request.dump()))));
+                }
+                catch (const jsonrpccxx::JsonRpcException& e)
+                {
+                    results.emplace_back(e);
+                }
+                catch (const nlohmann::json::exception& e)
+                {
+                    results.emplace_back(jsonrpccxx::JsonRpcException(
+                        jsonrpccxx::parse_error, std::string("invalid JSON response from server: ") + e.what()));
+                }
+            }
+            return results;
+        }
+
+        nlohmann::json response = nlohmann::json::parse(*body);
+        if (!response.is_array())
+        {
+            // a single error for the batch as a whole
+            BatchResult<nlohmann::json> single = singleResult(response);
+            return failAll(single.Error() ? *single.Error()
+                                          : jsonrpccxx::JsonRpcException(jsonrpccxx::parse_error,
+                                                                         "invalid JSON response from server: "
+                                                                         "expected array"));
+        }
+
+        jsonrpccxx::BatchResponse batch(std::move(response));
+        for (uint64_t id : ids)
+        {
+            try
+            {
+                results.emplace_back(batch.Get<nlohmann::json>(id));
+            }
+            catch (const jsonrpccxx::JsonRpcException& e)
+            {
+                results.emplace_back(e);
+            }
+        }
+        return results;
+    }
+    catch (const jsonrpccxx::JsonRpcException& e)
+    {
+        return failAll(e);
+    }
+    catch (const nlohmann::json::exception& e)
+    {
+        return failAll(jsonrpccxx::JsonRpcException(jsonrpccxx::parse_error,
+                                                    std::string("invalid JSON response from server: ") + e.what()));
+    }
+    catch (const std::exception& e)
+    {
+        return failAll(jsonrpccxx::JsonRpcException(jsonrpccxx::internal_error, e.what()));
+    }
+}
+
+} // namespace Casper
@@ -0,0 +1,135 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "JsonRpc/Connection/EndpointRouter.h"
+#include "JsonRpc/RpcBatch.h"
+#include "nlohmann/json.hpp"
+
+namespace Casper
+{
+/// Error code of an asynchronous call that was cancelled before its result
+/// was delivered.
+constexpr int RPC_CANCELLED = -32800;
+
+/**
+ * @brief Settings of the executor behind the asynchronous Client calls.
+ *
+ */
+struct AsyncConfig
+{
+    /// Threads sending the queued calls, each one has a single request in
+    /// flight at a time. 0 starts one per connection the Client may open,
+    /// ConnectionPoolConfig::max_connections for each node, so that the
+    /// calls use the whole pool.
+    size_t threads = 0;
+
+    /// Most queued calls a thread sends together as one JSON-RPC batch. The
+    /// calls in flight are bounded by threads * max_coalesced_calls, so
+    /// thousands of them need only a few threads; 1 sends every call as a
+    /// request of its own and ties each call in flight to a blocked thread.
+    /// Nodes without batch support get the calls one request each.
+    size_t max_coalesced_calls = 32;
+};
+
+/**
+ * @brief Queue of asynchronous JSON-RPC calls drained by a few threads. A
+ * thread blocks while its request is in flight, so at most
+ * AsyncConfig::threads requests are sent at once. A thread takes all queued
+ * calls up to max_coalesced_calls and sends them as one batch, so thousands
+ * of queued calls need no more than a few requests. Every call gets
+ * an id unique for the executor, which is also its JSON-RPC id, and can be
+ * cancelled until its result arrives.
+ *
+ */
+class RpcExecutor
+{
+public:
+    /// Called once per call with its result or error, on an executor thread,
+    /// or on the thread that cancelled the call. It must not wait for another
+    /// call of the executor, the thread it blocks is one that sends them.
+    using Completion = std::function<void(BatchResult<nlohmann::json>)>;
+
+    /**
+     * @brief Construct a new Rpc Executor object. The threads are started by
+     * the first call.
+     *
+     * @param connector sends the requests, and the batches to the nodes that
+     * take them.
+     * @param config thread count, at least 1, and batch size.
+     */
+    RpcExecutor(EndpointRouter& connector, const AsyncConfig& config);
+
+    /**
+     * @brief Fails the calls still queued with RPC_CANCELLED, and waits for the
+     * requests in flight.
+     */
+    ~RpcExecutor();
+
+    RpcExecutor(const RpcExecutor&) = delete;
+    RpcExecutor& operator=(const RpcExecutor&) = delete;
+
+    /**
+     * @brief Queues a call.
+     *
+     * @param method name of the rpc method.
+     * @param params named parameters of the call.
+     * @param done receives the result.
+     * @return uint64_t id of the call.
+     */
+    uint64_t Submit(std::string method, nlohmann::json params, Completion done);
+
+    /**
+     * @brief Completes a call with an RPC_CANCELLED error. A queued call is not
+     * sent, the result of a call already sent is dropped.
+     *
+     * @param id id returned by Submit().
+     * @return true if the call was cancelled, false if it had already
+     * completed.
+     */
+    bool Cancel(uint64_t id);
+
+    /**
+     * @brief Calls submitted and not completed yet.
+     */
+    size_t Pending() const;
+
+private:
+    struct Call
+    {
+        std::string method;
+        nlohmann::json params;
+        Completion done;
+        bool sent = false;
+    };
+
+    /// Loop of one executor thread.
+    void Run();
+
+    /// Sends the calls and returns one result or error per call, in order.
+    std::vector<BatchResult<nlohmann::json>> Send(const std::vector<uint64_t>& ids,
+                                                  std::vector<nlohmann::json> requests);
+
+    EndpointRouter& _connector;
+    AsyncConfig _config;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _queued;
+
+    /// Ids in submission order, cancelled ones are skipped when taken.
+    std::deque<uint64_t> _queue;
+    std::unordered_map<uint64_t, Call> _calls;
+    uint64_t _next_id = 1;
+    bool _stopping = false;
+
+    std::vector<std::thread> _threads;
+};
+
+} // namespace Casper
@@ -2,6 +2,7 @@
 
 #include "Base.h"
 #include "Types/Block.h"
+#include "Types/Hash32.h"
 #include "nlohmann/json.hpp"
 
 namespace Casper
@@ -17,7 +18,7 @@ struct BlockAdded
     /// <summary>
     /// The block hash.
     /// </summary>
-    std::string block_hash;
+    Hash32 block_hash;
 
     /// <summary>
     /// The block data.
@@ -2,6 +2,7 @@
 
 #include "Base.h"
 #include "nlohmann/json.hpp"
+#include "Types/Hash32.h"
 
 namespace Casper
 {
@@ -16,7 +17,7 @@ struct DeployExpired
     /// <summary>
     /// The hash of the expired deploy.
     /// </summary>
-    std::string deploy_hash;
+    Hash32 deploy_hash;
 };
 
 inline void to_json(nlohmann::json& j, const DeployExpired& p)
@@ -2,6 +2,7 @@
 
 #include "Base.h"
 #include "Types/ExecutionResult.h"
+#include "Types/Hash32.h"
 #include "nlohmann/json.hpp"
 
 namespace Casper
@@ -17,7 +18,7 @@ struct DeployProcessed
     /// <summary>
     /// The deploy hash.
     /// </summary>
-    std::string deploy_hash;
+    Hash32 deploy_hash;
 
     /// <summary>
     /// The public key of the account that originates the Deploy.
@@ -37,12 +38,12 @@ struct DeployProcessed
     /// <summary>
     /// A list of hashes to other deploys that have to be run before this one.
     /// </summary>
-    std::vector<std::string> dependencies;
+    std::vector<Hash32> dependencies;
 
     /// <summary>
     /// The hash of the block containing this Deploy.
     /// </summary>
-    std::string block_hash;
+    Hash32 block_hash;
 
     /// <summary>
     /// The result of executing a this Deploy.
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Base.h"
-#include "Types/PublicKey.h"
+#include "Types/PublicKeyTable.h"
 #include "nlohmann/json.hpp"
 
 namespace Casper
@@ -39,7 +39,7 @@ inline void from_json(const nlohmann::json& j, Fault& p)
 {
     j.at("era_id").get_to(p.era_id);
     j.at("timestamp").get_to(p.timestamp);
-    j.at("public_key").get_to(p.public_key);
+    internPublicKey(j.at("public_key"), p.public_key);
 }
 
 } // namespace Casper
@@ -1,7 +1,8 @@
 #pragma once
 
 #include "Base.h"
-#include "Types/PublicKey.h"
+#include "Types/Hash32.h"
+#include "Types/PublicKeyTable.h"
 #include "Types/Signature.h"
 #include "nlohmann/json.hpp"
 
@@ -18,7 +19,7 @@ struct FinalitySignature
     /// <summary>
     /// The block hash
     /// </summary>
-    std::string block_hash;
+    Hash32 block_hash;
 
     /// <summary>
     /// The block era id.
@@ -45,7 +46,7 @@ inline void from_json(const nlohmann::json& j, FinalitySignature& p)
 {
     j.at("block_hash").get_to(p.block_hash);
     j.at("era_id").get_to(p.era_id);
-    j.at("public_key").get_to(p.public_key);
+    internPublicKey(j.at("public_key"), p.public_key);
     j.at("signature").get_to(p.signature);
 }
 
@@ -2,6 +2,7 @@
 
 #include "Base.h"
 #include "Types/EraValidators.h"
+#include "Types/Hash32.h"
 #include "Types/ValidatorBid.h"
 
 namespace Casper
@@ -14,7 +15,7 @@ struct AuctionState
     /// <summary>
     /// Global state hash.
     /// </summary>
-    std::string state_root_hash;
+    Hash32 state_root_hash;
 
     /// <summary>
     /// Block height.
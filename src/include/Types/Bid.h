@@ -2,7 +2,7 @@
 
 #include "Base.h"
 #include "Types/Delegator.h"
-#include "Types/PublicKey.h"
+#include "Types/PublicKeyTable.h"
 #include "Types/URef.h"
 #include "Types/VestingSchedule.h"
 #include "Utils/CryptoUtil.h"
@@ -86,11 +86,11 @@ inline void from_json(const nlohmann::json& j, Bid& p)
 {
     if (j.count("delegator_public_key") != 0)
     {
-        j.at("validator_public_key").get_to(p.validator_public_key);
+        internPublicKey(j.at("validator_public_key"), p.validator_public_key);
     }
     else if (j.count("public_key") != 0)
     {
-        j.at("public_key").get_to(p.validator_public_key);
+        internPublicKey(j.at("public_key"), p.validator_public_key);
     }
 
     j.at("bonding_purse").get_to(p.bonding_purse);
@@ -2,6 +2,8 @@
 
 #include "Base.h"
 #include "Types/EraEnd.h"
+#include "Types/Hash32.h"
+#include "Types/PublicKeyTable.h"
 #include "Types/Signature.h"
 #include "nlohmann/json.hpp"
 
@@ -15,12 +17,12 @@ struct BlockHeader
     /// <summary>
     /// Accumulated seed.
     /// </summary>
-    std::string accumulated_seed;
+    Hash32 accumulated_seed;
 
     /// <summary>
     /// The body hash.
     /// </summary>
-    std::string body_hash;
+    Hash32 body_hash;
 
     /// <summary>
     /// The era end.
@@ -40,7 +42,7 @@ struct BlockHeader
     /// <summary>
     /// The parent hash.
     /// </summary>
-    std::string parent_hash;
+    Hash32 parent_hash;
 
     /// <summary>
     /// The protocol version.
@@ -55,7 +57,7 @@ struct BlockHeader
     /// <summary>
     /// The state root hash.
     /// </summary>
-    std::string state_root_hash;
+    Hash32 state_root_hash;
 
     /// <summary>
     /// The block timestamp.
@@ -112,7 +114,7 @@ struct BlockBody
     /// <summary>
     /// List of Deploy hashes included in the block
     /// </summary>
-    std::vector<std::string> deploy_hashes;
+    std::vector<Hash32> deploy_hashes;
 
     /// <summary>
     /// Public key of the validator that proposed the block
@@ -122,7 +124,7 @@ struct BlockBody
     /// <summary>
     /// List of Transfer hashes included in the block
     /// </summary>
-    std::vector<std::string> transfer_hashes;
+    std::vector<Hash32> transfer_hashes;
 
     BlockBody() = default;
 };
@@ -142,7 +144,7 @@ inline void to_json(nlohmann::json& j, const BlockBody& p)
 inline void from_json(const nlohmann::json& j, BlockBody& p)
 {
     j.at("deploy_hashes").get_to(p.deploy_hashes);
-    j.at("proposer").get_to(p.proposer);
+    internPublicKey(j.at("proposer"), p.proposer);
     j.at("transfer_hashes").get_to(p.transfer_hashes);
 }
 
@@ -173,7 +175,7 @@ inline void to_json(nlohmann::json& j, const BlockProof& p)
 // from_json of BlockProof
 inline void from_json(const nlohmann::json& j, BlockProof& p)
 {
-    j.at("public_key").get_to(p.public_key);
+    internPublicKey(j.at("public_key"), p.public_key);
     j.at("signature").get_to(p.signature);
 }
 
@@ -190,7 +192,7 @@ struct Block
     /// <summary>
     /// Block hash
     /// </summary>
-    std::string hash;
+    Hash32 hash;
 
     /// <summary>
     /// Block header
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Base.h"
+#include "Types/Hash32.h"
 #include "Types/PublicKey.h"
 #include "nlohmann/json.hpp"
 
@@ -24,7 +25,7 @@ struct BlockInfo
     /// <summary>
     /// Block hash
     /// </summary>
-    std::string hash;
+    Hash32 hash;
 
     /// <summary>
     /// Height of the block
@@ -34,7 +35,7 @@ struct BlockInfo
     /// <summary>
     /// The state root hash.
     /// </summary>
-    std::string state_root_hash;
+    Hash32 state_root_hash;
 
     /// <summary>
     /// The block timestamp.
@@ -1,6 +1,10 @@
 #include "Types/CLConverter.h"
 
+#include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <limits>
+#include <string_view>
 
 #include "date/date.h"
 // #include "bigint/BigIntegerLibrary.hh"
@@ -21,6 +25,127 @@ uint64_t strToTimestamp(const std::string& str_date)
     return duration_cast<milliseconds>(tp.time_since_epoch()).count();
 }
 
+/// Formats milliseconds since the epoch like the node does, e.g.
+/// "2022-04-23T09:38:21.700Z".
+std::string timestampToStr(uint64_t timestamp)
+{
+    date::sys_time<std::chrono::milliseconds> tp{std::chrono::milliseconds{timestamp}};
+    return date::format("%FT%TZ", tp);
+}
+
+namespace
+{
+struct DurationUnit
+{
+    std::string_view name;
+    uint64_t millis;
+};
+
+constexpr DurationUnit kDurationUnits[] = {
+    {"ms", 1},           {"msec", 1},           {"millis", 1},
+    {"s", 1000},         {"sec", 1000},         {"secs", 1000},         {"second", 1000},  {"seconds", 1000},
+    {"m", 60000},        {"min", 60000},        {"mins", 60000},        {"minute", 60000}, {"minutes", 60000},
+    {"h", 3600000},      {"hr", 3600000},       {"hrs", 3600000},       {"hour", 3600000}, {"hours", 3600000},
+    {"d", 86400000},     {"day", 86400000},     {"days", 86400000},
+    {"w", 604800000},    {"week", 604800000},   {"weeks", 604800000},
+};
+} // namespace
+
+/// Parses a human readable duration such as "30m" or "1day 2h" into
+/// milliseconds. Throws std::out_of_range if it does not fit in 64 bits.
+uint64_t strToDuration(const std::string& str)
+{
+    uint64_t total = 0;
+    size_t pos = 0;
+    bool empty = true;
+
+    while (pos < str.size())
+    {
+        if (str[pos] == ' ')
+        {
+            pos++;
+            continue;
+        }
+
+        size_t num_end = pos;
+        while (num_end < str.size() && std::isdigit(static_cast<unsigned char>(str[num_end])))
+        {
+            num_end++;
+        }
+        size_t unit_end = num_end;
+        while (unit_end < str.size() && std::isalpha(static_cast<unsigned char>(str[unit_end])))
+        {
+            unit_end++;
+        }
+
+        if (num_end == pos || unit_end == num_end)
+        {
+            throw std::invalid_argument("Invalid duration: " + str);
+        }
+
+        std::string_view unit(str.data() + num_end, unit_end - num_end);
+        auto it = std::find_if(std::begin(kDurationUnits), std::end(kDurationUnits),
+                               [&](const DurationUnit& u) { return u.name == unit; });
+        if (it == std::end(kDurationUnits))
+        {
+            throw std::invalid_argument("Invalid duration unit: " + std::string(unit));
+        }
+
+        // the ttl goes into the deploy hash, so a wrapped value must not pass
+        uint64_t value = std::stoull(str.substr(pos, num_end - pos));
+        if (value > (std::numeric_limits<uint64_t>::max() - total) / it->millis)
+        {
+            throw std::out_of_range("Duration out of range: " + str);
+        }
+        total += value * it->millis;
+        pos = unit_end;
+        empty = false;
+    }
+
+    if (empty)
+    {
+        throw std::invalid_argument("Invalid duration: " + str);
+    }
+
+    return total;
+}
+
+/// Formats a duration in milliseconds the way the node does, e.g. "30m" or
+/// "1day 2h".
+std::string durationToStr(uint64_t duration)
+{
+    if (duration == 0)
+    {
+        return "0s";
+    }
+
+    const std::pair<uint64_t, std::string_view> parts[] = {
+        {86400000, "day"}, {3600000, "h"}, {60000, "m"}, {1000, "s"}, {1, "ms"}};
+
+    std::string result;
+    for (const auto& [millis, unit] : parts)
+    {
+        uint64_t count = duration / millis;
+        duration %= millis;
+        if (count == 0)
+        {
+            continue;
+        }
+
+        if (!result.empty())
+        {
+            result += ' ';
+        }
+        result += std::to_string(count);
+        result += unit;
+        if (unit == "day" && count > 1)
+        {
+            result += 's';
+        }
+    }
+    return result;
+}
+
 // Encoding & Decoding
 
 bool boolDecode(const std::string& byte_str)
@@ -108,10 +233,7 @@ std::string stringEncode(const std::string& val)
 // Check this and pkdecode, maybe checksum convert
 GlobalStateKey urefDecode(const std::string& byte_str)
 {
-    CBytes uref_bytes;
-    uref_bytes = hexDecode(byte_str);
-
-    return URef::FromString(URef::byteToStringWithAccessRights(uref_bytes));
+    return URef(hexDecode(byte_str));
 }
 
 PublicKey publicKeyDecode(const std::string& byte_str)
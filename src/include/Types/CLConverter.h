@@ -20,6 +20,12 @@ namespace Casper
 
 uint64_t strToTimestamp(const std::string& str);
 
+std::string timestampToStr(uint64_t timestamp);
+
+uint64_t strToDuration(const std::string& str);
+
+std::string durationToStr(uint64_t duration);
+
 // CBytes hexDecode(const std::string& hex);
 //
 // std::string hexEncode(CBytes decoded);
@@ -1,10 +1,74 @@
 #include "Types/CLType.h"
+#include "Types/CLTypeTable.h"
+
+#include <array>
+#include <stdexcept>
+#include <string_view>
 
 namespace Casper
 {
-bool CLType::operator<(const CLType& b) const
+namespace
+{
+/// Descriptors of the primitive types in the process wide table, indexed by
+/// tag and looked up once; null for the composite tags.
+const CLTypeDescriptor* primitiveDescriptor(CLTypeEnum tag)
+{
+    static const auto descriptors = []
+    {
+        std::array<const CLTypeDescriptor*, static_cast<size_t>(CLTypeEnum::PublicKey) + 1> primitives{};
+        auto& table = CLTypeTable::Instance();
+        for (size_t i = 0; i < primitives.size(); i++)
+        {
+            if (CLTypeTable::IsPrimitive(static_cast<CLTypeEnum>(i)))
+            {
+                primitives[i] = &table.Get(static_cast<CLTypeHandle>(i));
+            }
+        }
+        return primitives;
+    }();
+    return descriptors[static_cast<size_t>(tag)];
+}
+
+} // namespace
+
+void CLType::Assign(CLTypeRVA type)
+{
+    _own_type.reset();
+    if (type.which() == 0)
+    {
+        // the handle of a primitive is its tag, no need to look it up
+        auto tag = boost::get<CLTypeEnum>(type);
+        if (!CLTypeTable::IsPrimitive(tag))
+        {
+            throw std::invalid_argument("CLType: " + std::string(magic_enum::enum_name(tag)) +
+                                        " is not a primitive type");
+        }
+        const CLTypeDescriptor* descriptor = primitiveDescriptor(tag);
+        _handle = static_cast<CLTypeHandle>(tag);
+        _type = &descriptor->type;
+        _json = &descriptor->json;
+        return;
+    }
+
+    auto& table = CLTypeTable::Instance();
+    _handle = table.Intern(type);
+    if (_handle == CL_TYPE_NOT_INTERNED)
+    {
+        _type = nullptr;
+        _json = nullptr;
+        _own_type = std::make_shared<const CLTypeRVA>(std::move(type));
+        return;
+    }
+    const CLTypeDescriptor& descriptor = table.Get(_handle);
+    _type = &descriptor.type;
+    _json = &descriptor.json;
+}
+
+size_t CLType::StructuralHash(const CLTypeRVA& type)
 {
-    return true;
+    std::vector<uint8_t> bytes = CLTypeTable::Encode(type);
+    return std::hash<std::string_view>{}(
+        std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
 }
 
 } // namespace Casper
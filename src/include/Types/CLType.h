@@ -9,7 +9,10 @@
 #include "rva/variant.hpp"
 #include <tuple>
 
+#include <functional>
+#include <memory>
 #include <unordered_map>
+#include <limits>
 #include <optional>
 #include "magic_enum/magic_enum.hpp"
 #include <boost/variant/recursive_variant.hpp>
@@ -332,27 +335,86 @@ inline void from_json(const nlohmann::json& j, CLTypeRVA& p)
     }
 }
 
+/// <summary>
+/// Small integer identifying a CLType interned in the CLTypeTable. Two handles
+/// are equal exactly when the types they stand for are equal.
+/// </summary>
+using CLTypeHandle = uint32_t;
+
+/// <summary>
+/// Handle of a type left out of the CLTypeTable because the table was full.
+/// </summary>
+constexpr CLTypeHandle CL_TYPE_NOT_INTERNED = std::numeric_limits<CLTypeHandle>::max();
+
+/// <summary>
+/// A CLType is its handle in the CLTypeTable. The type tree is stored once,
+/// in the descriptor of the type, and shared by every CLType of that type;
+/// only a type left out of a full table keeps a tree of its own.
+/// </summary>
 struct CLType
 {
-    CLTypeRVA type;
     // TODO: ADD TAG
-    CLType()
-        : type(CLTypeEnum::Any)
+    CLType() { Assign(CLTypeEnum::Any); }
+
+    CLType(CLTypeRVA type) { Assign(std::move(type)); }
+
+    // TODO: Make functions like CLValue u512, u256, u128, u64, u32, u16, u8, etc.
+
+    /// <summary>
+    /// The type tree. Read only, shared with the other CLTypes of the same
+    /// type; build a new CLType for another type.
+    /// </summary>
+    const CLTypeRVA& Type() const { return _type ? *_type : *_own_type; }
+
+    /// <summary>
+    /// JSON form of the type, built once with its descriptor. Null for a type
+    /// left out of a full table.
+    /// </summary>
+    const nlohmann::json* Json() const { return _json; }
+
+    /// <summary>
+    /// Handle of the type in the CLTypeTable, interned when the CLType was
+    /// built. CL_TYPE_NOT_INTERNED if the table was full.
+    /// </summary>
+    CLTypeHandle Handle() const { return _handle; }
+
+    /// <summary>
+    /// Equal types have equal handles, only types left out of a full table
+    /// are compared structurally.
+    /// </summary>
+    bool operator==(const CLType& b) const
     {
+        if (_handle != CL_TYPE_NOT_INTERNED || b._handle != CL_TYPE_NOT_INTERNED)
+        {
+            return _handle == b._handle;
+        }
+        return Type() == b.Type();
     }
-    CLType(CLTypeRVA type)
-        : type(type)
+
+    /// <summary>
+    /// Orders by handle, types left out of a full table come last, ordered
+    /// structurally. An interned type never equals one that was left out.
+    /// </summary>
+    bool operator<(const CLType& b) const
     {
+        if (_handle != CL_TYPE_NOT_INTERNED || b._handle != CL_TYPE_NOT_INTERNED)
+        {
+            return _handle < b._handle;
+        }
+        return Type() < b.Type();
     }
 
-    // TODO: Make functions like CLValue u512, u256, u128, u64, u32, u16, u8, etc.
-    bool operator<(const CLType& b) const;
+    /// <summary>
+    /// The handle, or a hash of the structure for a type left out of a full
+    /// table.
+    /// </summary>
+    size_t Hash() const { return _handle != CL_TYPE_NOT_INTERNED ? _handle : StructuralHash(Type()); }
 
     CLType(int32_t byte_array_size)
     {
         std::map<std::string, int32_t> byte_array;
         byte_array["ByteArray"] = byte_array_size;
-        type = byte_array;
+        Assign(byte_array);
     }
 
     CLType(CLTypeRVA type_, CLTypeEnum tag)
@@ -365,20 +427,20 @@ struct CLType
         case CLTypeEnum::List:
             obj_type = type_;
             list_map["List"] = obj_type;
-            type = list_map;
             break;
 
         default:
             std::cout << "Invalid Tag" << std::endl;
             throw std::runtime_error("Invalid CLType");
         }
+        Assign(list_map);
     }
 
     CLType(std::optional<CLTypeRVA>& option)
     {
         std::map<std::string, CLTypeRVA> option_map;
         option_map["Option"] = option.value();
-        type = option_map;
+        Assign(option_map);
     }
 
     CLType(CLTypeRVA ok, CLTypeRVA err, CLTypeEnum tag)
@@ -394,22 +456,56 @@ struct CLType
 
         std::map<std::string, CLTypeRVA> res_mp;
         res_mp["Result"] = result_map;
-        type = res_mp;
+        Assign(res_mp);
     }
+
+private:
+    /// Sets the handle and the shared tree and JSON of the type. Primitives
+    /// take the tag as handle without a lookup in the CLTypeTable, other
+    /// types are interned; a type left out of a full table keeps `type` as
+    /// its own.
+    void Assign(CLTypeRVA type);
+
+    /// Hash of the bytesrepr encoding of the type.
+    static size_t StructuralHash(const CLTypeRVA& type);
+
+    CLTypeHandle _handle = CL_TYPE_NOT_INTERNED;
+
+    /// The tree and the JSON form in the descriptor of an interned type,
+    /// which is never moved or freed.
+    const CLTypeRVA* _type = nullptr;
+    const nlohmann::json* _json = nullptr;
+
+    /// The tree of a type left out of a full table.
+    std::shared_ptr<const CLTypeRVA> _own_type;
 };
 
 // to_json of CLType
 inline void to_json(nlohmann::json& j, const CLType& p)
 {
-    //
-    to_json(j, p.type);
+    // interned types carry their JSON form, only the others walk the tree
+    if (p.Json())
+    {
+        j = *p.Json();
+        return;
+    }
+    to_json(j, p.Type());
 }
 
 // from_json of CLType
 inline void from_json(const nlohmann::json& j, CLType& p)
 {
-    //
-    j.get_to(p.type);
+    p = CLType(j.get<CLTypeRVA>());
 }
 
-} // namespace Casper
\ No newline at end of file
+} // namespace Casper
+
+namespace std
+{
+template <>
+struct hash<Casper::CLType>
+{
+    size_t operator()(const Casper::CLType& value) const { return value.Hash(); }
+};
+
+} // namespace std
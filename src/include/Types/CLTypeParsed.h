@@ -1,13 +1,17 @@
 #pragma once
 
+#include <charconv>
 #include <optional>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <spdlog/spdlog.h>
 
 #include "Base.h"
 #include "CLType.h"
 #include "Types/CLConverter.h"
+#include "Types/CLTypeParsedArray.h"
+#include "Types/CLTypeParsedU512.h"
 #include "Types/GlobalStateKey.h"
 #include "Types/PublicKey.h"
 #include "Types/URef.h"
@@ -19,6 +23,14 @@
 namespace Casper
 {
 
+/// <summary>
+/// Parsed value of a CLValue. Alternatives larger than a std::string (URef,
+/// GlobalStateKey and PublicKey) are held through a boost::recursive_wrapper,
+/// out of line, so that the elements of big lists and maps stay small;
+/// boost::get works on them as usual. A U512 is a CLTypeParsedU512, inline
+/// when it fits in 64 bits. Lists of fixed width primitives are parsed into a
+/// CLTypeParsedArray.
+/// </summary>
 using CLTypeParsedRVA = boost::make_recursive_variant<
     bool,      // 0 Bool, // boolean primitive
     int32_t,   // 1 I32, // signed 32-bit integer primitive
@@ -28,16 +40,16 @@ using CLTypeParsedRVA = boost::make_recursive_variant<
     uint64_t,  // 5 U64, // unsigned 64-bit integer primitive
     uint128_t, // 6 U128, // unsigned 128-bit integer primitive
     uint256_t, // 7 U256, // unsigned 256-bit integer primitive
-    uint512_t, // 8 U512, // unsigned 512-bit integer primitive
+    CLTypeParsedU512, // 8 U512, // unsigned 512-bit integer primitive
     // Unit, // singleton value without additional semantics
 
     std::string,    // 9 String, // e.g. "Hello, World!"
 
-    URef,           // 10 URef, // unforgeable reference (see above)
+    boost::recursive_wrapper<URef>,           // 10 URef, // unforgeable reference (see above)
 
-    GlobalStateKey, // 11 Key, // global state key (see above)
+    boost::recursive_wrapper<GlobalStateKey>, // 11 Key, // global state key (see above)
 
-    PublicKey,      // 12 PublicKey // A Casper system PublicKey type
+    boost::recursive_wrapper<PublicKey>,      // 12 PublicKey // A Casper system PublicKey type
 
     //  Option(CLType), // optional value of the given type
 
@@ -55,10 +67,246 @@ using CLTypeParsedRVA = boost::make_recursive_variant<
                                                                     //  where keys and values have
                                                                     //  the given types
 
-    std::monostate                                                  // 16 Any // Indicates the type is not known
+    std::monostate, // 16 Any // Indicates the type is not known
+
+    CLTypeParsedArray // 17 List(CLType) of a fixed width primitive
 
     >::type;
 
+/// <summary>
+/// Writes the same JSON array as the std::vector&lt;CLTypeParsedRVA&gt; form of
+/// the list.
+/// </summary>
+inline void to_json(nlohmann::json& j, const CLTypeParsedArray& p)
+{
+    j = nlohmann::json::array();
+    auto& items = j.get_ref<nlohmann::json::array_t&>();
+    items.reserve(p.Size());
+    for (size_t i = 0; i < p.Size(); i++)
+    {
+        switch (p.ElementType())
+        {
+        case CLTypeEnum::Bool:
+            items.emplace_back(p.Get<bool>(i));
+            break;
+        case CLTypeEnum::I32:
+            items.emplace_back(p.Get<int32_t>(i));
+            break;
+        case CLTypeEnum::I64:
+            items.emplace_back(p.Get<int64_t>(i));
+            break;
+        case CLTypeEnum::U8:
+            items.emplace_back(p.Get<uint8_t>(i));
+            break;
+        case CLTypeEnum::U32:
+            items.emplace_back(p.Get<uint32_t>(i));
+            break;
+        case CLTypeEnum::U64:
+            items.emplace_back(p.Get<uint64_t>(i));
+            break;
+        default:
+            // U128, U256 and U512 are decimal strings
+            items.emplace_back(std::to_string(p.Get<uint64_t>(i)));
+            break;
+        }
+    }
+}
+
+/// <summary>
+/// Parses a JSON list of `element_type` values into a CLTypeParsedArray.
+/// Returns nothing if the type can not be stored that way or a U128, U256 or
+/// U512 value does not fit in 64 bits.
+/// </summary>
+inline std::optional<CLTypeParsedArray> parsedArrayFromJson(const nlohmann::json& j, CLTypeEnum element_type)
+{
+    if (CLTypeParsedArray::ElementSize(element_type) == 0)
+    {
+        return std::nullopt;
+    }
+
+    CLTypeParsedArray array(element_type);
+    array.Reserve(j.size());
+    for (auto& item : j)
+    {
+        switch (element_type)
+        {
+        case CLTypeEnum::Bool:
+            array.PushBack(item.get<bool>());
+            break;
+        case CLTypeEnum::I32:
+            array.PushBack(static_cast<uint64_t>(item.get<int32_t>()));
+            break;
+        case CLTypeEnum::I64:
+            array.PushBack(static_cast<uint64_t>(item.get<int64_t>()));
+            break;
+        case CLTypeEnum::U8:
+            array.PushBack(item.get<uint8_t>());
+            break;
+        case CLTypeEnum::U32:
+            array.PushBack(item.get<uint32_t>());
+            break;
+        case CLTypeEnum::U64:
+            array.PushBack(item.get<uint64_t>());
+            break;
+        default:
+        {
+            const auto& dec = item.get_ref<const std::string&>();
+            uint64_t value = 0;
+            auto result = std::from_chars(dec.data(), dec.data() + dec.size(), value);
+            if (result.ec != std::errc() || result.ptr != dec.data() + dec.size())
+            {
+                return std::nullopt;
+            }
+            array.PushBack(value);
+            break;
+        }
+        }
+    }
+    return array;
+}
+
+/// <summary>
+/// Elements of a parsed List, Tuple or array, one CLTypeParsedRVA each
+/// whichever way the list is stored.
+/// </summary>
+inline std::vector<CLTypeParsedRVA> parsedList(const CLTypeParsedRVA& p)
+{
+    if (p.which() == 13)
+    {
+        return boost::get<std::vector<CLTypeParsedRVA>>(p);
+    }
+
+    const auto& array = boost::get<CLTypeParsedArray>(p);
+    std::vector<CLTypeParsedRVA> list;
+    list.reserve(array.Size());
+    for (size_t i = 0; i < array.Size(); i++)
+    {
+        switch (array.ElementType())
+        {
+        case CLTypeEnum::Bool:
+            list.emplace_back(array.Get<bool>(i));
+            break;
+        case CLTypeEnum::I32:
+            list.emplace_back(array.Get<int32_t>(i));
+            break;
+        case CLTypeEnum::I64:
+            list.emplace_back(array.Get<int64_t>(i));
+            break;
+        case CLTypeEnum::U8:
+            list.emplace_back(array.Get<uint8_t>(i));
+            break;
+        case CLTypeEnum::U32:
+            list.emplace_back(array.Get<uint32_t>(i));
+            break;
+        case CLTypeEnum::U64:
+            list.emplace_back(array.Get<uint64_t>(i));
+            break;
+        case CLTypeEnum::U128:
+            list.emplace_back(uint128_t(array.Get<uint64_t>(i)));
+            break;
+        case CLTypeEnum::U256:
+            list.emplace_back(uint256_t(array.Get<uint64_t>(i)));
+            break;
+        default:
+            list.emplace_back(CLTypeParsedU512(uint512_t(array.Get<uint64_t>(i))));
+            break;
+        }
+    }
+    return list;
+}
+
+/// <summary>
+/// Packs a List of `element_type` values, one CLTypeParsedRVA each, into the
+/// CLTypeParsedArray the parsers would produce for it. Returns nothing when
+/// the parsers keep the list generic too: the type does not fit an array or
+/// a U128, U256 or U512 value does not fit in 64 bits.
+/// </summary>
+inline std::optional<CLTypeParsedArray> parsedArrayFromList(const std::vector<CLTypeParsedRVA>& list,
+                                                            CLTypeEnum element_type)
+{
+    if (CLTypeParsedArray::ElementSize(element_type) == 0)
+    {
+        return std::nullopt;
+    }
+
+    // the CLValue factories keep U128, U256 and U512 values as decimal text
+    auto narrow = [](const CLTypeParsedRVA& item, const auto& type) -> std::optional<uint64_t>
+    {
+        using T = std::decay_t<decltype(type)>;
+        if (const auto* dec = boost::get<std::string>(&item))
+        {
+            uint64_t value = 0;
+            auto result = std::from_chars(dec->data(), dec->data() + dec->size(), value);
+            if (result.ec != std::errc() || result.ptr != dec->data() + dec->size())
+            {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        const T& value = boost::get<T>(item);
+        if constexpr (std::is_same_v<T, CLTypeParsedU512>)
+        {
+            if (!value.IsSmall())
+            {
+                return std::nullopt;
+            }
+            return static_cast<uint64_t>(value.Value());
+        }
+        else
+        {
+            if (value > std::numeric_limits<uint64_t>::max())
+            {
+                return std::nullopt;
+            }
+            return static_cast<uint64_t>(value);
+        }
+    };
+
+    CLTypeParsedArray array(element_type);
+    array.Reserve(list.size());
+    for (const auto& item : list)
+    {
+        std::optional<uint64_t> value;
+        switch (element_type)
+        {
+        case CLTypeEnum::Bool:
+            value = boost::get<bool>(item);
+            break;
+        case CLTypeEnum::I32:
+            value = static_cast<uint64_t>(boost::get<int32_t>(item));
+            break;
+        case CLTypeEnum::I64:
+            value = static_cast<uint64_t>(boost::get<int64_t>(item));
+            break;
+        case CLTypeEnum::U8:
+            value = boost::get<uint8_t>(item);
+            break;
+        case CLTypeEnum::U32:
+            value = boost::get<uint32_t>(item);
+            break;
+        case CLTypeEnum::U64:
+            value = boost::get<uint64_t>(item);
+            break;
+        case CLTypeEnum::U128:
+            value = narrow(item, uint128_t());
+            break;
+        case CLTypeEnum::U256:
+            value = narrow(item, uint256_t());
+            break;
+        default:
+            value = narrow(item, CLTypeParsedU512());
+            break;
+        }
+        if (!value)
+        {
+            return std::nullopt;
+        }
+        array.PushBack(*value);
+    }
+    return array;
+}
+
 inline void to_json(nlohmann::json& j, const CLTypeParsedRVA& p)
 {
     if (p.which() == 0)
@@ -103,8 +351,7 @@ inline void to_json(nlohmann::json& j, const CLTypeParsedRVA& p)
     }
     else if (p.which() == 8)
     {
-        auto p_type = boost::get<uint512_t>(p);
-        j = p_type;
+        j = boost::get<CLTypeParsedU512>(p).Value();
     }
     else if (p.which() == 9)
     {
@@ -163,13 +410,17 @@ inline void to_json(nlohmann::json& j, const CLTypeParsedRVA& p)
     {
         j = nullptr;
     }
+    else if (p.which() == 17)
+    {
+        to_json(j, boost::get<CLTypeParsedArray>(p));
+    }
 }
 
 inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_type_)
 {
     // std::cout << "from_json, idx: " << p.which() << std::endl;
     bool is_primitive = false;
-    if (cl_type_.type.which() == 0)
+    if (cl_type_.Type().which() == 0)
     {
         is_primitive = true;
     }
@@ -177,9 +428,9 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_ty
     if (is_primitive)
     {
         // std::cout << "enum: "
-        //           << magic_enum::enum_name(boost::get<CLTypeEnum>(cl_type_.type))
+        //           << magic_enum::enum_name(boost::get<CLTypeEnum>(cl_type_.Type()))
         //           << std::endl;
-        switch (boost::get<CLTypeEnum>(cl_type_.type))
+        switch (boost::get<CLTypeEnum>(cl_type_.Type()))
         {
         case CLTypeEnum::Bool:
             p = j.get<bool>();
@@ -207,7 +458,7 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_ty
             p = u256FromDec(j.get<std::string>());
             break;
         case CLTypeEnum::U512:
-            p = u512FromDec(j.get<std::string>());
+            p = CLTypeParsedU512(u512FromDec(j.get<std::string>()));
             break;
         case CLTypeEnum::Unit:
         case CLTypeEnum::Any:
@@ -230,12 +481,12 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_ty
             break;
         }
     }
-    else if (cl_type_.type.which() == 1)
+    else if (cl_type_.Type().which() == 1)
     {
         // vector<CLTypeRVA>
         // std::cout << "\nvector<CLTypeRVA> from_json\n" << std::endl;
     }
-    else if (cl_type_.type.which() == 2)
+    else if (cl_type_.Type().which() == 2)
     {
         // Map(CLType, CLType)
         auto parsed_map = std::map<CLTypeParsedRVA, CLTypeParsedRVA>();
@@ -245,12 +496,6 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_ty
             // Multiple key-value pairs
             for (auto& item : j)
             {
-                CLType key_type;
-                key_type.type = boost::get<std::map<CLTypeRVA, CLTypeRVA>>(cl_type_.type).begin()->first;
-
-                CLType value_type;
-                value_type.type = boost::get<std::map<CLTypeRVA, CLTypeRVA>>(cl_type_.type).begin()->second;
-
                 CLTypeParsedRVA key_parsed = item.at("key").get<CLTypeParsedRVA>();
                 CLTypeParsedRVA value_parsed = item.at("value").get<CLTypeParsedRVA>();
 
@@ -262,12 +507,6 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_ty
         else
         {
             // Single key-value pair
-            CLType key_type;
-            key_type.type = boost::get<std::map<CLTypeRVA, CLTypeRVA>>(cl_type_.type).begin()->first;
-
-            CLType value_type;
-            value_type.type = boost::get<std::map<CLTypeRVA, CLTypeRVA>>(cl_type_.type).begin()->second;
-
             CLTypeParsedRVA key_parsed;
             CLTypeParsedRVA value_parsed;
 
@@ -278,18 +517,17 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_ty
             p = parsed_map;
         }
     }
-    else if (cl_type_.type.which() == 3)
+    else if (cl_type_.Type().which() == 3)
     {
         /// option, list, result
 
-        auto obj = boost::get<std::map<std::string, CLTypeRVA>>(cl_type_.type);
+        auto obj = boost::get<std::map<std::string, CLTypeRVA>>(cl_type_.Type());
 
         // Type of the current object
         std::string type_name = obj.begin()->first;
 
         // Type of the object's value to be parsed inside the from_json below
-        CLType inner_type;
-        inner_type.type = obj.begin()->second;
+        CLType inner_type(obj.begin()->second);
 
         // object to be parsed below
         CLTypeParsedRVA parsed_obj;
@@ -313,6 +551,15 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_ty
         // List parsing
         else if (type_name == "List")
         {
+            if (inner_type.Type().which() == 0)
+            {
+                if (auto array = parsedArrayFromJson(j, boost::get<CLTypeEnum>(inner_type.Type())))
+                {
+                    p = std::move(*array);
+                    return;
+                }
+            }
+
             std::vector<CLTypeParsedRVA> parsed_list;
 
             // parse with inner type
@@ -334,11 +581,8 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_ty
             CLTypeParsedRVA parsed_err;
 
             // types
-            CLType ok_type;
-            ok_type.type = obj.at("Ok");
-
-            CLType err_type;
-            err_type.type = obj.at("Err");
+            CLType ok_type(obj.at("Ok"));
+            CLType err_type(obj.at("Err"));
 
             std::string bytes_parsed = j.at("bytes").get<std::string>();
 
@@ -366,19 +610,17 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_ty
         }
     }
     // Tuple1, Tuple2, and Tuple3
-    else if (cl_type_.type.which() == 4)
+    else if (cl_type_.Type().which() == 4)
     {
         std::vector<CLTypeParsedRVA> parsed_list;
 
-        auto inner_types = boost::get<std::map<std::string, std::vector<CLTypeRVA>>>(cl_type_.type).begin()->second;
-
-        CLType inner_type;
+        auto inner_types = boost::get<std::map<std::string, std::vector<CLTypeRVA>>>(cl_type_.Type()).begin()->second;
 
         uint8_t tuple_idx = 0;
         for (auto& item : j)
         {
             CLTypeParsedRVA parsed_item;
-            inner_type.type = inner_types[tuple_idx++];
+            CLType inner_type(inner_types[tuple_idx++]);
             from_json(item, parsed_item, inner_type);
             parsed_list.push_back(parsed_item);
         }
@@ -386,7 +628,7 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p, CLType& cl_ty
         p = parsed_list;
     }
     // ByteArray
-    else if (cl_type_.type.which() == 5)
+    else if (cl_type_.Type().which() == 5)
     {
         p = j.get<std::string>();
     }
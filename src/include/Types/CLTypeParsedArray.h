@@ -0,0 +1,174 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Types/CLType.h"
+
+namespace Casper
+{
+/// <summary>
+/// Parsed List of a fixed width primitive, stored as one contiguous array of
+/// little-endian elements instead of one CLTypeParsedRVA per element. Bool,
+/// U8, I32, U32, I64 and U64 elements keep their serialized width. U128, U256
+/// and U512 elements take 8 bytes, so only lists whose values all fit in 64
+/// bits are stored this way; other lists stay a std::vector<CLTypeParsedRVA>.
+/// </summary>
+class CLTypeParsedArray
+{
+public:
+    CLTypeParsedArray() = default;
+
+    explicit CLTypeParsedArray(CLTypeEnum element_type)
+        : _element_type(element_type),
+          _element_size(static_cast<uint8_t>(ElementSize(element_type)))
+    {
+        if (_element_size == 0)
+        {
+            throw std::invalid_argument("CLTypeParsedArray: unsupported element type " +
+                                        std::to_string(static_cast<int>(element_type)));
+        }
+    }
+
+    /// <summary>
+    /// Bytes taken by one element of the given type, 0 if the array can not
+    /// hold that type.
+    /// </summary>
+    static size_t ElementSize(CLTypeEnum element_type)
+    {
+        switch (element_type)
+        {
+        case CLTypeEnum::Bool:
+        case CLTypeEnum::U8:
+            return 1;
+        case CLTypeEnum::I32:
+        case CLTypeEnum::U32:
+            return 4;
+        case CLTypeEnum::I64:
+        case CLTypeEnum::U64:
+        case CLTypeEnum::U128:
+        case CLTypeEnum::U256:
+        case CLTypeEnum::U512:
+            return 8;
+        default:
+            return 0;
+        }
+    }
+
+    /// <summary>
+    /// True for U128, U256 and U512: their elements are narrowed to 64 bits
+    /// and are serialized with a length byte rather than at a fixed width.
+    /// </summary>
+    static bool IsBigUnsigned(CLTypeEnum element_type)
+    {
+        return element_type == CLTypeEnum::U128 || element_type == CLTypeEnum::U256 ||
+               element_type == CLTypeEnum::U512;
+    }
+
+    CLTypeEnum ElementType() const { return _element_type; }
+
+    size_t Size() const { return _data.size() / _element_size; }
+
+    bool Empty() const { return _data.empty(); }
+
+    void Reserve(size_t count) { _data.reserve(count * _element_size); }
+
+    /// <summary>
+    /// Appends elements already laid out as the array stores them, e.g. the
+    /// bytesrepr of the elements of a List&lt;U64&gt;.
+    /// </summary>
+    void Append(std::span<const uint8_t> bytes)
+    {
+        if (bytes.size() % _element_size != 0)
+        {
+            throw std::invalid_argument("CLTypeParsedArray: " + std::to_string(bytes.size()) +
+                                        " bytes is not a whole number of elements");
+        }
+        _data.insert(_data.end(), bytes.begin(), bytes.end());
+    }
+
+    /// <summary>
+    /// Appends one element, `value` is truncated to the element width.
+    /// </summary>
+    void PushBack(uint64_t value)
+    {
+        for (size_t i = 0; i < _element_size; i++)
+        {
+            _data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    /// <summary>
+    /// Element `index` converted to T, e.g. Get&lt;int32_t&gt;(i) for a
+    /// List&lt;I32&gt; or Get&lt;uint64_t&gt;(i) for a List&lt;U512&gt;.
+    /// </summary>
+    template <typename T>
+    T Get(size_t index) const
+    {
+        if (index >= Size())
+        {
+            throw std::out_of_range("CLTypeParsedArray: index " + std::to_string(index) + " out of range");
+        }
+        return static_cast<T>(Load(index));
+    }
+
+    /// <summary>
+    /// The elements as stored, ElementSize() little-endian bytes each.
+    /// </summary>
+    std::span<const uint8_t> Data() const { return _data; }
+
+    bool operator==(const CLTypeParsedArray& b) const
+    {
+        return _element_type == b._element_type && _data == b._data;
+    }
+
+    bool operator<(const CLTypeParsedArray& b) const
+    {
+        if (_element_type != b._element_type)
+        {
+            return _element_type < b._element_type;
+        }
+        return _data < b._data;
+    }
+
+private:
+    uint64_t Load(size_t index) const
+    {
+        const uint8_t* p = _data.data() + index * _element_size;
+        if (_element_size == 1)
+        {
+            return *p;
+        }
+
+        uint64_t value = 0;
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            std::memcpy(&value, p, _element_size);
+        }
+        else
+        {
+            for (size_t i = _element_size; i-- > 0;)
+            {
+                value = (value << 8) | p[i];
+            }
+        }
+
+        // I32 elements are sign extended so that Get<int64_t> works too
+        if (_element_type == CLTypeEnum::I32)
+        {
+            value = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(value)));
+        }
+        return value;
+    }
+
+    CLTypeEnum _element_type = CLTypeEnum::U8;
+    uint8_t _element_size = 1;
+    std::vector<uint8_t> _data;
+};
+
+} // namespace Casper
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "Base.h"
+
+namespace Casper
+{
+/// <summary>
+/// U512 value of a CLTypeParsedRVA. Values that fit in 64 bits, as most
+/// amounts, balances and stakes do, are stored inline; only larger ones take
+/// a uint512_t on the heap. Converts to and from uint512_t implicitly.
+/// </summary>
+class CLTypeParsedU512
+{
+public:
+    CLTypeParsedU512() = default;
+
+    CLTypeParsedU512(const uint512_t& value)
+    {
+        if (value > std::numeric_limits<uint64_t>::max())
+        {
+            _big = std::make_unique<uint512_t>(value);
+        }
+        else
+        {
+            _small = static_cast<uint64_t>(value);
+        }
+    }
+
+    CLTypeParsedU512(const CLTypeParsedU512& other)
+        : _small(other._small),
+          _big(other._big ? std::make_unique<uint512_t>(*other._big) : nullptr)
+    {
+    }
+
+    CLTypeParsedU512(CLTypeParsedU512&& other) noexcept = default;
+
+    CLTypeParsedU512& operator=(const CLTypeParsedU512& other)
+    {
+        if (this != &other)
+        {
+            _small = other._small;
+            _big = other._big ? std::make_unique<uint512_t>(*other._big) : nullptr;
+        }
+        return *this;
+    }
+
+    CLTypeParsedU512& operator=(CLTypeParsedU512&& other) noexcept = default;
+
+    uint512_t Value() const { return _big ? *_big : uint512_t(_small); }
+
+    operator uint512_t() const { return Value(); }
+
+    /// <summary>
+    /// True if the value fits in 64 bits and is stored inline.
+    /// </summary>
+    bool IsSmall() const { return !_big; }
+
+    bool operator==(const CLTypeParsedU512& other) const
+    {
+        if (IsSmall() && other.IsSmall())
+        {
+            return _small == other._small;
+        }
+        return Value() == other.Value();
+    }
+
+    bool operator<(const CLTypeParsedU512& other) const
+    {
+        if (IsSmall() && other.IsSmall())
+        {
+            return _small < other._small;
+        }
+        return Value() < other.Value();
+    }
+
+private:
+    uint64_t _small = 0;
+    std::unique_ptr<uint512_t> _big;
+};
+
+} // namespace Casper
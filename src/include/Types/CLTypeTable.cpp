@@ -0,0 +1,306 @@
+#include "Types/CLTypeTable.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace Casper
+{
+namespace
+{
+/// Appends the tag of the type followed by the encodings of its inner types,
+/// or by the i32 length for a ByteArray.
+void appendEncoding(std::vector<uint8_t>& bytes, const CLTypeRVA& type)
+{
+    switch (type.which())
+    {
+    case 0:
+    {
+        auto tag = boost::get<CLTypeEnum>(type);
+        if (!CLTypeTable::IsPrimitive(tag))
+        {
+            throw std::invalid_argument("CLTypeTable: " + std::string(magic_enum::enum_name(tag)) +
+                                        " is not a primitive type");
+        }
+        bytes.push_back(static_cast<uint8_t>(tag));
+        return;
+    }
+    case 2:
+    {
+        const auto& mp = boost::get<std::map<CLTypeRVA, CLTypeRVA>>(type);
+        bytes.push_back(static_cast<uint8_t>(CLTypeEnum::Map));
+        appendEncoding(bytes, mp.begin()->first);
+        appendEncoding(bytes, mp.begin()->second);
+        return;
+    }
+    case 3:
+    {
+        const auto& inner = *boost::get<std::map<std::string, CLTypeRVA>>(type).begin();
+        if (inner.first == "Option" || inner.first == "List")
+        {
+            bytes.push_back(static_cast<uint8_t>(inner.first == "Option" ? CLTypeEnum::Option : CLTypeEnum::List));
+            appendEncoding(bytes, inner.second);
+            return;
+        }
+        if (inner.first == "Result")
+        {
+            const auto& result = boost::get<std::map<std::string, CLTypeRVA>>(inner.second);
+            bytes.push_back(static_cast<uint8_t>(CLTypeEnum::Result));
+            appendEncoding(bytes, result.at("Ok"));
+            appendEncoding(bytes, result.at("Err"));
+            return;
+        }
+        throw std::invalid_argument("CLTypeTable: inner_type_name = " + inner.first + " not implemented");
+    }
+    case 4:
+    {
+        const auto& tuple = *boost::get<std::map<std::string, std::vector<CLTypeRVA>>>(type).begin();
+        size_t count = tuple.second.size();
+        if (tuple.first != "Tuple" + std::to_string(count) || count < 1 || count > 3)
+        {
+            throw std::invalid_argument("CLTypeTable: invalid tuple " + tuple.first);
+        }
+        bytes.push_back(static_cast<uint8_t>(CLTypeEnum::Tuple1) + static_cast<uint8_t>(count - 1));
+        for (const auto& item : tuple.second)
+        {
+            appendEncoding(bytes, item);
+        }
+        return;
+    }
+    case 5:
+    {
+        const auto& byte_array = *boost::get<std::map<std::string, int32_t>>(type).begin();
+        if (byte_array.first != "ByteArray")
+        {
+            throw std::invalid_argument("CLTypeTable: unknown type with idx:5 not bytearray");
+        }
+        bytes.push_back(static_cast<uint8_t>(CLTypeEnum::ByteArray));
+        auto size = static_cast<uint32_t>(byte_array.second);
+        for (int i = 0; i < 4; i++)
+        {
+            bytes.push_back(static_cast<uint8_t>((size >> (8 * i)) & 0xff));
+        }
+        return;
+    }
+    default:
+        throw std::invalid_argument("CLTypeTable: type_idx = " + std::to_string(type.which()) + " not implemented");
+    }
+}
+
+} // namespace
+
+CLTypeTable& CLTypeTable::Instance()
+{
+    static CLTypeTable table(MAX_TYPES);
+    return table;
+}
+
+CLTypeTable::CLTypeTable(size_t max_types)
+    : _max_types(max_types)
+{
+    // Primitives get their tag value as handle, the gaps left by the
+    // composite tags are filled with placeholders that are never handed out.
+    for (uint8_t tag = 0; tag <= static_cast<uint8_t>(CLTypeEnum::PublicKey); tag++)
+    {
+        CLTypeDescriptor descriptor;
+        descriptor.tag = static_cast<CLTypeEnum>(tag);
+        descriptor.bytes = {tag};
+        descriptor.type = descriptor.tag;
+        if (IsPrimitive(descriptor.tag))
+        {
+            to_json(descriptor.json, descriptor.type);
+            _handles.emplace(std::string(1, static_cast<char>(tag)), tag);
+        }
+        _descriptors.push_back(std::move(descriptor));
+    }
+}
+
+CLTypeHandle CLTypeTable::Intern(const CLTypeRVA& type)
+{
+    switch (type.which())
+    {
+    case 0:
+    {
+        auto tag = boost::get<CLTypeEnum>(type);
+        if (!IsPrimitive(tag))
+        {
+            throw std::invalid_argument("CLTypeTable: " + std::string(magic_enum::enum_name(tag)) +
+                                        " is not a primitive type");
+        }
+        return static_cast<CLTypeHandle>(tag);
+    }
+    case 2:
+    {
+        const auto& mp = boost::get<std::map<CLTypeRVA, CLTypeRVA>>(type);
+        return Intern(CLTypeEnum::Map, {Intern(mp.begin()->first), Intern(mp.begin()->second)}, 0);
+    }
+    case 3:
+    {
+        const auto& inner = *boost::get<std::map<std::string, CLTypeRVA>>(type).begin();
+        if (inner.first == "Option")
+        {
+            return Intern(CLTypeEnum::Option, {Intern(inner.second)}, 0);
+        }
+        if (inner.first == "List")
+        {
+            return Intern(CLTypeEnum::List, {Intern(inner.second)}, 0);
+        }
+        if (inner.first == "Result")
+        {
+            const auto& result = boost::get<std::map<std::string, CLTypeRVA>>(inner.second);
+            return Intern(CLTypeEnum::Result, {Intern(result.at("Ok")), Intern(result.at("Err"))}, 0);
+        }
+        throw std::invalid_argument("CLTypeTable: inner_type_name = " + inner.first + " not implemented");
+    }
+    case 4:
+    {
+        const auto& tuple = *boost::get<std::map<std::string, std::vector<CLTypeRVA>>>(type).begin();
+        std::vector<CLTypeHandle> inner;
+        for (const auto& item : tuple.second)
+        {
+            inner.push_back(Intern(item));
+        }
+        if (tuple.first == "Tuple1" && inner.size() == 1)
+        {
+            return Intern(CLTypeEnum::Tuple1, std::move(inner), 0);
+        }
+        if (tuple.first == "Tuple2" && inner.size() == 2)
+        {
+            return Intern(CLTypeEnum::Tuple2, std::move(inner), 0);
+        }
+        if (tuple.first == "Tuple3" && inner.size() == 3)
+        {
+            return Intern(CLTypeEnum::Tuple3, std::move(inner), 0);
+        }
+        throw std::invalid_argument("CLTypeTable: invalid tuple " + tuple.first);
+    }
+    case 5:
+    {
+        const auto& byte_array = *boost::get<std::map<std::string, int32_t>>(type).begin();
+        if (byte_array.first != "ByteArray")
+        {
+            throw std::invalid_argument("CLTypeTable: unknown type with idx:5 not bytearray");
+        }
+        return Intern(CLTypeEnum::ByteArray, {}, byte_array.second);
+    }
+    default:
+        throw std::invalid_argument("CLTypeTable: type_idx = " + std::to_string(type.which()) + " not implemented");
+    }
+}
+
+CLTypeHandle CLTypeTable::Intern(CLTypeEnum tag, std::vector<CLTypeHandle> inner, int32_t byte_array_size)
+{
+    // The bytesrepr encoding is the tag followed by the encodings of the inner
+    // types, or by the i32 length for a ByteArray.
+    if (std::find(inner.begin(), inner.end(), CL_TYPE_NOT_INTERNED) != inner.end())
+    {
+        return CL_TYPE_NOT_INTERNED;
+    }
+
+    std::string key(1, static_cast<char>(tag));
+    if (tag == CLTypeEnum::ByteArray)
+    {
+        auto size = static_cast<uint32_t>(byte_array_size);
+        for (int i = 0; i < 4; i++)
+        {
+            key.push_back(static_cast<char>((size >> (8 * i)) & 0xff));
+        }
+    }
+    {
+        std::shared_lock lock(_mutex);
+        for (auto handle : inner)
+        {
+            const auto& bytes = _descriptors[handle].bytes;
+            key.append(bytes.begin(), bytes.end());
+        }
+        auto it = _handles.find(key);
+        if (it != _handles.end())
+        {
+            return it->second;
+        }
+    }
+
+    CLTypeDescriptor descriptor;
+    descriptor.tag = tag;
+    descriptor.byte_array_size = byte_array_size;
+    descriptor.bytes.assign(key.begin(), key.end());
+    {
+        std::shared_lock lock(_mutex);
+        descriptor.type = MakeType(tag, inner, byte_array_size);
+    }
+    to_json(descriptor.json, descriptor.type);
+    descriptor.inner = std::move(inner);
+
+    std::unique_lock lock(_mutex);
+    if (_handles.size() >= _max_types && _handles.find(key) == _handles.end())
+    {
+        return CL_TYPE_NOT_INTERNED;
+    }
+    auto [it, inserted] = _handles.emplace(std::move(key), static_cast<CLTypeHandle>(_descriptors.size()));
+    if (inserted)
+    {
+        _descriptors.push_back(std::move(descriptor));
+    }
+    return it->second;
+}
+
+CLTypeRVA CLTypeTable::MakeType(CLTypeEnum tag, const std::vector<CLTypeHandle>& inner,
+                                int32_t byte_array_size) const
+{
+    auto innerType = [&](size_t i) { return _descriptors[inner.at(i)].type; };
+
+    switch (tag)
+    {
+    case CLTypeEnum::Option:
+        return std::map<std::string, CLTypeRVA>{{"Option", innerType(0)}};
+    case CLTypeEnum::List:
+        return std::map<std::string, CLTypeRVA>{{"List", innerType(0)}};
+    case CLTypeEnum::Result:
+    {
+        std::map<std::string, CLTypeRVA> ok_err{{"Ok", innerType(0)}, {"Err", innerType(1)}};
+        return std::map<std::string, CLTypeRVA>{{"Result", ok_err}};
+    }
+    case CLTypeEnum::Map:
+        return std::map<CLTypeRVA, CLTypeRVA>{{innerType(0), innerType(1)}};
+    case CLTypeEnum::Tuple1:
+    case CLTypeEnum::Tuple2:
+    case CLTypeEnum::Tuple3:
+    {
+        std::vector<CLTypeRVA> items;
+        for (size_t i = 0; i < inner.size(); i++)
+        {
+            items.push_back(innerType(i));
+        }
+        return std::map<std::string, std::vector<CLTypeRVA>>{{"Tuple" + std::to_string(inner.size()), items}};
+    }
+    case CLTypeEnum::ByteArray:
+        return std::map<std::string, int32_t>{{"ByteArray", byte_array_size}};
+    default:
+        return tag;
+    }
+}
+
+const CLTypeDescriptor& CLTypeTable::Get(CLTypeHandle handle) const
+{
+    std::shared_lock lock(_mutex);
+    if (handle >= _descriptors.size() || (handle <= static_cast<CLTypeHandle>(CLTypeEnum::PublicKey) &&
+                                          !IsPrimitive(static_cast<CLTypeEnum>(handle))))
+    {
+        throw std::out_of_range("CLTypeTable: invalid handle " + std::to_string(handle));
+    }
+    return _descriptors[handle];
+}
+
+size_t CLTypeTable::Size() const
+{
+    std::shared_lock lock(_mutex);
+    return _handles.size();
+}
+
+std::vector<uint8_t> CLTypeTable::Encode(const CLTypeRVA& type)
+{
+    std::vector<uint8_t> bytes;
+    appendEncoding(bytes, type);
+    return bytes;
+}
+
+} // namespace Casper
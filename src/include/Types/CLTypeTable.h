@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Types/CLType.h"
+#include "nlohmann/json.hpp"
+
+namespace Casper
+{
+/// <summary>
+/// One distinct CLType, stored once in the CLTypeTable.
+/// </summary>
+struct CLTypeDescriptor
+{
+    /// <summary>
+    /// Outermost type tag.
+    /// </summary>
+    CLTypeEnum tag;
+
+    /// <summary>
+    /// Inner types: the element of Option and List, Ok and Err of Result, key
+    /// and value of Map, the members of a Tuple. Empty for the rest.
+    /// </summary>
+    std::vector<CLTypeHandle> inner;
+
+    /// <summary>
+    /// Length of a ByteArray, 0 for the other types.
+    /// </summary>
+    int32_t byte_array_size = 0;
+
+    /// <summary>
+    /// bytesrepr encoding of the type, i.e. its tags.
+    /// </summary>
+    std::vector<uint8_t> bytes;
+
+    /// <summary>
+    /// The type tree, built once from the inner descriptors and shared by
+    /// every CLType of this type.
+    /// </summary>
+    CLTypeRVA type;
+
+    /// <summary>
+    /// JSON form of the type as written in a CLValue "cl_type" field.
+    /// </summary>
+    nlohmann::json json;
+};
+
+/// <summary>
+/// Process wide table of interned CLTypes. Each distinct type gets one
+/// descriptor carrying its precomputed bytesrepr encoding and JSON, so comparing,
+/// hashing and serializing types seen before costs O(1).
+/// Primitive types are preregistered with their tag value as handle.
+/// Thread safe, descriptors are never removed or moved.
+/// The types come from node responses too, so the table stops growing at
+/// MAX_TYPES; later types are left out and encoded with Encode() instead.
+/// </summary>
+class CLTypeTable
+{
+public:
+    /// <summary>
+    /// Most distinct types a table holds, primitives included.
+    /// </summary>
+    static constexpr size_t MAX_TYPES = 4096;
+
+    static CLTypeTable& Instance();
+
+    /// <summary>
+    /// A table separate from Instance(), holding at most `max_types` types.
+    /// </summary>
+    explicit CLTypeTable(size_t max_types);
+
+    /// <summary>
+    /// Returns the handle for the given type, adding it to the table if it
+    /// was not there yet. Returns CL_TYPE_NOT_INTERNED if it was not there
+    /// and the table is full.
+    /// </summary>
+    CLTypeHandle Intern(const CLTypeRVA& type);
+
+    CLTypeHandle Intern(const CLType& type) { return Intern(type.Type()); }
+
+    /// <summary>
+    /// Returns the descriptor of an interned type.
+    /// </summary>
+    const CLTypeDescriptor& Get(CLTypeHandle handle) const;
+
+    /// <summary>
+    /// Number of distinct types interned so far.
+    /// </summary>
+    size_t Size() const;
+
+    /// <summary>
+    /// bytesrepr encoding of any type, without interning it.
+    /// </summary>
+    static std::vector<uint8_t> Encode(const CLTypeRVA& type);
+
+    /// <summary>
+    /// Bool up to URef, plus Any and PublicKey: the tags that are a type on
+    /// their own, without inner types.
+    /// </summary>
+    static bool IsPrimitive(CLTypeEnum tag)
+    {
+        return tag <= CLTypeEnum::URef || tag == CLTypeEnum::Any || tag == CLTypeEnum::PublicKey;
+    }
+
+private:
+
+    CLTypeHandle Intern(CLTypeEnum tag, std::vector<CLTypeHandle> inner, int32_t byte_array_size);
+
+    /// Builds the tree of a composite type from the trees of its inner
+    /// types, the caller holds _mutex.
+    CLTypeRVA MakeType(CLTypeEnum tag, const std::vector<CLTypeHandle>& inner, int32_t byte_array_size) const;
+
+    size_t _max_types;
+
+    mutable std::shared_mutex _mutex;
+    std::deque<CLTypeDescriptor> _descriptors;
+
+    /// Keyed by the bytesrepr encoding, which is unique per type.
+    std::unordered_map<std::string, CLTypeHandle> _handles;
+};
+
+} // namespace Casper
@@ -1,60 +1,99 @@
 #include "Types/CLValue.h"
+#include "ByteSerializers/CLValueByteSerializer.h"
 
 namespace Casper
 {
 
+const CLTypeParsedRVA& CLValue::GetParsed() const
+{
+    ParsedCache& cache = *_parsed;
+    std::call_once(cache.once,
+                   [&]
+                   {
+                       if (cache.value.has_value())
+                       {
+                           return;
+                       }
+
+                       CLTypeParsed parsed;
+                       if (cache.json)
+                       {
+                           CLType type = _cl_type;
+                           from_json(nlohmann::json::parse(*cache.json), parsed, type);
+                       }
+                       else
+                       {
+                           CLValueByteSerializer serializer;
+                           std::span<const uint8_t> data(_bytes.data(), _bytes.size());
+                           parsed.parsed = serializer.ParsedFromBytes(data, _cl_type.Type());
+                       }
+                       cache.value = std::move(parsed);
+                   });
+    return cache.value->parsed;
+}
+
+void CLValue::ParsedToJson(nlohmann::json& j) const
+{
+    if (_parsed->json)
+    {
+        j = nlohmann::json::parse(*_parsed->json);
+        return;
+    }
+    to_json(j, GetParsed());
+}
+
 bool CLValue::operator<(const CLValue& b) const
 {
-    if (this->bytes.size() < b.bytes.size())
+    if (_bytes.size() < b._bytes.size())
     {
         return true;
     }
-    else if (this->cl_type.type.which() < b.cl_type.type.which())
+    else if (_cl_type.Type().which() < b._cl_type.Type().which())
     {
         return true;
     }
-    else if (parsed.parsed.which() < b.parsed.parsed.which())
+    else if (GetParsed().which() < b.GetParsed().which())
     {
         return true;
     }
-    else if (bytes.data() < b.bytes.data())
+    else if (_bytes.data() < b._bytes.data())
     {
         return true;
     }
     else
     {
-        if (cl_type.type.which() == 0)
+        if (_cl_type.Type().which() == 0)
         {
-            CLTypeEnum type = boost::get<CLTypeEnum>(cl_type.type);
+            CLTypeEnum type = boost::get<CLTypeEnum>(_cl_type.Type());
 
             switch (type)
             {
             case CLTypeEnum::Bool:
-                return boost::get<bool>(parsed.parsed) < boost::get<bool>(b.parsed.parsed);
+                return boost::get<bool>(GetParsed()) < boost::get<bool>(b.GetParsed());
             case CLTypeEnum::I32:
-                return boost::get<int32_t>(parsed.parsed) < boost::get<int32_t>(b.parsed.parsed);
+                return boost::get<int32_t>(GetParsed()) < boost::get<int32_t>(b.GetParsed());
             case CLTypeEnum::I64:
-                return boost::get<int64_t>(parsed.parsed) < boost::get<int64_t>(b.parsed.parsed);
+                return boost::get<int64_t>(GetParsed()) < boost::get<int64_t>(b.GetParsed());
             case CLTypeEnum::U8:
-                return boost::get<uint8_t>(parsed.parsed) < boost::get<uint8_t>(b.parsed.parsed);
+                return boost::get<uint8_t>(GetParsed()) < boost::get<uint8_t>(b.GetParsed());
             case CLTypeEnum::U32:
-                return boost::get<uint32_t>(parsed.parsed) < boost::get<uint32_t>(b.parsed.parsed);
+                return boost::get<uint32_t>(GetParsed()) < boost::get<uint32_t>(b.GetParsed());
             case CLTypeEnum::U64:
-                return boost::get<uint64_t>(parsed.parsed) < boost::get<uint64_t>(b.parsed.parsed);
+                return boost::get<uint64_t>(GetParsed()) < boost::get<uint64_t>(b.GetParsed());
             case CLTypeEnum::U128:
-                return boost::get<uint128_t>(parsed.parsed) < boost::get<uint128_t>(b.parsed.parsed);
+                return boost::get<uint128_t>(GetParsed()) < boost::get<uint128_t>(b.GetParsed());
             case CLTypeEnum::U256:
-                return boost::get<uint256_t>(parsed.parsed) < boost::get<uint256_t>(b.parsed.parsed);
+                return boost::get<uint256_t>(GetParsed()) < boost::get<uint256_t>(b.GetParsed());
             case CLTypeEnum::U512:
-                return boost::get<uint512_t>(parsed.parsed) < boost::get<uint512_t>(b.parsed.parsed);
+                return boost::get<CLTypeParsedU512>(GetParsed()) < boost::get<CLTypeParsedU512>(b.GetParsed());
             case CLTypeEnum::Unit:
                 return true;
             case CLTypeEnum::String:
-                return boost::get<std::string>(parsed.parsed) < boost::get<std::string>(b.parsed.parsed);
+                return boost::get<std::string>(GetParsed()) < boost::get<std::string>(b.GetParsed());
             case CLTypeEnum::Key:
-                return boost::get<GlobalStateKey>(parsed.parsed).key < boost::get<GlobalStateKey>(b.parsed.parsed).key;
+                return boost::get<GlobalStateKey>(GetParsed()) < boost::get<GlobalStateKey>(b.GetParsed());
             case CLTypeEnum::URef:
-                return boost::get<Casper::URef>(parsed.parsed) < boost::get<Casper::URef>(b.parsed.parsed);
+                return boost::get<Casper::URef>(GetParsed()) < boost::get<Casper::URef>(b.GetParsed());
 
             default:
                 return false;
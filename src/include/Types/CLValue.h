@@ -6,6 +6,9 @@
 #include "Types/CLTypeParsed.h"
 #include "Utils/CEP57Checksum.h"
 #include <cryptopp/secblock.h>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include "nlohmann/json.hpp"
 
 namespace Casper
@@ -16,56 +19,123 @@ namespace Casper
 ///
 /// It holds the underlying data as a type-erased, serialized `Vec<u8>` and also
 /// holds the [`CLType`] of the underlying data as a separate member.
+/// The parsed value is cached, so the bytes and the type are only changed
+/// through SetBytes() and SetType(), which drop the cache.
 struct CLValue
 {
-    CLType cl_type;
-
-    CBytes bytes;
-
-    CLTypeParsed parsed;
-
-    CLValue() {}
+    CLValue()
+        : _parsed(std::make_shared<ParsedCache>())
+    {
+    }
 
     CLValue(CBytes bytes, CLType cl_type)
-        : cl_type(cl_type)
-        , bytes(bytes)
+        : _cl_type(cl_type)
+        , _bytes(bytes)
+        , _parsed(std::make_shared<ParsedCache>())
     {
     }
 
     CLValue(CBytes bytes, CLType cl_type, CLTypeParsed parsed)
-        : cl_type(cl_type)
-        , bytes(bytes)
-        , parsed(parsed)
+        : _cl_type(cl_type)
+        , _bytes(bytes)
+        , _parsed(ParsedCache::Of(parsed))
     {
     }
 
     CLValue(CBytes bytes, CLType cl_type, CLTypeParsedRVA parsed)
-        : cl_type(cl_type)
-        , bytes(bytes)
-        , parsed(parsed)
+        : _cl_type(cl_type)
+        , _bytes(bytes)
+        , _parsed(ParsedCache::Of(parsed))
     {
     }
 
     CLValue(CBytes bytes, CLTypeRVA cl_type, CLTypeParsedRVA parsed)
-        : cl_type(cl_type)
-        , bytes(bytes)
-        , parsed(parsed)
+        : _cl_type(cl_type)
+        , _bytes(bytes)
+        , _parsed(ParsedCache::Of(parsed))
     {
     }
 
     CLValue(CBytes bytes, CLTypeRVA cl_type)
-        : cl_type(cl_type)
-        , bytes(bytes)
+        : _cl_type(cl_type)
+        , _bytes(bytes)
+        , _parsed(std::make_shared<ParsedCache>())
     {
     }
 
     CLValue(std::string hex_bytes, CLTypeRVA cl_type, CLTypeParsedRVA parsed)
+        : _cl_type(cl_type)
+        , _bytes(hexDecode(hex_bytes))
+        , _parsed(ParsedCache::Of(parsed))
+    {
+    }
+
+    /// <summary>
+    /// The serialized value.
+    /// </summary>
+    const CBytes& GetBytes() const { return _bytes; }
+
+    /// <summary>
+    /// Replaces the serialized value. The parsed value is built again from
+    /// the new bytes on next access.
+    /// </summary>
+    void SetBytes(CBytes bytes)
     {
-        bytes = hexDecode(hex_bytes);
-        cl_type = cl_type;
-        parsed = parsed;
+        _bytes = std::move(bytes);
+        _parsed = std::make_shared<ParsedCache>();
     }
 
+    /// <summary>
+    /// The type of the value.
+    /// </summary>
+    const CLType& GetType() const { return _cl_type; }
+
+    /// <summary>
+    /// Replaces the type of the value. The parsed value is built again for
+    /// the new type on next access.
+    /// </summary>
+    void SetType(CLType cl_type)
+    {
+        _cl_type = std::move(cl_type);
+        _parsed = std::make_shared<ParsedCache>();
+    }
+
+    /// <summary>
+    /// Returns the parsed value. It is built on first access, from the json
+    /// `parsed` node kept by from_json or by decoding `bytes`, and cached.
+    /// Safe to call from several threads, the value is built only once.
+    /// </summary>
+    const CLTypeParsedRVA& GetParsed() const;
+
+    /// <summary>
+    /// Replaces the parsed value.
+    /// </summary>
+    void SetParsed(CLTypeParsedRVA parsed) { _parsed = ParsedCache::Of(std::move(parsed)); }
+
+    /// <summary>
+    /// Keeps the text of the json `parsed` node, to be parsed and converted
+    /// on first access instead of building the parsed value now. One string
+    /// is much cheaper to keep than a copy of the json tree.
+    /// </summary>
+    void SetParsedJson(const nlohmann::json& parsed_json)
+    {
+        auto cache = std::make_shared<ParsedCache>();
+        cache->json = parsed_json.dump();
+        _parsed = std::move(cache);
+    }
+
+    /// <summary>
+    /// The json text of the `parsed` node kept by from_json, or nullptr if
+    /// the value was not read from json.
+    /// </summary>
+    const std::string* ParsedJsonText() const { return _parsed->json ? &*_parsed->json : nullptr; }
+
+    /// <summary>
+    /// Writes the json `parsed` node, the one kept by from_json as it was
+    /// read.
+    /// </summary>
+    void ParsedToJson(nlohmann::json& j) const;
+
     bool operator<(const CLValue& b) const;
 
     /// <summary>
@@ -135,7 +205,7 @@ struct CLValue
     /// </summary>
     static CLValue U128(uint128_t value)
     {
-        CBytes bytes = hexDecode(u128ToHex(value));
+        CBytes bytes = u128ToBytes(value);
 
         return CLValue(bytes, CLTypeEnum::U128, u128ToDec(value));
     }
@@ -145,7 +215,7 @@ struct CLValue
     /// </summary>
     static CLValue U256(uint256_t value)
     {
-        CBytes bytes = hexDecode(u256ToHex(value));
+        CBytes bytes = u256ToBytes(value);
 
         return CLValue(bytes, CLTypeEnum::U256, u256ToDec(value));
     }
@@ -155,9 +225,7 @@ struct CLValue
     /// </summary>
     static CLValue U512(uint512_t value)
     {
-        // std::cout << "u512ToHex: " << u512ToHex(value) << std::endl;
-        CBytes bytes = hexDecode(u512ToHex(value));
-        // std::cout << "after bytes" << std::endl;
+        CBytes bytes = u512ToBytes(value);
         return CLValue(bytes, CLTypeEnum::U512, u512ToDec(value));
     }
 
@@ -175,9 +243,10 @@ struct CLValue
     /// </summary>
     static CLValue String(std::string value)
     {
-        CBytes bytes = hexDecode(stringEncode(value));
+        ByteWriter bytes(sizeof(uint32_t) + value.size());
+        bytes.WriteString(value);
 
-        return CLValue(bytes, CLTypeEnum::String, value);
+        return CLValue(bytes.ToBytes(), CLTypeEnum::String, value);
     }
 
     /// <summary>
@@ -188,7 +257,7 @@ struct CLValue
         Casper::URef uref(value);
         CBytes bytes(33);
 
-        std::copy(uref.raw_bytes.begin(), uref.raw_bytes.end(), bytes.begin());
+        std::copy(uref.payload.begin(), uref.payload.end(), bytes.begin());
 
         bytes[32] = (CryptoPP::byte)uref.access_rights;
 
@@ -202,7 +271,7 @@ struct CLValue
     {
         CBytes bytes(33);
 
-        std::copy(value.raw_bytes.begin(), value.raw_bytes.end(), bytes.begin());
+        std::copy(value.payload.begin(), value.payload.end(), bytes.begin());
         bytes[32] = (CryptoPP::byte)value.access_rights;
         return CLValue(bytes, CLTypeEnum::URef, value.ToString());
     }
@@ -214,18 +283,16 @@ struct CLValue
     static CLValue Option(CLValue innerValue)
     {
         // std::cout << "Option(CLValue innerValue)" << std::endl;
-        //  std::cout << "size: " << innerValue.bytes.size() << std::endl;
-        CBytes bytes(1 + innerValue.bytes.size());
+        //  std::cout << "size: " << innerValue.GetBytes().size() << std::endl;
+        CBytes bytes(1 + innerValue.GetBytes().size());
         bytes[0] = 0x01;
         // std::cout << "before copy" << std::endl;
-        std::copy(innerValue.bytes.begin(), innerValue.bytes.end(), bytes.begin() + 1);
+        std::copy(innerValue.GetBytes().begin(), innerValue.GetBytes().end(), bytes.begin() + 1);
         // std::cout << "after copy" << std::endl;
 
         nlohmann::json j;
-        to_json(j, innerValue.parsed);
-        // std::cout << "innerValue.parsed: " << j.dump() << std::endl;
-        std::optional<CLTypeRVA> opt_with_inner = innerValue.cl_type.type;
-        return CLValue(bytes, CLType(opt_with_inner), innerValue.parsed);
+        std::optional<CLTypeRVA> opt_with_inner = innerValue.GetType().Type();
+        return CLValue(bytes, CLType(opt_with_inner), innerValue.GetParsed());
     }
 
     static CLValue Option(int32_t innerValue) { return CLValue::Option(CLValue::I32(innerValue)); }
@@ -263,7 +330,7 @@ struct CLValue
         CBytes bytes(1);
 
         bytes[0] = (CryptoPP::byte)0x00;
-        std::optional<CLTypeRVA> opt_with_inner = innerTypeInfo.type;
+        std::optional<CLTypeRVA> opt_with_inner = innerTypeInfo.Type();
         return CLValue(bytes, CLType(opt_with_inner), std::monostate{});
     }
 
@@ -276,8 +343,8 @@ struct CLValue
 
             bytes[0] = (CryptoPP::byte)0x00;
             std::map<CLTypeRVA, CLTypeRVA> inner_type_info;
-            inner_type_info[innerKeyTypeInfo.type] = innerValueTypeInfo.type;
-            std::optional<CLTypeRVA> opt_with_inner = CLType(inner_type_info).type;
+            inner_type_info[innerKeyTypeInfo.Type()] = innerValueTypeInfo.Type();
+            std::optional<CLTypeRVA> opt_with_inner = CLType(inner_type_info).Type();
 
             return CLValue(bytes, CLType(opt_with_inner), std::monostate{});
         }
@@ -288,13 +355,13 @@ struct CLValue
             bytes[0] = (CryptoPP::byte)0x00;
 
             std::map<std::string, CLTypeRVA> result_type_info;
-            result_type_info["Ok"] = innerKeyTypeInfo.type;
-            result_type_info["Err"] = innerValueTypeInfo.type;
+            result_type_info["Ok"] = innerKeyTypeInfo.Type();
+            result_type_info["Err"] = innerValueTypeInfo.Type();
 
             std::map<std::string, CLTypeRVA> res_info;
             res_info["Result"] = result_type_info;
 
-            std::optional<CLTypeRVA> opt_with_inner = CLType(res_info).type;
+            std::optional<CLTypeRVA> opt_with_inner = CLType(res_info).Type();
 
             return CLValue(bytes, CLType(opt_with_inner), std::monostate{});
         }
@@ -312,7 +379,7 @@ struct CLValue
         tuple1_type_info_vec.push_back(innerTypeInfo);
         tuple1_type_info["Tuple1"] = tuple1_type_info_vec;
 
-        std::optional<CLTypeRVA> opt_with_inner = CLType(tuple1_type_info).type;
+        std::optional<CLTypeRVA> opt_with_inner = CLType(tuple1_type_info).Type();
 
         return CLValue(bytes, CLType(opt_with_inner), std::monostate{});
     }
@@ -330,7 +397,7 @@ struct CLValue
         tuple2_type_info_vec.push_back(innerTypeInfo2);
         tuple2_type_info["Tuple2"] = tuple2_type_info_vec;
 
-        std::optional<CLTypeRVA> opt_with_inner = CLType(tuple2_type_info).type;
+        std::optional<CLTypeRVA> opt_with_inner = CLType(tuple2_type_info).Type();
 
         return CLValue(bytes, CLType(opt_with_inner), std::monostate{});
     }
@@ -349,7 +416,7 @@ struct CLValue
         tuple3_type_info_vec.push_back(innerTypeInfo3);
         tuple3_type_info["Tuple3"] = tuple3_type_info_vec;
 
-        std::optional<CLTypeRVA> opt_with_inner = CLType(tuple3_type_info).type;
+        std::optional<CLTypeRVA> opt_with_inner = CLType(tuple3_type_info).Type();
 
         return CLValue(bytes, CLType(opt_with_inner), std::monostate{});
     }
@@ -378,7 +445,7 @@ struct CLValue
 
         sb += bytes;
 
-        CLTypeRVA first_elem_type = values[0].cl_type.type;
+        CLTypeRVA first_elem_type = values[0].GetType().Type();
 
         std::vector<CLTypeParsedRVA> parsed_values;
         CLTypeParsedRVA parsed_elems;
@@ -386,17 +453,24 @@ struct CLValue
         // std::cout << "after typeInfo" << std::endl;
         for (auto value : values)
         {
-            sb += value.bytes;
-            parsed_values.push_back(value.parsed.parsed);
+            sb += value.GetBytes();
+            parsed_values.push_back(value.GetParsed());
 
-            if (value.cl_type.type.which() != first_elem_type.which())
+            if (value.GetType().Type().which() != first_elem_type.which())
             {
                 throw std::runtime_error("All elements in a list must be of the same type");
             }
         }
 
-        // std::cout << "after for" << std::endl;
+        // fixed width primitives are stored as the parsers store them
         parsed_elems = parsed_values;
+        if (first_elem_type.which() == 0)
+        {
+            if (auto array = parsedArrayFromList(parsed_values, boost::get<CLTypeEnum>(first_elem_type)))
+            {
+                parsed_elems = std::move(*array);
+            }
+        }
 
         return CLValue(sb, CLType(first_elem_type, CLTypeEnum::List), parsed_elems);
     }
@@ -428,15 +502,15 @@ struct CLValue
     /// </summary>
     static CLValue Ok(CLValue ok, CLType errTypeInfo)
     {
-        CLType okTypeInfo(ok.cl_type.type, errTypeInfo.type, CLTypeEnum::Result);
+        CLType okTypeInfo(ok.GetType().Type(), errTypeInfo.Type(), CLTypeEnum::Result);
 
-        CBytes sb(1 + ok.bytes.size());
+        CBytes sb(1 + ok.GetBytes().size());
 
         sb[0] = (CryptoPP::byte)0x01;
 
-        std::copy(ok.bytes.begin(), ok.bytes.end(), sb.begin() + 1);
+        std::copy(ok.GetBytes().begin(), ok.GetBytes().end(), sb.begin() + 1);
 
-        return CLValue(sb, okTypeInfo, ok.parsed);
+        return CLValue(sb, okTypeInfo, ok.GetParsed());
     }
 
     /// <summary>
@@ -445,15 +519,15 @@ struct CLValue
     /// </summary>
     static CLValue Err(CLValue err, CLType okTypeInfo)
     {
-        CLType errTypeInfo(okTypeInfo.type, err.cl_type.type, CLTypeEnum::Result);
+        CLType errTypeInfo(okTypeInfo.Type(), err.GetType().Type(), CLTypeEnum::Result);
 
-        CBytes sb(1 + err.bytes.size());
+        CBytes sb(1 + err.GetBytes().size());
 
         sb[0] = (CryptoPP::byte)0x00;
 
-        std::copy(err.bytes.begin(), err.bytes.end(), sb.begin() + 1);
+        std::copy(err.GetBytes().begin(), err.GetBytes().end(), sb.begin() + 1);
 
-        return CLValue(sb, errTypeInfo, err.parsed);
+        return CLValue(sb, errTypeInfo, err.GetParsed());
     }
 
     /// <summary>
@@ -472,21 +546,21 @@ struct CLValue
         int i = 0;
         for (auto kv : dict)
         {
-            parsed_dict[kv.first.parsed.parsed] = kv.second.parsed.parsed;
+            parsed_dict[kv.first.GetParsed()] = kv.second.GetParsed();
             if (i == 0)
             {
-                keyType = kv.first.cl_type.type;
-                valueType = kv.second.cl_type.type;
+                keyType = kv.first.GetType().Type();
+                valueType = kv.second.GetType().Type();
             }
-            else if (keyType.which() != kv.first.cl_type.type.which() ||
-                     valueType.which() != kv.second.cl_type.type.which())
+            else if (keyType.which() != kv.first.GetType().Type().which() ||
+                     valueType.which() != kv.second.GetType().Type().which())
             {
                 throw std::runtime_error("All elements in a map must be of the same "
                                          "type");
             }
 
-            bytes += kv.first.bytes;
-            bytes += kv.second.bytes;
+            bytes += kv.first.GetBytes();
+            bytes += kv.second.GetBytes();
             i++;
         }
         std::map<CLTypeRVA, CLTypeRVA> mp;
@@ -504,7 +578,7 @@ struct CLValue
 
         // Custom key and value type map
         std::map<CLTypeRVA, CLTypeRVA> mp;
-        mp[keyType.type] = valueType.type;
+        mp[keyType.Type()] = valueType.Type();
 
         CLTypeRVA ty(mp);
 
@@ -517,9 +591,9 @@ struct CLValue
     static CLValue Tuple1(CLValue t0)
     {
         std::map<std::string, std::vector<CLTypeRVA>> mp;
-        mp["Tuple1"] = {t0.cl_type.type};
+        mp["Tuple1"] = {t0.GetType().Type()};
         CLTypeRVA ty(mp);
-        return CLValue(t0.bytes, CLType(ty), t0.parsed);
+        return CLValue(t0.GetBytes(), CLType(ty), t0.GetParsed());
     }
 
     /// <summary>
@@ -527,14 +601,14 @@ struct CLValue
     /// </summary>
     static CLValue Tuple2(CLValue t0, CLValue t1)
     {
-        CBytes bytes(t0.bytes.size() + t1.bytes.size());
+        CBytes bytes(t0.GetBytes().size() + t1.GetBytes().size());
 
-        std::copy(t0.bytes.begin(), t0.bytes.end(), bytes.begin());
+        std::copy(t0.GetBytes().begin(), t0.GetBytes().end(), bytes.begin());
 
-        std::copy(t1.bytes.begin(), t1.bytes.end(), bytes.begin() + t0.bytes.size());
+        std::copy(t1.GetBytes().begin(), t1.GetBytes().end(), bytes.begin() + t0.GetBytes().size());
 
         std::map<std::string, std::vector<CLTypeRVA>> mp;
-        mp["Tuple2"] = {t0.cl_type.type, t1.cl_type.type};
+        mp["Tuple2"] = {t0.GetType().Type(), t1.GetType().Type()};
         CLTypeRVA ty(mp);
 
         return CLValue(bytes, CLType(ty), hexEncode(bytes));
@@ -545,16 +619,17 @@ struct CLValue
     /// </summary>
     static CLValue Tuple3(CLValue t0, CLValue t1, CLValue t2)
     {
-        CBytes bytes(t0.bytes.size() + t1.bytes.size() + t2.bytes.size());
+        CBytes bytes(t0.GetBytes().size() + t1.GetBytes().size() + t2.GetBytes().size());
 
-        std::copy(t0.bytes.begin(), t0.bytes.end(), bytes.begin());
+        std::copy(t0.GetBytes().begin(), t0.GetBytes().end(), bytes.begin());
 
-        std::copy(t1.bytes.begin(), t1.bytes.end(), bytes.begin() + t0.bytes.size());
+        std::copy(t1.GetBytes().begin(), t1.GetBytes().end(), bytes.begin() + t0.GetBytes().size());
 
-        std::copy(t2.bytes.begin(), t2.bytes.end(), bytes.begin() + t0.bytes.size() + t1.bytes.size());
+        std::copy(t2.GetBytes().begin(), t2.GetBytes().end(),
+                  bytes.begin() + t0.GetBytes().size() + t1.GetBytes().size());
 
         std::map<std::string, std::vector<CLTypeRVA>> mp;
-        mp["Tuple3"] = {t0.cl_type.type, t1.cl_type.type, t2.cl_type.type};
+        mp["Tuple3"] = {t0.GetType().Type(), t1.GetType().Type(), t2.GetType().Type()};
         CLTypeRVA ty(mp);
 
         return CLValue(bytes, CLType(ty), hexEncode(bytes));
@@ -587,7 +662,7 @@ struct CLValue
     /*
     static CLValue KeyFromPublicKey(Casper::PublicKey publicKey) {
       CBytes accountHash =
-          AccountHashKey(publicKey.GetAccountHash()).raw_bytes;
+          AccountHashKey(publicKey.GetAccountHash()).GetRawBytes();
 
       std::cout << "\n\n\n\n\nAccountHashKey size: " << accountHash.size()
                 << std::endl
@@ -619,6 +694,37 @@ struct CLValue
 
         return CLValue(key_serializer.ToBytes(key), CLType(CLTypeEnum::Key), key);
     }
+
+private:
+    /// Parsed value, empty until first requested, and the json `parsed` node
+    /// it is built from. Copies of a value share it; the setters replace it,
+    /// so it is only written once.
+    struct ParsedCache
+    {
+        template <typename T>
+        static std::shared_ptr<ParsedCache> Of(T&& parsed)
+        {
+            auto cache = std::make_shared<ParsedCache>();
+            cache->value = CLTypeParsed(std::forward<T>(parsed));
+            return cache;
+        }
+
+        std::once_flag once;
+        std::optional<CLTypeParsed> value;
+
+        /// Text of the json `parsed` node from from_json.
+        std::optional<std::string> json;
+    };
+
+    CLType _cl_type;
+
+    CBytes _bytes;
+
+    std::shared_ptr<ParsedCache> _parsed;
+
+    /// Sets the bytes and the type directly, SetParsedJson() gives the value
+    /// its cache.
+    friend void from_json(const nlohmann::json& j, CLValue& p);
 };
 
 // to json
@@ -626,11 +732,11 @@ inline void to_json(nlohmann::json& j, const CLValue& p)
 {
     j = nlohmann::json{};
 
-    to_json(j["cl_type"], p.cl_type);
+    to_json(j["cl_type"], p.GetType());
 
     try
     {
-        std::string tmp_bytes = hexEncode(p.bytes);
+        std::string tmp_bytes = hexEncode(p.GetBytes());
         j["bytes"] = tmp_bytes;
     }
     catch (const std::exception& e)
@@ -638,26 +744,25 @@ inline void to_json(nlohmann::json& j, const CLValue& p)
         SPDLOG_ERROR("CLValue-to_json-bytes what(): {}", e.what());
     }
 
-    to_json(j["parsed"], p.parsed);
+    p.ParsedToJson(j["parsed"]);
 }
 
 // from json
 inline void from_json(const nlohmann::json& j, CLValue& p)
 {
-    from_json(j.at("cl_type"), p.cl_type);
+    from_json(j.at("cl_type"), p._cl_type);
     try
     {
         std::string hex_bytes_str = j.at("bytes").get<std::string>();
-        p.bytes = hexDecode(hex_bytes_str);
+        p._bytes = hexDecode(hex_bytes_str);
     }
     catch (const std::exception& e)
     {
         SPDLOG_ERROR("CLValue-from_json-bytes what(): {}", e.what());
     }
 
-    // std::cout << j.at("parsed").dump(2) << std::endl;
-
-    from_json(j.at("parsed"), p.parsed, p.cl_type);
+    // the parsed value is only built when somebody asks for it
+    p.SetParsedJson(j.at("parsed"));
 }
 
 } // namespace Casper
@@ -3,6 +3,7 @@
 #include <optional>
 
 #include "Base.h"
+#include "Types/PublicKeyTable.h"
 #include "Types/URef.h"
 #include "Types/VestingSchedule.h"
 #include "nlohmann/json.hpp"
@@ -86,11 +87,11 @@ inline void from_json(const nlohmann::json& j, Delegator& p)
 
     if (j.count("validator_public_key") != 0)
     {
-        j.at("validator_public_key").get_to(p.validator_public_key);
+        internPublicKey(j.at("validator_public_key"), p.validator_public_key);
     }
     else if (j.count("delegatee") != 0)
     {
-        j.at("delegatee").get_to(p.validator_public_key);
+        internPublicKey(j.at("delegatee"), p.validator_public_key);
     }
 
     if (j.find("vesting_schedule") != j.end() && !j.at("vesting_schedule").is_null())
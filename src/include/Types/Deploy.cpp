@@ -1,6 +1,12 @@
 #include "Types/Deploy.h"
 #include "ByteSerializers/ExecutableDeployItemByteSerializer.h"
 #include "ByteSerializers/DeployByteSerializer.h"
+#include "ByteSerializers/Blake2bHashSink.h"
+#include "ByteSerializers/ByteSizeCalculator.h"
+#include "ByteSerializers/ByteWriter.h"
+#include "Utils/Blake2bBatch.h"
+
+#include <cstring>
 
 namespace Casper
 {
@@ -9,10 +15,10 @@ Deploy::Deploy(DeployHeader header, ExecutableDeployItem payment, ExecutableDepl
 {
     CBytes body_hash = ComputeBodyHash(payment, session);
 
-    this->header = DeployHeader(header.account, header.timestamp, header.ttl, header.gas_price, hexEncode(body_hash),
-                                header.dependencies, header.chain_name);
+    this->header = DeployHeader(header.account, header.timestamp, header.ttl, header.gas_price,
+                                Hash32::FromBytes(body_hash), header.dependencies, header.chain_name);
 
-    this->hash = hexEncode(ComputeHeaderHash(this->header));
+    this->hash = Hash32::FromBytes(ComputeHeaderHash(this->header));
 
     this->payment = payment;
     this->session = session;
@@ -23,7 +29,7 @@ Deploy::Deploy(DeployHeader header, ExecutableDeployItem payment, ExecutableDepl
 /// </summary>
 void Deploy::Sign(KeyPair keyPair)
 {
-    CBytes signature = keyPair.Sign(CEP57Checksum::Decode(this->hash));
+    CBytes signature = keyPair.Sign(this->hash.ToCBytes());
 
     this->approvals.emplace_back(keyPair.public_key,
                                  Signature::FromRawBytes(signature, keyPair.public_key.key_algorithm));
@@ -34,7 +40,7 @@ void Deploy::Sign(KeyPair keyPair)
 /// </summary>
 void Deploy::Sign(Secp256k1Key& sec_key)
 {
-    CBytes signature = sec_key.sign(CEP57Checksum::Decode(this->hash));
+    CBytes signature = sec_key.sign(this->hash.ToCBytes());
 
     std::string public_key_str = "02" + sec_key.getPublicKeyStr();
     this->approvals.emplace_back(Casper::PublicKey::FromHexString(public_key_str),
@@ -59,21 +65,21 @@ bool Deploy::ValidateHashes(std::string& message)
 {
     CBytes computed_hash = ComputeBodyHash(this->payment, this->session);
 
-    if (hexDecode(this->header.body_hash) != computed_hash)
+    if (this->header.body_hash.ToCBytes() != computed_hash)
     {
         message = "Computed Body Hash does not match value in deploy header. "
                   "Expected: " +
-                  this->header.body_hash + "Computed: " + CEP57Checksum::Encode(computed_hash);
+                  this->header.body_hash.ToString() + "Computed: " + CEP57Checksum::Encode(computed_hash);
         return false;
     }
 
     computed_hash = ComputeHeaderHash(this->header);
 
-    if (hexDecode(this->hash) != computed_hash)
+    if (this->hash.ToCBytes() != computed_hash)
     {
         message = "Computed Hash does not match value in deploy object. "
                   "Expected: " +
-                  this->hash + "Computed: " + CEP57Checksum::Encode(computed_hash);
+                  this->hash.ToString() + "Computed: " + CEP57Checksum::Encode(computed_hash);
         return false;
     }
 
@@ -81,6 +87,74 @@ bool Deploy::ValidateHashes(std::string& message)
     return true;
 }
 
+size_t Deploy::ValidateHashesBatch(std::span<const Deploy> deploys)
+{
+    // serialize the bodies and headers of a window of deploys, hash each set
+    // in one batch, then reuse the writers for the next window: the scratch
+    // space is bounded by the window, not by the whole input
+    ExecutableDeployItemByteSerializer itemSerializer;
+    DeployByteSerializer serializer;
+    ByteWriter bodies;
+    ByteWriter headers;
+    std::vector<size_t> body_ends;
+    std::vector<size_t> header_ends;
+    body_ends.reserve(VALIDATE_HASHES_WINDOW);
+    header_ends.reserve(VALIDATE_HASHES_WINDOW);
+    std::vector<uint8_t> body_hashes(Blake2bBatch::DIGEST_SIZE * VALIDATE_HASHES_WINDOW);
+    std::vector<uint8_t> header_hashes(Blake2bBatch::DIGEST_SIZE * VALIDATE_HASHES_WINDOW);
+
+    auto split = [](const ByteWriter& writer, const std::vector<size_t>& ends)
+    {
+        std::vector<std::span<const uint8_t>> inputs;
+        inputs.reserve(ends.size());
+        size_t begin = 0;
+        for (size_t end : ends)
+        {
+            inputs.emplace_back(writer.Data() + begin, end - begin);
+            begin = end;
+        }
+        return inputs;
+    };
+
+    size_t first = 0;
+    while (first < deploys.size())
+    {
+        bodies.Clear();
+        headers.Clear();
+        body_ends.clear();
+        header_ends.clear();
+
+        // at least one deploy per window, even one larger than the budget
+        size_t last = first;
+        while (last < deploys.size() && last - first < VALIDATE_HASHES_WINDOW &&
+               (last == first || bodies.Size() + headers.Size() < VALIDATE_HASHES_WINDOW_BYTES))
+        {
+            itemSerializer.ToBytes(bodies, deploys[last].payment);
+            itemSerializer.ToBytes(bodies, deploys[last].session);
+            body_ends.push_back(bodies.Size());
+            serializer.ToBytes(headers, deploys[last].header);
+            header_ends.push_back(headers.Size());
+            last++;
+        }
+
+        Blake2bBatch::Hash(split(bodies, body_ends), body_hashes.data());
+        Blake2bBatch::Hash(split(headers, header_ends), header_hashes.data());
+
+        for (size_t i = first; i < last; i++)
+        {
+            const uint8_t* body_hash = &body_hashes[Blake2bBatch::DIGEST_SIZE * (i - first)];
+            const uint8_t* header_hash = &header_hashes[Blake2bBatch::DIGEST_SIZE * (i - first)];
+            if (std::memcmp(deploys[i].header.body_hash.data(), body_hash, Blake2bBatch::DIGEST_SIZE) != 0 ||
+                std::memcmp(deploys[i].hash.data(), header_hash, Blake2bBatch::DIGEST_SIZE) != 0)
+            {
+                return i;
+            }
+        }
+        first = last;
+    }
+    return deploys.size();
+}
+
 /// <summary>
 /// Verifies the signatures in the list of approvals.
 /// </summary>
@@ -91,9 +165,10 @@ bool Deploy::VerifySignatures(std::string& message)
 {
     message = "";
 
+    const CBytes hash_bytes = this->hash.ToCBytes();
     for (auto& approval : this->approvals)
     {
-        if (!approval.signer.VerifySignature(hexDecode(this->hash), approval.signature.raw_bytes))
+        if (!approval.signer.VerifySignature(hash_bytes, approval.signature.raw_bytes))
         {
             message = "Error verifying signature with signer " + approval.signer.ToString();
             return false;
@@ -109,44 +184,28 @@ bool Deploy::VerifySignatures(std::string& message)
 /// </summary>
 int Deploy::GetDeploySizeInBytes() const
 {
-    DeployByteSerializer serializer;
-    return serializer.ToBytes(*this).size();
+    return static_cast<int>(ByteSizeCalculator::SizeOf(*this));
 }
 
 CBytes Deploy::ComputeBodyHash(const ExecutableDeployItem& payment_, const ExecutableDeployItem& session_)
 {
-    CBytes sb;
+    Blake2bHashSink hash;
     ExecutableDeployItemByteSerializer itemSerializer;
 
-    sb += itemSerializer.ToBytes(payment_);
-    sb += itemSerializer.ToBytes(session_);
+    itemSerializer.ToBytes(hash, payment_);
+    itemSerializer.ToBytes(hash, session_);
 
-    CryptoPP::BLAKE2b bcBl2bdigest(32u);
-    bcBl2bdigest.Update(sb, sb.size());
-
-    CBytes bodyHash(bcBl2bdigest.DigestSize());
-    bcBl2bdigest.Final(bodyHash);
-
-    return bodyHash;
+    return hash.Final();
 }
 
 CBytes Deploy::ComputeHeaderHash(const DeployHeader& header_)
 {
+    Blake2bHashSink hash;
     DeployByteSerializer serializer;
 
-    nlohmann::json j;
-    to_json(j, header_);
-
-    CBytes bHeader = serializer.ToBytes(header_);
-
-    CryptoPP::BLAKE2b bcBl2bdigest(32u);
-
-    bcBl2bdigest.Update(bHeader, bHeader.size());
-
-    CBytes headerHash(bcBl2bdigest.DigestSize());
-    bcBl2bdigest.Final(headerHash);
+    serializer.ToBytes(hash, header_);
 
-    return headerHash;
+    return hash.Final();
 }
 
 /// Loads the deploy from the given json object.
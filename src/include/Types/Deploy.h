@@ -1,10 +1,12 @@
 #pragma once
 
+#include <span>
 #include <utility>
 
 #include "Base.h"
 #include "Types/DeployApproval.h"
 #include "Types/DeployHeader.h"
+#include "Types/Hash32.h"
 #include "Types/ExecutableDeployItem.h"
 #include "Types/PublicKey.h"
 #include "Types/KeyPair.h"
@@ -23,11 +25,10 @@ struct Deploy
     /// </summary>
     std::vector<DeployApproval> approvals;
 
-    // TODO: check with CEP57 Checksum for json serialization
     /// <summary>
     /// A hash over the header of the deploy.
     /// </summary>
-    std::string hash;
+    Hash32 hash;
 
     /// <summary>
     /// Contains metadata about the deploy.
@@ -46,9 +47,9 @@ struct Deploy
 
     Deploy() = default;
 
-    Deploy(std::string hash_, DeployHeader header_, ExecutableDeployItem payment_, ExecutableDeployItem session_,
+    Deploy(const Hash32& hash_, DeployHeader header_, ExecutableDeployItem payment_, ExecutableDeployItem session_,
            std::vector<DeployApproval> approvals_)
-        : hash(std::move(hash_))
+        : hash(hash_)
         , header(std::move(header_))
         , payment(std::move(payment_))
         , session(std::move(session_))
@@ -72,6 +73,24 @@ struct Deploy
 
     bool ValidateHashes(std::string& message);
 
+    /// <summary>
+    /// Most deploys serialized and hashed together by ValidateHashesBatch.
+    /// </summary>
+    static constexpr size_t VALIDATE_HASHES_WINDOW = 64;
+
+    /// <summary>
+    /// Serialized bytes after which ValidateHashesBatch closes a window early,
+    /// so deploys with large WASM do not grow the scratch space.
+    /// </summary>
+    static constexpr size_t VALIDATE_HASHES_WINDOW_BYTES = 1 << 20;
+
+    /// <summary>
+    /// Validates the body and header hashes of many deploys, hashing them
+    /// together with Blake2bBatch a window at a time. Returns the index of the
+    /// first deploy failing, or deploys.size() if all pass.
+    /// </summary>
+    static size_t ValidateHashesBatch(std::span<const Deploy> deploys);
+
     bool VerifySignatures(std::string& message);
 
     [[nodiscard]] int GetDeploySizeInBytes() const;
@@ -112,14 +131,13 @@ inline void from_json(const nlohmann::json& j, Deploy& p)
 {
     try
     {
-        CEP57Checksum::Decode(j.at("hash").get<std::string>());
+        j.at("hash").get_to(p.hash);
     }
-    catch (const std::exception& e)
+    catch (const std::invalid_argument& e)
     {
         throw std::invalid_argument("Deploy: hash is not a valid checksum" + std::string(e.what()));
     }
 
-    j.at("hash").get_to(p.hash);
     j.at("header").get_to(p.header);
     j.at("payment").get_to(p.payment);
     j.at("session").get_to(p.session);
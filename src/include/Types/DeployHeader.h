@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Base.h"
+#include "Types/Hash32.h"
 #include "Types/PublicKey.h"
 #include "nlohmann/json.hpp"
 
@@ -36,13 +37,12 @@ struct DeployHeader
     /// <summary>
     /// Hash of the body part of this Deploy.
     /// </summary>
-    // TODO: [JsonConverter(typeof(CEP57Checksum.HashWithChecksumConverter))]
-    std::string body_hash;
+    Hash32 body_hash;
 
     /// <summary>
     /// List of Deploy hashes.
     /// </summary>
-    std::vector<std::string> dependencies;
+    std::vector<Hash32> dependencies;
 
     /// <summary>
     /// Name of the chain where the deploy is executed.
@@ -52,8 +52,7 @@ struct DeployHeader
     DeployHeader() {}
 
     DeployHeader(const PublicKey& account_, const std::string& timestamp_, const std::string& ttl_, uint64_t gas_price_,
-                 const std::string& body_hash_, const std::vector<std::string>& dependencies_,
-                 const std::string& chain_name_)
+                 const Hash32& body_hash_, const std::vector<Hash32>& dependencies_, const std::string& chain_name_)
         : account(account_)
         , timestamp(timestamp_)
         , ttl(ttl_)
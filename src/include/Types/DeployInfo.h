@@ -2,6 +2,7 @@
 
 #include "Base.h"
 #include "Types/GlobalStateKey.h"
+#include "Types/Hash32.h"
 #include "Types/URef.h"
 #include "nlohmann/json.hpp"
 
@@ -15,7 +16,7 @@ struct DeployInfo
     /// <summary>
     /// The Deploy hash.
     /// </summary>
-    std::string deploy_hash;
+    Hash32 deploy_hash;
 
     /// <summary>
     /// Transfer addresses performed by the Deploy.
@@ -58,8 +58,8 @@ Ed25519Key::Ed25519Key(const std::string& pem_file_path)
     // resize
     pub_key.resize(pub_key_len);
 
-    std::string priv_key_str = hexEncode(priv_key);
-    std::string pub_key_str = hexEncode(pub_key);
+    std::string priv_key_str = hexEncode(priv_key.data(), priv_key.size());
+    std::string pub_key_str = hexEncode(pub_key.data(), pub_key.size());
 
     this->private_key_str = priv_key_str;
     this->public_key_str = pub_key_str;
@@ -68,13 +68,13 @@ Ed25519Key::Ed25519Key(const std::string& pem_file_path)
 // sign
 std::string Ed25519Key::sign(std::string message_str)
 {
-    CryptoPP::SecByteBlock message(hexDecode(message_str));
-    CryptoPP::SecByteBlock signature = sign(message);
+    CBytes message = hexDecode(message_str);
+    CBytes signature = sign(message);
     std::string signature_str = hexEncode(signature);
     return signature_str;
 }
 
-CryptoPP::SecByteBlock Ed25519Key::sign(const CryptoPP::SecByteBlock& message)
+CBytes Ed25519Key::sign(const CBytes& message)
 {
     CryptoPP::AutoSeededRandomPool prng;
     CryptoPP::ed25519Signer signer(priv_key.data());
@@ -101,18 +101,16 @@ CryptoPP::SecByteBlock Ed25519Key::sign(const CryptoPP::SecByteBlock& message)
 
     SPDLOG_DEBUG("Signature: {}", encoded);
 
-    CryptoPP::SecByteBlock signature_block(hexDecode(encoded));
-
-    return signature_block;
+    return hexDecode(encoded);
 }
 
-bool Ed25519Key::verify(const CryptoPP::SecByteBlock& message, const CryptoPP::SecByteBlock& signature)
+bool Ed25519Key::verify(const CBytes& message, const CBytes& signature)
 {
     CryptoPP::ed25519Verifier verifier(pub_key.data());
 
     // verify
     bool is_valid =
-        verifier.VerifyMessage(message.BytePtr(), message.size(), (CryptoPP::byte*)signature.data(), signature.size());
+        verifier.VerifyMessage(message.data(), message.size(), signature.data(), signature.size());
     SPDLOG_DEBUG("Verification: {}", is_valid ? "true" : "false");
 
     return is_valid;
@@ -120,10 +118,7 @@ bool Ed25519Key::verify(const CryptoPP::SecByteBlock& message, const CryptoPP::S
 
 bool Ed25519Key::verify(std::string message, std::string signature)
 {
-    CryptoPP::SecByteBlock message_block(hexDecode(message));
-    CryptoPP::SecByteBlock signature_block(hexDecode(signature));
-
-    return verify(message_block, signature_block);
+    return verify(hexDecode(message), hexDecode(signature));
 }
 
 std::string Ed25519Key::getPrivateKeyStr()
@@ -2,10 +2,13 @@
 #include <string>
 #include <cryptopp/secblock.h>
 
+#include "Base.h"
+
 namespace Casper
 {
 class Ed25519Key
 {
+    // key material is kept in zeroized memory
     CryptoPP::SecByteBlock priv_key;
     CryptoPP::SecByteBlock pub_key;
 
@@ -17,12 +20,12 @@ public:
     Ed25519Key(const std::string& pem_file_path);
 
     /// Sign a message with the private key and return the signature
-    CryptoPP::SecByteBlock sign(const CryptoPP::SecByteBlock& message);
+    CBytes sign(const CBytes& message);
 
     std::string sign(std::string message);
 
     /// Verify the signature on the message using the public key
-    bool verify(const CryptoPP::SecByteBlock& message, const CryptoPP::SecByteBlock& signature);
+    bool verify(const CBytes& message, const CBytes& signature);
 
     bool verify(std::string message, std::string signature);
 
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "Base.h"
-#include "Types/PublicKey.h"
+#include "Types/PublicKeyTable.h"
 #include "Types/ValidatorWeight.h"
 #include "nlohmann/json.hpp"
 namespace Casper
@@ -37,7 +37,7 @@ inline void to_json(nlohmann::json& j, const Reward& p)
 inline void from_json(const nlohmann::json& j, Reward& p)
 {
     j.at("amount").get_to(p.amount);
-    j.at("validator").get_to(p.validator);
+    internPublicKey(j.at("validator"), p.validator);
 }
 
 /// <summary>
@@ -76,8 +76,8 @@ inline void to_json(nlohmann::json& j, const EraReport& p)
 // from_json of EraReport
 inline void from_json(const nlohmann::json& j, EraReport& p)
 {
-    j.at("equivocators").get_to(p.equivocators);
-    j.at("inactive_validators").get_to(p.inactive_validators);
+    internPublicKeys(j.at("equivocators"), p.equivocators);
+    internPublicKeys(j.at("inactive_validators"), p.inactive_validators);
     j.at("rewards").get_to(p.rewards);
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Base.h"
+#include "Types/Hash32.h"
 #include "Types/StoredValue.h"
 #include "nlohmann/json.hpp"
 
@@ -15,7 +16,7 @@ struct EraSummary
     /// <summary>
     /// The block hash
     /// </summary>
-    std::string block_hash;
+    Hash32 block_hash;
 
     /// <summary>
     /// The Era Id
@@ -30,7 +31,7 @@ struct EraSummary
     /// <summary>
     /// Hex-encoded hash of the state root.
     /// </summary>
-    std::string state_root_hash;
+    Hash32 state_root_hash;
 
     /// <summary>
     /// The merkle proof.
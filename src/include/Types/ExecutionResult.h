@@ -2,6 +2,7 @@
 
 #include "Base.h"
 #include "Types/ExecutionEffect.h"
+#include "Types/Hash32.h"
 #include "nlohmann/json.hpp"
 
 namespace Casper
@@ -108,7 +109,7 @@ struct ExecutionResult
     /// <summary>
     /// The block hash.
     /// </summary>
-    std::string block_hash;
+    Hash32 block_hash;
 
     ExecutionResult() = default;
 };
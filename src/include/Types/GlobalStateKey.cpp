@@ -1,289 +1,350 @@
 #include "Types/GlobalStateKey.h"
 
-#include <sstream>
+#include <charconv>
+#include <cstring>
+#include <tuple>
 
 #include "Types/URef.h"
 #include "Utils/CEP57Checksum.h"
-#include "Utils/CryptoUtil.h"
-#include "Utils/StringUtil.h"
+#include "Utils/HexCodec.h"
 
 namespace Casper
 {
+namespace
+{
+/// Canonical prefixes, indexed by KeyIdentifier.
+constexpr std::array<std::string_view, 10> kKeyPrefixes = {"account-hash-", "hash-", "uref-",     "transfer-",
+                                                           "deploy-",       "era-",  "balance-", "bid-",
+                                                           "withdraw-",     "dictionary-"};
+
+std::string_view PrefixOf(KeyIdentifier identifier)
+{
+    return kKeyPrefixes[static_cast<size_t>(identifier)];
+}
+
+/// Looks at the first character only to pick the candidate prefixes, so a
+/// key is matched against at most three of them.
+bool ParsePrefix(std::string_view value, KeyIdentifier& identifier, size_t& prefix_size)
+{
+    auto match = [&](std::string_view prefix, KeyIdentifier id)
+    {
+        if (!value.starts_with(prefix))
+        {
+            return false;
+        }
+        identifier = id;
+        prefix_size = prefix.size();
+        return true;
+    };
+
+    switch (value.empty() ? '\0' : value[0])
+    {
+    case 'a':
+        return match("account-hash-", KeyIdentifier::Account);
+    case 'h':
+        return match("hash-", KeyIdentifier::Hash);
+    case 'c':
+        return match("contract-package-wasm", KeyIdentifier::Hash) ||
+               match("contract-wasm-", KeyIdentifier::Hash) || match("contract-", KeyIdentifier::Hash);
+    case 'u':
+        return match("uref-", KeyIdentifier::URef);
+    case 't':
+        return match("transfer-", KeyIdentifier::Transfer);
+    case 'd':
+        return match("deploy-", KeyIdentifier::DeployInfo) || match("dictionary-", KeyIdentifier::Dictionary);
+    case 'e':
+        return match("era-", KeyIdentifier::EraInfo);
+    case 'b':
+        return match("balance-", KeyIdentifier::Balance) || match("bid-", KeyIdentifier::Bid);
+    case 'w':
+        return match("withdraw-", KeyIdentifier::Withdraw);
+    default:
+        return false;
+    }
+}
 
-CBytes GlobalStateKey::_GetRawBytesFromKey(const std::string& key_)
+/// 64 hex digits, optionally CEP-57 checksummed.
+void ParseAddress(std::string_view hex, uint8_t* out)
 {
-    return CryptoUtil::hexDecode(key_.substr(key_.find_last_of('-') + 1));
+    if (hex.size() != 2 * GlobalStateKey::PAYLOAD_SIZE)
+    {
+        throw std::invalid_argument("Key not valid. It should contain a 32 byte value.");
+    }
+    HexCodec::Decode(hex, out, HexMode::Strict);
+    if (!CEP57Checksum::Verify(hex, out))
+    {
+        throw std::invalid_argument("Key not valid. Checksum mismatch.");
+    }
 }
 
-GlobalStateKey::GlobalStateKey() = default;
+void WriteEraId(uint64_t era_id, GlobalStateKey& key)
+{
+    for (size_t i = 0; i < sizeof(era_id); i++)
+    {
+        key.payload[i] = static_cast<uint8_t>(era_id >> (8 * i));
+    }
+}
+
+uint64_t ReadEraId(const GlobalStateKey& key)
+{
+    uint64_t era_id = 0;
+    for (size_t i = 0; i < sizeof(era_id); i++)
+    {
+        era_id |= static_cast<uint64_t>(key.payload[i]) << (8 * i);
+    }
+    return era_id;
+}
+
+void ParseEraId(std::string_view text, GlobalStateKey& key)
+{
+    uint64_t era_id = 0;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), era_id);
+    if (text.empty() || ec != std::errc() || end != text.data() + text.size())
+    {
+        throw std::invalid_argument("Key not valid. Cannot parse era number.");
+    }
+    WriteEraId(era_id, key);
+}
+
+/// Key of the given kind from its 32 byte address.
+GlobalStateKey FromAddress(KeyIdentifier identifier, const CBytes& address)
+{
+    if (address.size() != GlobalStateKey::PAYLOAD_SIZE)
+    {
+        throw std::invalid_argument("Key not valid. It should contain a 32 byte value.");
+    }
+    GlobalStateKey key;
+    key.key_identifier = identifier;
+    std::memcpy(key.payload.data(), address.data(), address.size());
+    return key;
+}
+
+} // namespace
 
 /// <summary>
 /// Constructor for the GlobalStateKey class.
 /// </summary>
 GlobalStateKey::GlobalStateKey(const std::string& key_)
-    : key{key_}
-    , raw_bytes{_GetRawBytesFromKey(key_)}
+    : GlobalStateKey(FromString(key_))
 {
 }
 
 /// <summary>
-/// Constructor for the GlobalStateKey class with key prefix.
+/// Constructor for the GlobalStateKey class with the expected key kind.
 /// </summary>
-GlobalStateKey::GlobalStateKey(const std::string& key_, const std::string& key_prefix)
+GlobalStateKey::GlobalStateKey(std::string_view key_, KeyIdentifier expected)
+    : GlobalStateKey(FromString(key_))
 {
-    if (key_.rfind(key_prefix, 0) != 0)
-        throw std::invalid_argument("Key not valid. It should start with '{key_prefix}'.");
-    CBytes res = CEP57Checksum::Decode(key_.substr(key_.find_last_of('-') + 1));
-    key = key_prefix + CEP57Checksum::Encode(res);
-    raw_bytes = _GetRawBytesFromKey(key);
+    if (key_identifier != expected)
+    {
+        throw std::invalid_argument("Key not valid. It should start with '" + std::string(PrefixOf(expected)) + "'.");
+    }
 }
 
 std::string GlobalStateKey::ToHexString() const
 {
-    return CEP57Checksum::Encode(raw_bytes);
+    return CEP57Checksum::Encode(GetRawBytes());
 }
 
-GlobalStateKey GlobalStateKey::FromString(const std::string& value)
+GlobalStateKey GlobalStateKey::FromString(std::string_view value)
 {
-    if (StringUtil::startsWith(value, "account-hash-"))
-        return AccountHashKey(value);
-    if (StringUtil::startsWith(value, "hash-"))
-        return HashKey(value);
+    GlobalStateKey key;
+    size_t prefix_size = 0;
+    if (!ParsePrefix(value, key.key_identifier, prefix_size))
+    {
+        throw std::invalid_argument("Key not valid. Unknown key prefix.");
+    }
 
-    if (StringUtil::startsWith(value, "contract-package-wasm"))
+    auto rest = value.substr(prefix_size);
+    switch (key.key_identifier)
     {
-        std::string new_value = value;
-        std::string prefix = "contract-package-wasm";
-        size_t pos = new_value.find(prefix);
-        new_value.replace(pos, prefix.length(), "hash-");
-        return HashKey(new_value);
+    case KeyIdentifier::URef:
+        return URef::FromString(value);
+    case KeyIdentifier::EraInfo:
+        ParseEraId(rest, key);
+        break;
+    default:
+        ParseAddress(rest, key.payload.data());
+        break;
     }
-    if (StringUtil::startsWith(value, "contract-wasm-"))
+    return key;
+}
+
+GlobalStateKey GlobalStateKey::FromBytes(const CBytes& bytes)
+{
+    if (bytes.size() == 0 || bytes[0] > static_cast<uint8_t>(KeyIdentifier::Dictionary))
     {
-        std::string new_value = value;
-        std::string prefix = "contract-wasm-";
-        size_t pos = new_value.find(prefix);
-        new_value.replace(pos, prefix.length(), "hash-");
-        return HashKey(new_value);
+        throw std::invalid_argument("Key not valid. Unknown key prefix.");
     }
-    if (StringUtil::startsWith(value, "contract-"))
+
+    GlobalStateKey key;
+    key.key_identifier = static_cast<KeyIdentifier>(bytes[0]);
+    size_t expected_size = 1 + key.PayloadSize() + (key.key_identifier == KeyIdentifier::URef ? 1 : 0);
+    if (bytes.size() != expected_size)
     {
-        std::string new_value = value;
-        std::string prefix = "contract-";
-        size_t pos = new_value.find(prefix);
-        new_value.replace(pos, prefix.length(), "hash-");
-        return HashKey(new_value);
+        throw std::invalid_argument("Key not valid. Expected " + std::to_string(expected_size) + " bytes.");
     }
 
-    if (StringUtil::startsWith(value, "uref-"))
-        return URef(value);
-    if (StringUtil::startsWith(value, "transfer-"))
-        return TransferKey(value);
-    if (StringUtil::startsWith(value, "deploy-"))
-        return DeployInfoKey(value);
-    if (StringUtil::startsWith(value, "era-"))
-        return EraInfoKey(value);
-    if (StringUtil::startsWith(value, "balance-"))
-        return BalanceKey(value);
-    if (StringUtil::startsWith(value, "bid"))
-        return BidKey(value);
-    if (StringUtil::startsWith(value, "withdraw"))
-        return WithdrawKey(value);
-    if (StringUtil::startsWith(value, "dictionary"))
-        return DictionaryKey(value);
-
-    throw std::invalid_argument("Key not valid. Unknown key prefix.");
+    std::memcpy(key.payload.data(), bytes.data() + 1, key.PayloadSize());
+    if (key.key_identifier == KeyIdentifier::URef)
+    {
+        if (bytes[expected_size - 1] > static_cast<uint8_t>(AccessRights::READ_ADD_WRITE))
+        {
+            throw std::invalid_argument("Key not valid. Invalid access rights.");
+        }
+        key.access_rights = static_cast<AccessRights>(bytes[expected_size - 1]);
+    }
+    return key;
 }
 
-GlobalStateKey GlobalStateKey::FromBytes(const CBytes& bytes)
+CBytes GlobalStateKey::GetBytes() const
 {
-    CBytes new_bytes(bytes.size() - 1);
-    std::copy(bytes.begin() + 1, bytes.end(), new_bytes.begin());
-    uint64_t era_number = *(uint64_t*)new_bytes.begin();
-
-    switch (bytes[0])
+    bool is_uref = key_identifier == KeyIdentifier::URef;
+    CBytes ms(1 + PayloadSize() + (is_uref ? 1 : 0));
+    ms[0] = static_cast<uint8_t>(key_identifier);
+    std::memcpy(ms.data() + 1, payload.data(), PayloadSize());
+    if (is_uref)
     {
-    case 0x00:
-        return AccountHashKey("account-hash-" + CryptoUtil::hexEncode(new_bytes));
-    case 0x01:
-        return HashKey("hash-" + CryptoUtil::hexEncode(new_bytes));
-    case 0x02:
-        return URef("uref-" + CEP57Checksum::Encode(new_bytes));
-    case 0x03:
-        return TransferKey("transfer-" + CEP57Checksum::Encode(new_bytes));
-    case 0x04:
-        return DeployInfoKey("deploy-" + CEP57Checksum::Encode(new_bytes));
-    case 0x05:
-        return EraInfoKey("era-" + std::to_string(era_number));
-    case 0x06:
-        return BalanceKey("balance-" + CEP57Checksum::Encode(new_bytes));
-    case 0x07:
-        return BidKey("bid-" + CEP57Checksum::Encode(new_bytes));
-    case 0x08:
-        return WithdrawKey("withdraw-" + CEP57Checksum::Encode(new_bytes));
-    case 0x09:
-        return DictionaryKey("dictionary-" + CEP57Checksum::Encode(new_bytes));
-    default:
-        throw std::invalid_argument("Key not valid. Unknown key prefix.");
+        ms[ms.size() - 1] = static_cast<uint8_t>(access_rights);
     }
+    return ms;
 }
 
-CBytes GlobalStateKey::GetBytes()
+CBytes GlobalStateKey::GetRawBytes() const
 {
-    CBytes ms(this->raw_bytes.size() + 1);
-    ms[0] = static_cast<uint8_t>(this->key_identifier);
-    std::copy(this->raw_bytes.begin(), this->raw_bytes.end(), ms.begin() + 1);
-    return ms;
+    return CBytes(payload.data(), PayloadSize());
 }
 
 std::string GlobalStateKey::ToString() const
 {
-    return this->key;
+    auto prefix = PrefixOf(key_identifier);
+    if (key_identifier == KeyIdentifier::EraInfo)
+    {
+        return std::string(prefix) + std::to_string(ReadEraId(*this));
+    }
+
+    if (key_identifier == KeyIdentifier::URef)
+    {
+        return URef(payload, access_rights).ToString();
+    }
+
+    std::string result(prefix);
+    result.resize(prefix.size() + 2 * PAYLOAD_SIZE);
+    CEP57Checksum::Encode(payload.data(), PAYLOAD_SIZE, result.data() + prefix.size());
+    return result;
 }
-// GlobalStateKey
 
 bool GlobalStateKey::operator<(const GlobalStateKey& other) const
 {
-    return this->key < other.key;
+    return std::tie(key_identifier, payload, access_rights) <
+           std::tie(other.key_identifier, other.payload, other.access_rights);
 }
 
 bool GlobalStateKey::operator==(const GlobalStateKey& other) const
 {
-    return this->key == other.key;
+    return key_identifier == other.key_identifier && payload == other.payload && access_rights == other.access_rights;
 }
 
 bool GlobalStateKey::operator!=(const GlobalStateKey& other) const
 {
-    return this->key != other.key;
+    return !(*this == other);
 }
 
 AccountHashKey::AccountHashKey(const std::string& key)
-    : GlobalStateKey::GlobalStateKey(key, "account-hash-")
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Account)
 {
-    key_identifier = KeyIdentifier::Account;
 }
 
 AccountHashKey::AccountHashKey(const PublicKey& publicKey)
-    : GlobalStateKey::GlobalStateKey(publicKey.GetAccountHash(), "account-hash-")
 {
+    key_identifier = KeyIdentifier::Account;
+    payload = publicKey.GetAccountHashBytes().bytes;
 }
 
 HashKey::HashKey(const std::string& key)
-    : GlobalStateKey::GlobalStateKey(key, "hash-")
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Hash)
 {
-    key_identifier = KeyIdentifier::Hash;
 }
 
 HashKey::HashKey(const CBytes& key)
-    : HashKey::HashKey("hash-" + CEP57Checksum::Encode(key))
+    : GlobalStateKey::GlobalStateKey(FromAddress(KeyIdentifier::Hash, key))
 {
 }
 
 TransferKey::TransferKey(const std::string& key)
-    : GlobalStateKey::GlobalStateKey(key, "transfer-")
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Transfer)
 {
-    key_identifier = KeyIdentifier::Transfer;
 }
 
 TransferKey::TransferKey(const CBytes& key)
-    : TransferKey::TransferKey("transfer-" + CEP57Checksum::Encode(key))
+    : GlobalStateKey::GlobalStateKey(FromAddress(KeyIdentifier::Transfer, key))
 {
 }
 
 DeployInfoKey::DeployInfoKey(const std::string& key)
-    : GlobalStateKey::GlobalStateKey(key, "deploy-")
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::DeployInfo)
 {
-    key_identifier = KeyIdentifier::DeployInfo;
 }
 
 DeployInfoKey::DeployInfoKey(const CBytes& key)
-    : DeployInfoKey::DeployInfoKey("deploy-" + CEP57Checksum::Encode(key))
+    : GlobalStateKey::GlobalStateKey(FromAddress(KeyIdentifier::DeployInfo, key))
 {
 }
 
 EraInfoKey::EraInfoKey(const std::string& key)
-    : GlobalStateKey::GlobalStateKey(key)
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::EraInfo)
 {
-    key_identifier = KeyIdentifier::EraInfo;
-    if (!StringUtil::startsWith(key, "era-"))
-        throw std::invalid_argument("EraInfoKey must start with 'era-'");
-
-    int64_t era_num;
-    try
-    {
-        std::istringstream iss(key.substr(4));
-        iss >> era_num;
-    }
-    catch (std::exception& e)
-    {
-        throw std::invalid_argument("Key not valid. Cannot parse era number.");
-    }
 }
 
-CBytes EraInfoKey::GetBytes()
+EraInfoKey::EraInfoKey(uint64_t era_id)
 {
-    CBytes ms(9);
-    ms[0] = uint8_t(this->key_identifier);
-    std::copy(ms.begin() + 1, ms.end(), raw_bytes.begin());
-    return ms;
+    key_identifier = KeyIdentifier::EraInfo;
+    WriteEraId(era_id, *this);
 }
 
-CBytes EraInfoKey::_GetRawBytesFromKey(const std::string& key)
+uint64_t EraInfoKey::GetEraId() const
 {
-    uint64_t u64;
-    std::istringstream iss(key.substr(4));
-    iss >> u64;
-
-    CBytes bytes(8);
-    std::copy(reinterpret_cast<uint8_t*>(&u64), reinterpret_cast<uint8_t*>(&u64) + 8, bytes.begin());
-
-    // TODO: Check endianness
-    // if (!BitConverter.IsLittleEndian) Array.Reverse(bytes);
-
-    return bytes;
+    return ReadEraId(*this);
 }
 
 BalanceKey::BalanceKey(const std::string& key)
-    : GlobalStateKey::GlobalStateKey(key, "balance-")
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Balance)
 {
-    key_identifier = KeyIdentifier::Balance;
 }
 
 BalanceKey::BalanceKey(const CBytes& key)
-    : BalanceKey::BalanceKey("balance-" + CEP57Checksum::Encode(key))
+    : GlobalStateKey::GlobalStateKey(FromAddress(KeyIdentifier::Balance, key))
 {
 }
 
 BidKey::BidKey(const std::string& key)
-    : GlobalStateKey::GlobalStateKey(key, "bid-")
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Bid)
 {
-    key_identifier = KeyIdentifier::Bid;
 }
 
 BidKey::BidKey(const CBytes& key)
-    : BidKey::BidKey("bid-" + CEP57Checksum::Encode(key))
+    : GlobalStateKey::GlobalStateKey(FromAddress(KeyIdentifier::Bid, key))
 {
 }
 
 WithdrawKey::WithdrawKey(const std::string& key)
-    : GlobalStateKey::GlobalStateKey(key, "withdraw-")
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Withdraw)
 {
-    key_identifier = KeyIdentifier::Withdraw;
 }
 
 WithdrawKey::WithdrawKey(const CBytes& key)
-    : WithdrawKey::WithdrawKey("withdraw-" + CEP57Checksum::Encode(key))
+    : GlobalStateKey::GlobalStateKey(FromAddress(KeyIdentifier::Withdraw, key))
 {
 }
 
 DictionaryKey::DictionaryKey(const std::string& key)
-    : GlobalStateKey::GlobalStateKey(key, "dictionary-")
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Dictionary)
 {
-    key_identifier = KeyIdentifier::Dictionary;
 }
+
 DictionaryKey::DictionaryKey(const CBytes& key)
-    : DictionaryKey::DictionaryKey("dictionary-" + CEP57Checksum::Encode(key))
+    : GlobalStateKey::GlobalStateKey(FromAddress(KeyIdentifier::Dictionary, key))
 {
 }
 
-} // namespace Casper
\ No newline at end of file
+} // namespace Casper
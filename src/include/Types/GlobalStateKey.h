@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
+#include <string_view>
+
 #include "Base.h"
+#include "Types/AccessRights.h"
 #include "Types/PublicKey.h"
 #include "magic_enum/magic_enum.hpp"
 // Crypto
@@ -65,39 +69,49 @@ enum class KeyIdentifier
 };
 
 /// <summary>
-/// Base class for the different global state keys.
+/// Base class for the different global state keys. A key is its identifier
+/// tag, a fixed 32 byte payload and, for URefs, the access rights, so it can
+/// be copied and compared without allocating. The derived types only add
+/// constructors and can be sliced freely.
 /// </summary>
 struct GlobalStateKey
 {
-    std::string key;
+    static constexpr size_t PAYLOAD_SIZE = 32;
 
-public:
-    KeyIdentifier key_identifier;
-    CBytes raw_bytes;
+    KeyIdentifier key_identifier = KeyIdentifier::Account;
 
-protected:
-    virtual CBytes _GetRawBytesFromKey(const std::string& key);
+    /// <summary>
+    /// The 32 byte address of the key. EraInfo keys hold the era id as a
+    /// little endian u64 in the first 8 bytes.
+    /// </summary>
+    std::array<uint8_t, PAYLOAD_SIZE> payload{};
 
-public:
-    GlobalStateKey();
+    /// <summary>
+    /// Access rights of a URef key, NONE for the other kinds.
+    /// </summary>
+    AccessRights access_rights = AccessRights::NONE;
+
+    GlobalStateKey() = default;
 
     /// <summary>
-    /// Constructor for the GlobalStateKey class.
+    /// Parses a key of any kind, same as FromString().
     /// </summary>
     GlobalStateKey(const std::string& key_);
 
     /// <summary>
-    /// Constructor for the GlobalStateKey class with key prefix.
+    /// Parses a key that must be of the given kind.
     /// </summary>
-    GlobalStateKey(const std::string& key_, const std::string& key_prefix);
+    GlobalStateKey(std::string_view key_, KeyIdentifier expected);
 
     std::string ToHexString() const;
 
     /// <summary>
     /// Converts a global state key from string to its specific key object.
+    /// The kind is picked from the prefix in a single pass and the
+    /// "contract-", "contract-wasm-" and "contract-package-wasm" aliases are
+    /// read as Hash keys.
     /// </summary>
-
-    static GlobalStateKey FromString(const std::string& value);
+    static GlobalStateKey FromString(std::string_view value);
 
     /// <summary>
     /// Converts a global state key from a byte array to its specific key object.
@@ -105,12 +119,25 @@ public:
     /// </summary>
     static GlobalStateKey FromBytes(const CBytes& bytes);
 
-    virtual CBytes GetBytes();
+    /// <summary>
+    /// Number of payload bytes in the bytesrepr encoding: 8 for EraInfo, 32
+    /// for the other kinds.
+    /// </summary>
+    size_t PayloadSize() const { return key_identifier == KeyIdentifier::EraInfo ? sizeof(uint64_t) : PAYLOAD_SIZE; }
+
+    /// <summary>
+    /// The identifier byte, the payload and, for URefs, the access rights.
+    /// </summary>
+    CBytes GetBytes() const;
 
     /// <summary>
-    /// Converts a key object to a string with the right prefix
+    /// The payload without identifier or access rights.
     /// </summary>
+    CBytes GetRawBytes() const;
 
+    /// <summary>
+    /// Converts a key object to a string with the right prefix
+    /// </summary>
     std::string ToString() const;
 
     bool operator<(const GlobalStateKey& other) const;
@@ -127,7 +154,7 @@ public:
 struct AccountHashKey : public GlobalStateKey
 {
     AccountHashKey(const std::string& key);
-    AccountHashKey() { key_identifier = KeyIdentifier::Account; }
+    AccountHashKey() = default;
     AccountHashKey(const PublicKey& publicKey);
 };
 
@@ -172,10 +199,9 @@ struct EraInfoKey : public GlobalStateKey
 {
     EraInfoKey(const std::string& key);
 
-    CBytes GetBytes() override;
+    EraInfoKey(uint64_t era_id);
 
-protected:
-    CBytes _GetRawBytesFromKey(const std::string& key) override;
+    uint64_t GetEraId() const;
 };
 
 /// <summary>
@@ -230,12 +256,7 @@ struct DictionaryKey : public GlobalStateKey
  */
 inline void to_json(nlohmann::json& j, const GlobalStateKey& p)
 {
-    /*std::string key_identifier_str{magic_enum::enum_name(p.key_identifier)};
-
-    j[key_identifier_str] = p.key;
-    */
-
-    j = p.key;
+    j = p.ToString();
 }
 /**
  * @brief Construct a GlobalStateKey object from a JSON object.
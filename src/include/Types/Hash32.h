@@ -0,0 +1,199 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "Base.h"
+#include "Utils/CEP57Checksum.h"
+#include "Utils/HexCodec.h"
+#include "nlohmann/json.hpp"
+
+namespace Casper
+{
+/// <summary>
+/// A 32 byte BLAKE2b digest: deploy, block, body and state root hashes. The
+/// bytes are stored inline so a Hash32 is copied, compared and hashed without
+/// any allocation or hex conversion.
+/// </summary>
+struct Hash32
+{
+    static constexpr size_t SIZE = 32;
+
+    std::array<uint8_t, SIZE> bytes{};
+
+    Hash32() = default;
+
+    explicit Hash32(const std::array<uint8_t, SIZE>& bytes_) : bytes(bytes_) {}
+
+    /// <summary>
+    /// Parses `hex` as FromString() does, and throws as it does. Explicit, so
+    /// a string is never parsed where a hash is expected without saying so.
+    /// </summary>
+    explicit Hash32(std::string_view hex) : Hash32(FromString(hex)) {}
+
+    /// <summary>
+    /// Copies `size` bytes, which must be exactly SIZE.
+    /// </summary>
+    static Hash32 FromBytes(const uint8_t* data, size_t size)
+    {
+        if (size != SIZE)
+        {
+            throw std::invalid_argument("Hash32: expected 32 bytes, got " + std::to_string(size));
+        }
+        Hash32 hash;
+        std::memcpy(hash.bytes.data(), data, SIZE);
+        return hash;
+    }
+
+    static Hash32 FromBytes(const CBytes& data) { return FromBytes(data.data(), data.size()); }
+
+    /// <summary>
+    /// Parses 64 hex digits, all lowercase, all uppercase or carrying a CEP-57
+    /// checksum. Throws std::invalid_argument on anything else, including a
+    /// checksum that does not match.
+    /// </summary>
+    static Hash32 FromString(std::string_view hex)
+    {
+        if (hex.size() != 2 * SIZE)
+        {
+            throw std::invalid_argument("Hash32: expected 64 hex digits, got " + std::to_string(hex.size()));
+        }
+        Hash32 hash;
+        HexCodec::Decode(hex, hash.bytes.data(), HexMode::Strict);
+        if (!CEP57Checksum::Verify(hex, hash.bytes.data()))
+        {
+            throw std::invalid_argument("Hash32: checksum mismatch in " + std::string(hex));
+        }
+        return hash;
+    }
+
+    /// <summary>
+    /// Lowercase hex, the form used by the node in JSON.
+    /// </summary>
+    std::string ToString() const
+    {
+        std::string hex(2 * SIZE, '\0');
+        HexCodec::Encode(bytes.data(), SIZE, hex.data());
+        return hex;
+    }
+
+    /// <summary>
+    /// Hex with the CEP-57 checksum applied to the letter case.
+    /// </summary>
+    std::string ToChecksumString() const
+    {
+        std::string hex(2 * SIZE, '\0');
+        CEP57Checksum::Encode(bytes.data(), SIZE, hex.data());
+        return hex;
+    }
+
+    /// <summary>
+    /// Lowercase hex, as ToString(). Keeps code that reads the hash fields as
+    /// strings compiling.
+    /// </summary>
+    operator std::string() const { return ToString(); }
+
+    CBytes ToCBytes() const { return CBytes(bytes.data(), SIZE); }
+
+    const uint8_t* data() const { return bytes.data(); }
+
+    static constexpr size_t size() { return SIZE; }
+
+    /// <summary>
+    /// True for a default constructed hash, e.g. a field missing from a
+    /// response.
+    /// </summary>
+    bool IsZero() const { return *this == Hash32(); }
+
+    friend bool operator==(const Hash32& lhs, const Hash32& rhs) = default;
+
+    friend auto operator<=>(const Hash32& lhs, const Hash32& rhs) = default;
+
+    /// <summary>
+    /// Compares with hex in any letter case. False, rather than an exception,
+    /// for text that is not a hash.
+    /// </summary>
+    friend bool operator==(const Hash32& lhs, std::string_view hex)
+    {
+        if (hex.size() != 2 * SIZE)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < SIZE; i++)
+        {
+            if (NibbleOf(hex[2 * i]) != lhs.bytes[i] >> 4 || NibbleOf(hex[2 * i + 1]) != (lhs.bytes[i] & 0x0f))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator==(const Hash32& lhs, const std::string& hex) { return lhs == std::string_view(hex); }
+
+    friend bool operator==(const Hash32& lhs, const char* hex) { return lhs == std::string_view(hex); }
+
+private:
+    /// <summary>
+    /// Value of a hex digit in any letter case, -1 for anything else.
+    /// </summary>
+    static constexpr int NibbleOf(char c)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f')
+        {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F')
+        {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const Hash32& p)
+{
+    return os << p.ToString();
+}
+
+static_assert(std::is_trivially_copyable_v<Hash32> && sizeof(Hash32) == Hash32::SIZE);
+
+inline void to_json(nlohmann::json& j, const Hash32& p)
+{
+    j = p.ToString();
+}
+
+inline void from_json(const nlohmann::json& j, Hash32& p)
+{
+    p = Hash32::FromString(j.get_ref<const std::string&>());
+}
+
+} // namespace Casper
+
+namespace std
+{
+/// The digest is already uniformly distributed, its first word is as good a
+/// hash as any.
+template <>
+struct hash<Casper::Hash32>
+{
+    size_t operator()(const Casper::Hash32& value) const noexcept
+    {
+        size_t result;
+        std::memcpy(&result, value.bytes.data(), sizeof(result));
+        return result;
+    }
+};
+
+} // namespace std
@@ -1,12 +1,19 @@
 #pragma once
+#include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <iostream>
+#include <span>
+#include <string_view>
 #include <vector>
 #include <spdlog/spdlog.h>
 
+#include "Types/Hash32.h"
 #include "Types/KeyAlgo.h"
+#include "Utils/Blake2bBatch.h"
 #include "Utils/CEP57Checksum.h"
 #include "Utils/File.h"
+#include "Utils/HexCodec.h"
 #include "Utils/StringUtil.h"
 #include <cryptopp/pem.h>
 #include "nlohmann/json.hpp"
@@ -39,23 +46,24 @@ public:
     /// Creates a PublicKey object from an hexadecimal string (containing the
     /// Key algorithm identifier).
     /// </summary>
-    static Casper::PublicKey FromHexString(const std::string& hexKey)
+    static Casper::PublicKey FromHexString(std::string_view hexKey)
     {
         try
         {
-            CBytes rawBytes = CEP57Checksum::Decode(hexKey.substr(2));
-            if (hexKey.substr(0, 2) == "01")
+            auto algo = hexKey.substr(0, 2);
+            if (algo != "01" && algo != "02")
             {
-                return FromRawBytes(rawBytes, KeyAlgo::ED25519);
-            }
-            else if (hexKey.substr(0, 2) == "02")
-            {
-                return FromRawBytes(rawBytes, KeyAlgo::SECP256K1);
+                throw std::invalid_argument("Wrong public algorithm identifier.");
             }
-            else
+
+            auto hex = hexKey.substr(2);
+            CBytes rawBytes(hex.size() / 2);
+            HexCodec::Decode(hex, rawBytes.data(), HexMode::Strict);
+            if (!CEP57Checksum::Verify(hex, rawBytes.data()))
             {
-                throw std::invalid_argument("Wrong public algorithm identifier.");
+                throw std::runtime_error("Invalid Checksum in public key: " + std::string(hexKey));
             }
+            return FromRawBytes(rawBytes, algo == "01" ? KeyAlgo::ED25519 : KeyAlgo::SECP256K1);
         }
         catch (std::exception& e)
         {
@@ -211,28 +219,69 @@ public:
     }
 
     /// <summary>
-    /// Returns the Account Hash associated to this Public Key.
+    /// Returns the 32 byte account hash of this Public Key: the BLAKE2b-256
+    /// digest of the algorithm name, a zero byte and the raw bytes. Does not
+    /// allocate.
     /// </summary>
-    std::string GetAccountHash() const
+    Hash32 GetAccountHashBytes() const
     {
-        CBytes sb;
-        std::string algo_str = KeyAlgo::GetName(key_algorithm);
-        CryptoPP::SecByteBlock algo_bytes = hexDecode(StringUtil::getStringBytesWithoutLength(algo_str));
-        CBytes interm_byte(1);
-        interm_byte[0] = 0;
+        auto prefix = AccountHashPrefix(key_algorithm);
+        CryptoPP::BLAKE2b digest(static_cast<unsigned int>(Hash32::SIZE));
+        digest.Update(reinterpret_cast<const uint8_t*>(prefix.data()), prefix.size());
+        digest.Update(raw_bytes.data(), raw_bytes.size());
+
+        Hash32 hash;
+        digest.Final(hash.bytes.data());
+        return hash;
+    }
 
-        sb += algo_bytes;
-        sb += interm_byte;
-        sb += raw_bytes;
+    /// <summary>
+    /// GetAccountHashBytes() of many keys, hashed together with
+    /// Blake2bBatch. The result is in the order of `keys`.
+    /// </summary>
+    static std::vector<Hash32> GetAccountHashBytes(std::span<const PublicKey> keys)
+    {
+        static constexpr size_t max_input = 10 + 33;
 
-        CryptoPP::BLAKE2b bcBl2bdigest(32u);
-        bcBl2bdigest.Update(sb, sb.size());
-        // std::cout << "ComputeBodyHash3" << std::endl;
+        std::vector<uint8_t> messages(max_input * keys.size());
+        std::vector<std::span<const uint8_t>> inputs;
+        inputs.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            auto prefix = AccountHashPrefix(keys[i].key_algorithm);
+            if (prefix.size() + keys[i].raw_bytes.size() > max_input)
+            {
+                throw std::invalid_argument("Wrong public key format. Key too long.");
+            }
+            uint8_t* message = messages.data() + max_input * i;
+            std::memcpy(message, prefix.data(), prefix.size());
+            std::memcpy(message + prefix.size(), keys[i].raw_bytes.data(), keys[i].raw_bytes.size());
+            inputs.emplace_back(message, prefix.size() + keys[i].raw_bytes.size());
+        }
+
+        std::vector<Hash32> hashes(keys.size());
+        Blake2bBatch::Hash(inputs, hashes.empty() ? nullptr : hashes[0].bytes.data());
+        return hashes;
+    }
 
-        CBytes hash(bcBl2bdigest.DigestSize());
-        bcBl2bdigest.Final(hash);
+    /// <summary>
+    /// Returns the Account Hash associated to this Public Key. Use
+    /// PublicKeyTable::AccountHash() for keys converted over and over.
+    /// </summary>
+    std::string GetAccountHash() const { return AccountHashToString(GetAccountHashBytes()); }
 
-        return "account-hash-" + CEP57Checksum::Encode(hash);
+    /// <summary>
+    /// Formats an account hash as GetAccountHash() does: "account-hash-"
+    /// followed by the checksummed hex.
+    /// </summary>
+    static std::string AccountHashToString(const Hash32& hash)
+    {
+        static constexpr std::string_view prefix = "account-hash-";
+
+        std::string result(prefix.size() + 2 * Hash32::SIZE, '\0');
+        std::memcpy(result.data(), prefix.data(), prefix.size());
+        CEP57Checksum::Encode(hash.data(), Hash32::SIZE, result.data() + prefix.size());
+        return result;
     }
 
     /// <summary>
@@ -241,19 +290,13 @@ public:
     /// </summary>
     [[nodiscard]] std::string ToAccountHex() const
     {
-        std::string pk_hex;
-        if (key_algorithm == KeyAlgo::ED25519)
-        {
-            pk_hex = "01" + CEP57Checksum::Encode(raw_bytes);
-        }
-        else if (key_algorithm == KeyAlgo::SECP256K1)
-        {
-            pk_hex = "02" + CEP57Checksum::Encode(raw_bytes);
-        }
-        else
+        if (key_algorithm != KeyAlgo::ED25519 && key_algorithm != KeyAlgo::SECP256K1)
         {
             throw std::runtime_error("Unsupported key type.");
         }
+        std::string pk_hex(2 + 2 * raw_bytes.size(), '0');
+        pk_hex[1] = key_algorithm == KeyAlgo::ED25519 ? '1' : '2';
+        CEP57Checksum::Encode(raw_bytes.data(), raw_bytes.size(), pk_hex.data() + 2);
         return pk_hex;
     }
 
@@ -335,11 +378,45 @@ public:
         return os;
     }
 
-    bool operator<(const Casper::PublicKey& other) const { return ToAccountHex() < other.ToAccountHex(); }
+    /// <summary>
+    /// Orders by key algorithm, then by the raw bytes.
+    /// </summary>
+    bool operator<(const Casper::PublicKey& other) const
+    {
+        if (key_algorithm != other.key_algorithm)
+        {
+            return key_algorithm < other.key_algorithm;
+        }
+        return std::lexicographical_compare(raw_bytes.begin(), raw_bytes.end(), other.raw_bytes.begin(),
+                                            other.raw_bytes.end());
+    }
 
-    bool operator==(const Casper::PublicKey& other) const { return ToAccountHex() == other.ToAccountHex(); }
+    bool operator==(const Casper::PublicKey& other) const
+    {
+        return key_algorithm == other.key_algorithm && raw_bytes == other.raw_bytes;
+    }
 
     bool operator!=(const Casper::PublicKey& other) const { return !(*this == other); }
+
+private:
+    /// <summary>
+    /// Algorithm name and a zero byte, hashed in front of the raw bytes.
+    /// </summary>
+    static std::string_view AccountHashPrefix(KeyAlgo keyAlgo)
+    {
+        static constexpr std::string_view ed25519_prefix("ed25519\0", 8);
+        static constexpr std::string_view secp256k1_prefix("secp256k1\0", 10);
+
+        if (keyAlgo == KeyAlgo::ED25519)
+        {
+            return ed25519_prefix;
+        }
+        else if (keyAlgo == KeyAlgo::SECP256K1)
+        {
+            return secp256k1_prefix;
+        }
+        throw std::invalid_argument("Wrong key algorithm type");
+    }
 };
 
 // to_json of PublicKey
@@ -351,8 +428,7 @@ inline void to_json(nlohmann::json& j, const Casper::PublicKey& p)
 // from_json of PublicKey
 inline void from_json(const nlohmann::json& j, Casper::PublicKey& p)
 {
-    std::string pk_str = j.get<std::string>();
-    p = Casper::PublicKey::FromHexString(pk_str);
+    p = Casper::PublicKey::FromHexString(j.get_ref<const std::string&>());
 }
 
 } // namespace Casper
@@ -0,0 +1,267 @@
+#include "Types/PublicKeyTable.h"
+
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace Casper
+{
+PublicKeyTable& PublicKeyTable::Instance()
+{
+    static PublicKeyTable table(MAX_KEYS);
+    return table;
+}
+
+PublicKeyTable::PublicKeyTable(size_t max_keys)
+    : _max_keys(max_keys)
+{
+}
+
+PublicKeyHandle PublicKeyTable::Intern(std::string_view hex)
+{
+    std::optional<PublicKey> decoded;
+    return InternOrDecode(hex, decoded);
+}
+
+PublicKeyHandle PublicKeyTable::InternOrDecode(std::string_view hex, std::optional<PublicKey>& decoded)
+{
+    {
+        std::shared_lock lock(_mutex);
+        auto it = _hex_handles.find(hex);
+        if (it != _hex_handles.end())
+        {
+            return it->second;
+        }
+    }
+
+    const PublicKey& key = decoded.emplace(PublicKey::FromHexString(hex));
+    if (key.raw_bytes.empty())
+    {
+        throw std::invalid_argument("PublicKeyTable: invalid public key " + std::string(hex));
+    }
+
+    PublicKeyHandle handle = Intern(key);
+    std::unique_lock lock(_mutex);
+    if (handle != PUBLIC_KEY_NOT_INTERNED && _hex_handles.size() < 2 * _descriptors.size())
+    {
+        _hex_handles.emplace(std::string(hex), handle);
+    }
+    return handle;
+}
+
+PublicKeyHandle PublicKeyTable::Intern(const PublicKey& key)
+{
+    BytesKey bytes = MakeBytesKey(key);
+    {
+        std::shared_lock lock(_mutex);
+        auto it = _handles.find(bytes);
+        if (it != _handles.end())
+        {
+            return it->second;
+        }
+    }
+
+    {
+        std::shared_lock lock(_mutex);
+        if (_descriptors.size() >= _max_keys)
+        {
+            return PUBLIC_KEY_NOT_INTERNED;
+        }
+    }
+
+    PublicKeyDescriptor descriptor;
+    descriptor.key = key;
+    descriptor.hex = key.ToAccountHex();
+    descriptor.account_hash = key.GetAccountHash();
+
+    std::unique_lock lock(_mutex);
+    if (_descriptors.size() >= _max_keys && _handles.find(bytes) == _handles.end())
+    {
+        return PUBLIC_KEY_NOT_INTERNED;
+    }
+    auto [it, inserted] = _handles.emplace(bytes, static_cast<PublicKeyHandle>(_descriptors.size()));
+    if (inserted)
+    {
+        _hex_handles.emplace(descriptor.hex, it->second);
+        _descriptors.push_back(std::move(descriptor));
+    }
+    return it->second;
+}
+
+const PublicKeyDescriptor& PublicKeyTable::Get(PublicKeyHandle handle) const
+{
+    std::shared_lock lock(_mutex);
+    if (handle >= _descriptors.size())
+    {
+        throw std::out_of_range("PublicKeyTable: invalid handle " + std::to_string(handle));
+    }
+    return _descriptors[handle];
+}
+
+PublicKey PublicKeyTable::Key(std::string_view hex)
+{
+    std::optional<PublicKey> decoded;
+    PublicKeyHandle handle = InternOrDecode(hex, decoded);
+    if (handle == PUBLIC_KEY_NOT_INTERNED)
+    {
+        // a key left out was decoded and checked on the way
+        return std::move(*decoded);
+    }
+    return Get(handle).key;
+}
+
+size_t PublicKeyTable::Size() const
+{
+    std::shared_lock lock(_mutex);
+    return _descriptors.size();
+}
+
+std::string PublicKeyTable::AccountHash(const PublicKey& key)
+{
+    BytesKey bytes = MakeBytesKey(key);
+    {
+        std::shared_lock lock(_mutex);
+        std::lock_guard cache_lock(_cache_mutex);
+        if (const std::string* account_hash = FindAccountHash(bytes))
+        {
+            return *account_hash;
+        }
+    }
+
+    std::string account_hash = key.GetAccountHash();
+    std::lock_guard cache_lock(_cache_mutex);
+    CacheAccountHash(bytes, account_hash);
+    return account_hash;
+}
+
+std::vector<std::string> PublicKeyTable::AccountHashes(std::span<const PublicKey> keys, size_t threads)
+{
+    std::vector<std::string> hashes(keys.size());
+
+    // keys to hash, each once however often it repeats in `keys`
+    std::vector<PublicKey> missing;
+    std::vector<BytesKey> missing_bytes;
+    std::vector<size_t> missing_index(keys.size(), keys.size());
+    {
+        std::unordered_map<BytesKey, size_t, BytesKeyHash> pending;
+        std::shared_lock lock(_mutex);
+        std::lock_guard cache_lock(_cache_mutex);
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            BytesKey bytes = MakeBytesKey(keys[i]);
+            if (const std::string* account_hash = FindAccountHash(bytes))
+            {
+                hashes[i] = *account_hash;
+                continue;
+            }
+
+            auto [it, inserted] = pending.emplace(bytes, missing.size());
+            if (inserted)
+            {
+                missing.push_back(keys[i]);
+                missing_bytes.push_back(bytes);
+            }
+            missing_index[i] = it->second;
+        }
+    }
+    if (missing.empty())
+    {
+        return hashes;
+    }
+
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, missing.size());
+
+    std::vector<std::string> computed(missing.size());
+    auto convert = [&](size_t begin, size_t end)
+    {
+        std::span<const PublicKey> chunk(missing.data() + begin, end - begin);
+        std::vector<Hash32> digests = PublicKey::GetAccountHashBytes(chunk);
+        for (size_t i = begin; i < end; i++)
+        {
+            computed[i] = PublicKey::AccountHashToString(digests[i - begin]);
+        }
+    };
+
+    // the calling thread takes the first chunk
+    size_t chunk = (missing.size() + threads - 1) / threads;
+    std::vector<std::future<void>> workers;
+    for (size_t begin = chunk; begin < missing.size(); begin += chunk)
+    {
+        workers.push_back(std::async(std::launch::async, convert, begin, std::min(begin + chunk, missing.size())));
+    }
+    convert(0, chunk);
+    for (auto& worker : workers)
+    {
+        worker.get();
+    }
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        if (missing_index[i] < missing.size())
+        {
+            hashes[i] = computed[missing_index[i]];
+        }
+    }
+
+    // only the last hashes would survive in the cache anyway
+    std::lock_guard cache_lock(_cache_mutex);
+    for (size_t i = missing.size() - std::min(missing.size(), ACCOUNT_HASH_CACHE_SIZE); i < missing.size(); i++)
+    {
+        CacheAccountHash(missing_bytes[i], std::move(computed[i]));
+    }
+    return hashes;
+}
+
+const std::string* PublicKeyTable::FindAccountHash(const BytesKey& bytes)
+{
+    auto handle = _handles.find(bytes);
+    if (handle != _handles.end())
+    {
+        return &_descriptors[handle->second].account_hash;
+    }
+
+    auto cached = _cache.find(bytes);
+    if (cached == _cache.end())
+    {
+        return nullptr;
+    }
+    _cache_order.splice(_cache_order.begin(), _cache_order, cached->second);
+    return &cached->second->second;
+}
+
+void PublicKeyTable::CacheAccountHash(const BytesKey& bytes, std::string account_hash)
+{
+    auto [it, inserted] = _cache.emplace(bytes, _cache_order.end());
+    if (!inserted)
+    {
+        return;
+    }
+    _cache_order.emplace_front(bytes, std::move(account_hash));
+    it->second = _cache_order.begin();
+    if (_cache_order.size() > ACCOUNT_HASH_CACHE_SIZE)
+    {
+        _cache.erase(_cache_order.back().first);
+        _cache_order.pop_back();
+    }
+}
+
+PublicKeyTable::BytesKey PublicKeyTable::MakeBytesKey(const PublicKey& key)
+{
+    // keys are zero padded, only the exact size of the algorithm is unique
+    BytesKey bytes{};
+    if (key.raw_bytes.size() + 1 != static_cast<size_t>(KeyAlgo::GetKeySizeInBytes(key.key_algorithm)))
+    {
+        throw std::invalid_argument("PublicKeyTable: invalid public key size " +
+                                    std::to_string(key.raw_bytes.size()));
+    }
+    bytes[0] = static_cast<uint8_t>(key.key_algorithm);
+    std::copy(key.raw_bytes.begin(), key.raw_bytes.end(), bytes.begin() + 1);
+    return bytes;
+}
+
+} // namespace Casper
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Types/PublicKey.h"
+#include "nlohmann/json.hpp"
+
+namespace Casper
+{
+/// <summary>
+/// Index of a public key in the PublicKeyTable.
+/// </summary>
+using PublicKeyHandle = uint32_t;
+
+/// <summary>
+/// Handle of a key left out of the PublicKeyTable because the table was full.
+/// </summary>
+constexpr PublicKeyHandle PUBLIC_KEY_NOT_INTERNED = std::numeric_limits<PublicKeyHandle>::max();
+
+/// <summary>
+/// One distinct public key, stored once in the PublicKeyTable.
+/// </summary>
+struct PublicKeyDescriptor
+{
+    PublicKey key;
+
+    /// <summary>
+    /// Checksummed hex with the algorithm prefix, as ToAccountHex().
+    /// </summary>
+    std::string hex;
+
+    /// <summary>
+    /// "account-hash-..." string, as GetAccountHash().
+    /// </summary>
+    std::string account_hash;
+};
+
+/// <summary>
+/// Process wide table of interned public keys. Validator keys repeat
+/// thousands of times in auction states, era reports and finality
+/// signatures; each distinct key is decoded, checksummed and hashed once and
+/// later occurrences are a lookup of the hex text as received. Only keys
+/// passed to Intern() are kept for good. Thread safe, descriptors are never
+/// removed or moved.
+/// The keys come from node responses, so the table stops growing at
+/// MAX_KEYS; later keys are left out and decoded each time instead.
+/// </summary>
+class PublicKeyTable
+{
+public:
+    /// <summary>
+    /// Most distinct keys a table holds, well above the validators of an
+    /// era.
+    /// </summary>
+    static constexpr size_t MAX_KEYS = 4096;
+
+    static PublicKeyTable& Instance();
+
+    /// <summary>
+    /// A table separate from Instance(), holding at most `max_keys` keys.
+    /// </summary>
+    explicit PublicKeyTable(size_t max_keys);
+
+    /// <summary>
+    /// Returns the handle for the key in `hex`, adding it to the table if it
+    /// was not there yet. Returns PUBLIC_KEY_NOT_INTERNED if it was not there
+    /// and the table is full. Throws std::invalid_argument if `hex` is not a
+    /// valid public key.
+    /// </summary>
+    PublicKeyHandle Intern(std::string_view hex);
+
+    /// <summary>
+    /// Returns the handle for `key`, adding it to the table if it was not
+    /// there yet. Returns PUBLIC_KEY_NOT_INTERNED if it was not there and the
+    /// table is full. Throws std::invalid_argument if the raw bytes are not
+    /// the size of the key algorithm.
+    /// </summary>
+    PublicKeyHandle Intern(const PublicKey& key);
+
+    /// <summary>
+    /// Returns the descriptor of an interned key.
+    /// </summary>
+    const PublicKeyDescriptor& Get(PublicKeyHandle handle) const;
+
+    /// <summary>
+    /// The key in `hex`, from its descriptor if it is interned or can be
+    /// added, decoded on its own if the table is full. Throws
+    /// std::invalid_argument if `hex` is not a valid public key.
+    /// </summary>
+    PublicKey Key(std::string_view hex);
+
+    /// <summary>
+    /// Number of distinct keys interned so far.
+    /// </summary>
+    size_t Size() const;
+
+    /// <summary>
+    /// Most account hashes kept for keys that were not interned.
+    /// </summary>
+    static constexpr size_t ACCOUNT_HASH_CACHE_SIZE = 4096;
+
+    /// <summary>
+    /// Memoized PublicKey::GetAccountHash(). Interned keys use the hash of
+    /// their descriptor. Other keys are not interned; their hashes are kept
+    /// in a cache of the ACCOUNT_HASH_CACHE_SIZE most recently used ones.
+    /// </summary>
+    std::string AccountHash(const PublicKey& key);
+
+    /// <summary>
+    /// Account hashes of many keys, e.g. all delegators of an auction state.
+    /// Keys found neither in the table nor in the cache are hashed once each
+    /// with Blake2bBatch, split over `threads` workers, by default one per
+    /// core. The result is in the order of `keys`.
+    /// </summary>
+    std::vector<std::string> AccountHashes(std::span<const PublicKey> keys, size_t threads = 0);
+
+private:
+    /// Algorithm byte followed by the raw bytes, zero padded.
+    using BytesKey = std::array<uint8_t, 1 + 33>;
+
+    struct BytesKeyHash
+    {
+        size_t operator()(const BytesKey& key) const
+        {
+            return std::hash<std::string_view>()(
+                std::string_view(reinterpret_cast<const char*>(key.data()), key.size()));
+        }
+    };
+
+    static BytesKey MakeBytesKey(const PublicKey& key);
+
+    /// Intern(hex) that also hands back the key when it had to decode it,
+    /// so that Key() does not decode a key left out of a full table twice.
+    PublicKeyHandle InternOrDecode(std::string_view hex, std::optional<PublicKey>& decoded);
+
+    /// Hash of std::string usable with a std::string_view, so a lookup by
+    /// hex text does not copy it.
+    struct TextHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>()(text); }
+    };
+
+    size_t _max_keys;
+
+    mutable std::shared_mutex _mutex;
+    std::deque<PublicKeyDescriptor> _descriptors;
+
+    /// Keyed by the algorithm byte and the raw bytes.
+    std::unordered_map<BytesKey, PublicKeyHandle, BytesKeyHash> _handles;
+
+    /// Keyed by each hex spelling seen, usually just the node's one. It holds
+    /// at most twice as many spellings as there are keys.
+    std::unordered_map<std::string, PublicKeyHandle, TextHash, std::equal_to<>> _hex_handles;
+
+    /// Returns the account hash of an interned key or a cached one, the
+    /// caller holds _mutex shared and _cache_mutex.
+    const std::string* FindAccountHash(const BytesKey& bytes);
+
+    /// Adds a hash to the cache, dropping the least recently used one past
+    /// ACCOUNT_HASH_CACHE_SIZE. The caller holds _cache_mutex.
+    void CacheAccountHash(const BytesKey& bytes, std::string account_hash);
+
+    /// Account hashes of keys that were not interned, most recently used
+    /// first.
+    std::mutex _cache_mutex;
+    std::list<std::pair<BytesKey, std::string>> _cache_order;
+    std::unordered_map<BytesKey, std::list<std::pair<BytesKey, std::string>>::iterator, BytesKeyHash> _cache;
+};
+
+/// <summary>
+/// Reads a validator public key through the PublicKeyTable. Used by the
+/// result types where validator keys repeat; delegator and account keys
+/// are read with from_json and not interned.
+/// </summary>
+inline void internPublicKey(const nlohmann::json& j, PublicKey& p)
+{
+    p = PublicKeyTable::Instance().Key(j.get_ref<const std::string&>());
+}
+
+/// <summary>
+/// Reads an array of validator public keys through the PublicKeyTable.
+/// </summary>
+inline void internPublicKeys(const nlohmann::json& j, std::vector<PublicKey>& p)
+{
+    p.clear();
+    p.reserve(j.size());
+    for (const auto& key : j)
+    {
+        internPublicKey(key, p.emplace_back());
+    }
+}
+
+} // namespace Casper
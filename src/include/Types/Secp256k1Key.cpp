@@ -97,17 +97,17 @@ std::string Secp256k1Key::sign(std::string message)
     return signature;
 }
 
-CryptoPP::SecByteBlock Secp256k1Key::sign(const CryptoPP::SecByteBlock& message)
+CBytes Secp256k1Key::sign(const CBytes& message)
 {
     CryptoPP::AutoSeededRandomPool prng;
     CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>::Signer signer(_private_key);
 
     size_t siglen = signer.MaxSignatureLength();
-    CryptoPP::SecByteBlock sig_bytes(siglen);
+    CBytes sig_bytes(siglen);
 
     do
     {
-        siglen = signer.SignMessage(prng, (const CryptoPP::byte*)&message[0], message.size(), sig_bytes);
+        siglen = signer.SignMessage(prng, message.data(), message.size(), sig_bytes.data());
         sig_bytes.resize(siglen);
     } while ((sig_bytes[32] & 0x80) == 0x80);
 
@@ -138,11 +138,7 @@ bool Secp256k1Key::verify(std::string message, std::string signature)
 
 std::string Secp256k1Key::signatureToString(std::string signature)
 {
-    CryptoPP::SecByteBlock sig_bytes(signature.size());
-    memcpy(sig_bytes.data(), signature.data(), signature.size());
-    std::string encoded = hexEncode(sig_bytes);
-
-    return encoded;
+    return hexEncode(reinterpret_cast<const uint8_t*>(signature.data()), signature.size());
 }
 
 std::string Secp256k1Key::integerToString(const CryptoPP::Integer& x)
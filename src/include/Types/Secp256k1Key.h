@@ -2,6 +2,8 @@
 #include <cryptopp/eccrypto.h>
 #include <string>
 
+#include "Base.h"
+
 namespace Casper
 {
 
@@ -21,7 +23,7 @@ public:
     /// Sign a message with the private key and return the signature
     std::string sign(std::string message);
 
-    CryptoPP::SecByteBlock sign(const CryptoPP::SecByteBlock& message);
+    CBytes sign(const CBytes& message);
 
     /// Verify the signature on the message using the public key
 
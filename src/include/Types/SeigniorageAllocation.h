@@ -1,5 +1,6 @@
 #pragma once
 #include "Base.h"
+#include "Types/PublicKeyTable.h"
 #include "nlohmann/json.hpp"
 
 namespace Casper
@@ -73,7 +74,7 @@ inline void from_json(const nlohmann::json& j, SeigniorageAllocation& p)
 
     if (typeJSON.find("validator_public_key") != typeJSON.end())
     {
-        typeJSON.at("validator_public_key").get_to(p.validator_public_key);
+        internPublicKey(typeJSON.at("validator_public_key"), p.validator_public_key);
     }
     else
     {
@@ -3,6 +3,7 @@
 #include <optional>
 
 #include "Base.h"
+#include "Types/Hash32.h"
 #include "Types/URef.h"
 #include "nlohmann/json.hpp"
 
@@ -17,7 +18,7 @@ struct Transfer
     /// <summary>
     /// Deploy that created the transfer
     /// </summary>
-    std::string deploy_hash;
+    Hash32 deploy_hash;
 
     /// <summary>
     /// Account hash from which transfer was executed
@@ -18,7 +18,7 @@ struct TransferDeployItem
     TransferDeployItem(uint512_t amount, const AccountHashKey& targetAccountHash, uint64_t id = 0, bool has_id = false)
     {
         args.emplace_back("amount", CLValue::U512(amount));
-        args.emplace_back("target", CLValue::ByteArray(targetAccountHash.raw_bytes));
+        args.emplace_back("target", CLValue::ByteArray(targetAccountHash.GetRawBytes()));
 
         if (!has_id)
         {
@@ -1,141 +1,164 @@
 #include "Types/URef.h"
-#include <sstream>
+
+#include <cstring>
 
 #include "Utils/CEP57Checksum.h"
-#include "Utils/CryptoUtil.h"
-#include "Utils/StringUtil.h"
+#include "Utils/HexCodec.h"
 
 namespace Casper
 {
+namespace
+{
+constexpr std::string_view kPrefix = "uref-";
 
-URef::URef() = default;
+constexpr size_t kAddressOffset = kPrefix.size();
 
-URef::URef(const std::string& value)
-    : GlobalStateKey::GlobalStateKey(value)
-{
-    key_identifier = KeyIdentifier::URef;
-    if (!StringUtil::startsWith(value, "uref-"))
-    {
-        throw std::runtime_error("Invalid URef format");
-    }
+constexpr size_t kRightsOffset = kAddressOffset + 2 * GlobalStateKey::PAYLOAD_SIZE + 1;
 
-    auto parts = StringUtil::splitString(value.substr(5), "-");
+bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
 
-    if (parts.size() != 2)
-        throw std::runtime_error("A URef object must end with an access rights suffix.");
-    if (parts[0].length() != 64)
-        throw std::runtime_error("A URef object must contain a 32 byte value.");
-    if (parts[1].length() != 3)
-        throw std::runtime_error("A URef object must contain a 3 digit access "
-                                 "rights suffix.");
+} // namespace
 
-    try
-    {
-        raw_bytes = CEP57Checksum::Decode(parts[0]);
-    }
-    catch (std::exception& e)
-    {
-        throw std::runtime_error("URef Invalid Checksum.");
-    }
+URef::URef()
+{
+    key_identifier = KeyIdentifier::URef;
+}
 
-    std::istringstream reader(parts[1]);
-    unsigned int val;
-    reader >> val;
-    access_rights = (AccessRights)val;
+URef::URef(const std::string& value)
+    : URef(FromString(value))
+{
 }
 
 std::string URef::byteToStringWithAccessRights(CBytes bytes)
 {
-    std::string prefix = "uref-";
-    std::string encoded;
-
-    CryptoPP::StringSource ss(bytes.data(), bytes.size() - 1, true,
-                              new CryptoPP::HexEncoder(new CryptoPP::StringSink(encoded)) // HexEncoder
-    );                                                                                    // StringSource
-    std::string access_rights_str = std::to_string((uint8_t)bytes[32]);
-    if (access_rights_str.length() == 1)
-    {
-        access_rights_str = "00" + access_rights_str;
-    }
-    else if (access_rights_str.length() == 2)
-    {
-        access_rights_str = "0" + access_rights_str;
-    }
-    return prefix + encoded + "-" + access_rights_str;
+    return URef(bytes).ToString();
 }
 
 std::string URef::byteToString(CBytes bytes, AccessRights rights)
 {
-    std::string prefix = "uref-";
-    std::string encoded;
-
-    CryptoPP::StringSource ss(bytes.data(), bytes.size(), true,
-                              new CryptoPP::HexEncoder(new CryptoPP::StringSink(encoded)) // HexEncoder
-    );                                                                                    // StringSource
-
-    std::string access_rights_str = std::to_string((uint8_t)rights);
-    return prefix + encoded + "-" + access_rights_str;
+    return URef(bytes, rights).ToString();
 }
 
 /// <summary>
 /// Creates an URef from a 33 bytes array. Last byte corresponds to the access
 /// rights.
 /// </summary>
-
 URef::URef(const CBytes& bytes)
-    : URef::URef(byteToStringWithAccessRights(bytes))
 {
+    if (bytes.size() != PAYLOAD_SIZE + 1)
+    {
+        throw std::runtime_error("A URef object must contain a 32 byte value and the access rights.");
+    }
+    if (bytes[PAYLOAD_SIZE] > static_cast<uint8_t>(AccessRights::READ_ADD_WRITE))
+    {
+        throw std::runtime_error("Invalid URef access rights.");
+    }
+    key_identifier = KeyIdentifier::URef;
+    std::copy(bytes.begin(), bytes.begin() + PAYLOAD_SIZE, payload.begin());
+    access_rights = static_cast<AccessRights>(bytes[PAYLOAD_SIZE]);
 }
 
 /// <summary>
 /// Creates an URef from a 32 bytes array and the access rights.
 /// </summary>
 URef::URef(CBytes rawBytes, AccessRights accessRights)
-    : URef::URef(byteToString(rawBytes, accessRights))
 {
+    if (rawBytes.size() != PAYLOAD_SIZE)
+    {
+        throw std::runtime_error("A URef object must contain a 32 byte value.");
+    }
+    key_identifier = KeyIdentifier::URef;
+    std::copy(rawBytes.begin(), rawBytes.end(), payload.begin());
+    access_rights = accessRights;
 }
 
-CBytes URef::GetBytes()
+/// <summary>
+/// Creates an URef from its 32 byte address and the access rights.
+/// </summary>
+URef::URef(const std::array<uint8_t, PAYLOAD_SIZE>& address, AccessRights accessRights)
 {
-    CBytes returned_bytes(34);
-    returned_bytes[0] = (uint8_t)key_identifier;
-
-    std::copy(raw_bytes.begin(), raw_bytes.end(), returned_bytes.begin() + 1);
-    returned_bytes[33] = (uint8_t)access_rights;
-
-    return returned_bytes;
+    key_identifier = KeyIdentifier::URef;
+    payload = address;
+    access_rights = accessRights;
 }
 
-std::string URef::ToString() const
+URef URef::FromString(std::string_view value)
 {
-    std::string access_rights_str = std::to_string((uint8_t)access_rights);
-    if (access_rights_str.length() == 1)
-        access_rights_str = "00" + access_rights_str;
-    else if (access_rights_str.length() == 2)
-        access_rights_str = "0" + access_rights_str;
+    if (!value.starts_with(kPrefix))
+    {
+        throw std::runtime_error("Invalid URef format");
+    }
+    if (value.size() != STRING_SIZE || value[kRightsOffset - 1] != '-')
+    {
+        throw std::runtime_error("A URef object must end with an access rights suffix.");
+    }
 
-    return "uref-" + CEP57Checksum::Encode(_GetRawBytesFromKey(key)) + "-" + access_rights_str;
-}
+    const char* rights = value.data() + kRightsOffset;
+    if (!IsDigit(rights[0]) || !IsDigit(rights[1]) || !IsDigit(rights[2]))
+    {
+        throw std::runtime_error("A URef object must contain a 3 digit access rights suffix.");
+    }
+    int rights_value = (rights[0] - '0') * 100 + (rights[1] - '0') * 10 + (rights[2] - '0');
+    if (rights_value > static_cast<int>(AccessRights::READ_ADD_WRITE))
+    {
+        throw std::runtime_error("A URef object must contain a 3 digit access rights suffix.");
+    }
 
-CBytes URef::_GetRawBytesFromKey(const std::string& key) const
-{
-    std::string new_key = key.substr(0, key.find_last_of('-'));
-    return CryptoUtil::hexDecode(new_key.substr(new_key.find_last_of('-') + 1));
+    URef uref;
+    auto address = value.substr(kAddressOffset, 2 * PAYLOAD_SIZE);
+    try
+    {
+        HexCodec::Decode(address, uref.payload.data(), HexMode::Strict);
+    }
+    catch (const std::invalid_argument&)
+    {
+        throw std::runtime_error("URef Invalid Checksum.");
+    }
+    if (!CEP57Checksum::Verify(address, uref.payload.data()))
+    {
+        throw std::runtime_error("URef Invalid Checksum.");
+    }
+    uref.access_rights = static_cast<AccessRights>(rights_value);
+    return uref;
 }
 
-bool URef::operator<(const URef& other) const
+std::vector<URef> URef::FromStrings(std::span<const std::string> values)
 {
-    return ToString() < other.ToString();
+    std::vector<URef> urefs;
+    urefs.reserve(values.size());
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        try
+        {
+            urefs.push_back(FromString(values[i]));
+        }
+        catch (const std::runtime_error& e)
+        {
+            throw std::runtime_error("URef at index " + std::to_string(i) + ": " + e.what());
+        }
+    }
+    return urefs;
 }
 
-bool URef::operator==(const URef& other) const
+void URef::Format(char* out) const
 {
-    return ToString() == other.ToString();
+    std::memcpy(out, kPrefix.data(), kPrefix.size());
+    CEP57Checksum::Encode(payload.data(), PAYLOAD_SIZE, out + kAddressOffset);
+    auto rights = static_cast<uint8_t>(access_rights);
+    out[kRightsOffset - 1] = '-';
+    out[kRightsOffset] = static_cast<char>('0' + rights / 100);
+    out[kRightsOffset + 1] = static_cast<char>('0' + rights / 10 % 10);
+    out[kRightsOffset + 2] = static_cast<char>('0' + rights % 10);
 }
 
-bool URef::operator!=(const URef& other) const
+std::string URef::ToString() const
 {
-    return ToString() != other.ToString();
+    std::string result(STRING_SIZE, '\0');
+    Format(result.data());
+    return result;
 }
 
 } // namespace Casper
@@ -1,14 +1,12 @@
 #pragma once
 
+#include <span>
+#include <string_view>
+#include <vector>
+
 #include "Base.h"
 #include "Types/AccessRights.h"
 #include "Types/GlobalStateKey.h"
-#include "Utils/CEP57Checksum.h"
-#include "Utils/CryptoUtil.h"
-#include "Utils/StringUtil.h"
-// Crypto
-#include <cryptopp/secblock.h>
-
 // JSON
 #include "nlohmann/json.hpp"
 
@@ -21,7 +19,10 @@ namespace Casper
 /// </summary>
 struct URef : public GlobalStateKey
 {
-    AccessRights access_rights;
+    /// <summary>
+    /// Length of "uref-<64 hex digits>-<3 digit access rights>".
+    /// </summary>
+    static constexpr size_t STRING_SIZE = 5 + 2 * PAYLOAD_SIZE + 4;
 
     URef();
 
@@ -35,18 +36,28 @@ struct URef : public GlobalStateKey
 
     URef(CBytes rawBytes, AccessRights accessRights);
 
-    CBytes GetBytes();
+    URef(const std::array<uint8_t, PAYLOAD_SIZE>& address, AccessRights accessRights);
 
-    std::string ToString() const;
+    /// <summary>
+    /// Parses "uref-<hex>-<rights>" straight into the address and access
+    /// rights, without intermediate strings. Throws std::runtime_error on a
+    /// malformed value or a checksum mismatch.
+    /// </summary>
+    static URef FromString(std::string_view value);
 
-    bool operator<(const URef& other) const;
+    /// <summary>
+    /// Parses many URefs, e.g. the purses of a list of transfers or unbonding
+    /// purses. The error names the index of the first invalid value.
+    /// </summary>
+    static std::vector<URef> FromStrings(std::span<const std::string> values);
 
-    bool operator==(const URef& other) const;
+    /// <summary>
+    /// Writes the STRING_SIZE characters of the checksummed string form to
+    /// `out`, without allocating.
+    /// </summary>
+    void Format(char* out) const;
 
-    bool operator!=(const URef& other) const;
-
-protected:
-    CBytes _GetRawBytesFromKey(const std::string& key) const;
+    std::string ToString() const;
 };
 
 /**
@@ -58,8 +69,7 @@ protected:
 
 inline void to_json(nlohmann::json& j, const URef& p)
 {
-    j = static_cast<GlobalStateKey>(p);
-    // j.update(p.access_rights);
+    j = p.ToString();
 }
 
 /**
@@ -71,46 +81,7 @@ inline void to_json(nlohmann::json& j, const URef& p)
 
 inline void from_json(const nlohmann::json& j, URef& p)
 {
-    std::string value = j.get<std::string>();
-    p.key_identifier = KeyIdentifier::URef;
-    p.key = value;
-
-    if (!StringUtil::startsWith(value, "uref-"))
-    {
-        throw std::runtime_error("Invalid URef format");
-    }
-
-    auto parts = StringUtil::splitString(value.substr(5), "-");
-
-    if (parts.size() != 2)
-    {
-        throw std::runtime_error("A URef object must end with an access rights suffix.");
-    }
-
-    if (parts[0].length() != 64)
-    {
-        throw std::runtime_error("A URef object must contain a 32 byte value.");
-    }
-
-    if (parts[1].length() != 3)
-    {
-        throw std::runtime_error("A URef object must contain a 3 digit access "
-                                 "rights suffix.");
-    }
-
-    try
-    {
-        p.raw_bytes = CEP57Checksum::Decode(parts[0]);
-    }
-    catch (std::exception& e)
-    {
-        throw std::runtime_error("URef checksum mismatch.");
-    }
-
-    std::istringstream reader(parts[1]);
-    unsigned int val;
-    reader >> val;
-    p.access_rights = (AccessRights)val;
+    p = URef::FromString(j.get_ref<const std::string&>());
 }
 
 } // namespace Casper
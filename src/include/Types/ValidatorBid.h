@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "Types/Bid.h"
+#include "Types/PublicKeyTable.h"
 #include "nlohmann/json.hpp"
 
 namespace Casper
@@ -43,7 +44,7 @@ inline void from_json(const nlohmann::json& j, ValidatorBid& p)
 {
     if (j.find("public_key") != j.end())
     {
-        j.at("public_key").get_to(p.public_key);
+        internPublicKey(j.at("public_key"), p.public_key);
     }
     else
     {
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Types/PublicKey.h"
+#include "Types/PublicKeyTable.h"
 #include "nlohmann/json.hpp"
 
 namespace Casper
@@ -53,6 +53,6 @@ inline void from_json(const nlohmann::json& j, ValidatorWeight& p)
         p.weight = 0;
     }
 
-    j.at("public_key").get_to(p.public_key);
+    internPublicKey(j.at("public_key"), p.public_key);
 }
 } // namespace Casper
\ No newline at end of file
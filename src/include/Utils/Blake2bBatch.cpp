@@ -0,0 +1,279 @@
+#include "Utils/Blake2bBatch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include <cryptopp/blake2.h>
+
+#include "Utils/CpuFeatures.h"
+
+namespace Casper
+{
+namespace
+{
+constexpr size_t kBlockSize = 128;
+
+size_t BlockCount(std::span<const uint8_t> input)
+{
+    return std::max<size_t>(1, (input.size() + kBlockSize - 1) / kBlockSize);
+}
+
+void HashScalar(std::span<const uint8_t> input, uint8_t* digest)
+{
+    CryptoPP::BLAKE2b hash(static_cast<unsigned int>(Blake2bBatch::DIGEST_SIZE));
+    hash.Update(input.data(), input.size());
+    hash.Final(digest);
+}
+
+#ifdef CASPER_X86
+constexpr uint64_t kIV[8] = {0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
+                             0xa54ff53a5f1d36f1ULL, 0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+                             0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
+
+constexpr uint8_t kSigma[12][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4}, {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13}, {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11}, {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5}, {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}};
+
+CASPER_TARGET_AVX2 inline __m256i Rotr32(__m256i x)
+{
+    return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+CASPER_TARGET_AVX2 inline __m256i Rotr24(__m256i x)
+{
+    const __m256i r24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1,
+                                         2, 11, 12, 13, 14, 15, 8, 9, 10);
+    return _mm256_shuffle_epi8(x, r24);
+}
+
+CASPER_TARGET_AVX2 inline __m256i Rotr16(__m256i x)
+{
+    const __m256i r16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0,
+                                         1, 10, 11, 12, 13, 14, 15, 8, 9);
+    return _mm256_shuffle_epi8(x, r16);
+}
+
+CASPER_TARGET_AVX2 inline __m256i Rotr63(__m256i x)
+{
+    return _mm256_or_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x));
+}
+
+CASPER_TARGET_AVX2 inline void G(__m256i* v, int a, int b, int c, int d, __m256i x, __m256i y)
+{
+    v[a] = _mm256_add_epi64(_mm256_add_epi64(v[a], v[b]), x);
+    v[d] = Rotr32(_mm256_xor_si256(v[d], v[a]));
+    v[c] = _mm256_add_epi64(v[c], v[d]);
+    v[b] = Rotr24(_mm256_xor_si256(v[b], v[c]));
+    v[a] = _mm256_add_epi64(_mm256_add_epi64(v[a], v[b]), y);
+    v[d] = Rotr16(_mm256_xor_si256(v[d], v[a]));
+    v[c] = _mm256_add_epi64(v[c], v[d]);
+    v[b] = Rotr63(_mm256_xor_si256(v[b], v[c]));
+}
+
+CASPER_TARGET_AVX2 inline __m256i Lanes(const uint64_t (&values)[4])
+{
+    return _mm256_setr_epi64x(static_cast<long long>(values[0]), static_cast<long long>(values[1]),
+                              static_cast<long long>(values[2]), static_cast<long long>(values[3]));
+}
+
+/// Hashes up to four inputs, one per 64 bit lane. A lane whose input has
+/// fewer blocks than the others keeps its state once its last block is done;
+/// lanes without an input stay idle.
+CASPER_TARGET_AVX2 void Hash4(const std::span<const uint8_t>* const (&inputs)[4], uint8_t* const (&digests)[4])
+{
+    static const uint8_t zero_block[kBlockSize] = {};
+
+    size_t blocks[4];
+    size_t max_blocks = 0;
+    for (int lane = 0; lane < 4; lane++)
+    {
+        blocks[lane] = inputs[lane] ? BlockCount(*inputs[lane]) : 0;
+        max_blocks = std::max(max_blocks, blocks[lane]);
+    }
+
+    __m256i h[8];
+    for (int i = 0; i < 8; i++)
+    {
+        h[i] = _mm256_set1_epi64x(static_cast<long long>(kIV[i]));
+    }
+    // parameter block: digest length, no key, fanout and depth 1
+    h[0] = _mm256_xor_si256(h[0], _mm256_set1_epi64x(0x01010000 ^ Blake2bBatch::DIGEST_SIZE));
+
+    alignas(32) uint8_t tails[4][kBlockSize];
+    for (size_t b = 0; b < max_blocks; b++)
+    {
+        const uint8_t* block[4];
+        uint64_t counter[4];
+        uint64_t last[4];
+        uint64_t active[4];
+        for (int lane = 0; lane < 4; lane++)
+        {
+            block[lane] = zero_block;
+            counter[lane] = 0;
+            last[lane] = 0;
+            active[lane] = 0;
+            if (b >= blocks[lane])
+            {
+                continue;
+            }
+
+            const auto& input = *inputs[lane];
+            active[lane] = ~0ULL;
+            if (b + 1 < blocks[lane])
+            {
+                block[lane] = input.data() + b * kBlockSize;
+                counter[lane] = (b + 1) * kBlockSize;
+            }
+            else
+            {
+                // the last block is zero padded and flagged as final
+                size_t rest = input.size() - b * kBlockSize;
+                std::memset(tails[lane], 0, kBlockSize);
+                if (rest > 0)
+                {
+                    std::memcpy(tails[lane], input.data() + b * kBlockSize, rest);
+                }
+                block[lane] = tails[lane];
+                counter[lane] = input.size();
+                last[lane] = ~0ULL;
+            }
+        }
+
+        __m256i m[16];
+        for (int j = 0; j < 16; j++)
+        {
+            uint64_t words[4];
+            for (int lane = 0; lane < 4; lane++)
+            {
+                std::memcpy(&words[lane], block[lane] + 8 * j, 8);
+            }
+            m[j] = Lanes(words);
+        }
+
+        __m256i v[16];
+        for (int i = 0; i < 8; i++)
+        {
+            v[i] = h[i];
+            v[i + 8] = _mm256_set1_epi64x(static_cast<long long>(kIV[i]));
+        }
+        v[12] = _mm256_xor_si256(v[12], Lanes(counter));
+        v[14] = _mm256_xor_si256(v[14], Lanes(last));
+
+        for (const auto& s : kSigma)
+        {
+            G(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+            G(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+            G(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+            G(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+            G(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+            G(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+            G(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+            G(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+        }
+
+        __m256i mask = Lanes(active);
+        for (int i = 0; i < 8; i++)
+        {
+            __m256i updated = _mm256_xor_si256(h[i], _mm256_xor_si256(v[i], v[i + 8]));
+            h[i] = _mm256_blendv_epi8(h[i], updated, mask);
+        }
+    }
+
+    // the digest is the first four state words of each lane, little endian
+    alignas(32) uint64_t words[4][4];
+    for (int i = 0; i < 4; i++)
+    {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(words[i]), h[i]);
+    }
+    for (int lane = 0; lane < 4; lane++)
+    {
+        if (inputs[lane])
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                std::memcpy(digests[lane] + 8 * i, &words[i][lane], 8);
+            }
+        }
+    }
+}
+
+void HashAVX2(std::span<const std::span<const uint8_t>> inputs, uint8_t* digests)
+{
+    // inputs of similar length share a pass, so few lanes sit idle
+    std::vector<size_t> order(inputs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t a, size_t b) { return BlockCount(inputs[a]) < BlockCount(inputs[b]); });
+
+    for (size_t i = 0; i < order.size(); i += 4)
+    {
+        size_t lanes = std::min<size_t>(4, order.size() - i);
+        if (lanes == 1)
+        {
+            HashScalar(inputs[order[i]], digests + Blake2bBatch::DIGEST_SIZE * order[i]);
+            continue;
+        }
+
+        const std::span<const uint8_t>* group[4] = {};
+        uint8_t* group_digests[4] = {};
+        for (size_t lane = 0; lane < lanes; lane++)
+        {
+            group[lane] = &inputs[order[i + lane]];
+            group_digests[lane] = digests + Blake2bBatch::DIGEST_SIZE * order[i + lane];
+        }
+        Hash4(group, group_digests);
+    }
+}
+#endif
+
+Blake2bKernel SelectKernel()
+{
+#ifdef CASPER_X86
+    return CpuHasAVX2() ? Blake2bKernel::AVX2 : Blake2bKernel::Scalar;
+#else
+    return Blake2bKernel::Scalar;
+#endif
+}
+
+} // namespace
+
+Blake2bKernel Blake2bBatch::ActiveKernel()
+{
+    static const Blake2bKernel kernel = SelectKernel();
+    return kernel;
+}
+
+bool Blake2bBatch::IsSupported(Blake2bKernel kernel)
+{
+    return kernel == Blake2bKernel::Scalar || ActiveKernel() == kernel;
+}
+
+void Blake2bBatch::Hash(std::span<const std::span<const uint8_t>> inputs, uint8_t* digests)
+{
+    Hash(ActiveKernel(), inputs, digests);
+}
+
+void Blake2bBatch::Hash(Blake2bKernel kernel, std::span<const std::span<const uint8_t>> inputs, uint8_t* digests)
+{
+    switch (kernel)
+    {
+#ifdef CASPER_X86
+    case Blake2bKernel::AVX2:
+        HashAVX2(inputs, digests);
+        return;
+#endif
+    default:
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            HashScalar(inputs[i], digests + DIGEST_SIZE * i);
+        }
+    }
+}
+
+} // namespace Casper
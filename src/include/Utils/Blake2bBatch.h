@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Casper
+{
+/// <summary>
+/// Implementation used by Blake2bBatch, AVX2 is picked at startup when the
+/// CPU supports it.
+/// </summary>
+enum class Blake2bKernel
+{
+    /// <summary>
+    /// One CryptoPP::BLAKE2b per input.
+    /// </summary>
+    Scalar,
+    /// <summary>
+    /// Four inputs per pass, one in each 64 bit lane of the AVX2 registers.
+    /// </summary>
+    AVX2
+};
+
+/// <summary>
+/// BLAKE2b-256 of many independent inputs at once: deploy bodies and headers,
+/// CEP-57 checksums, account hashes. The inputs are sorted by block count and
+/// hashed four at a time, so lanes of similar length run together; inputs of
+/// any length can be mixed.
+/// </summary>
+struct Blake2bBatch
+{
+    static constexpr size_t DIGEST_SIZE = 32;
+
+    /// <summary>
+    /// Writes the digest of inputs[i] to digests + DIGEST_SIZE * i.
+    /// </summary>
+    static void Hash(std::span<const std::span<const uint8_t>> inputs, uint8_t* digests);
+
+    /// <summary>
+    /// Same as Hash() with the given kernel, for tests and benchmarks. The
+    /// kernel must be supported.
+    /// </summary>
+    static void Hash(Blake2bKernel kernel, std::span<const std::span<const uint8_t>> inputs, uint8_t* digests);
+
+    /// <summary>
+    /// The kernel used by Hash().
+    /// </summary>
+    static Blake2bKernel ActiveKernel();
+
+    static bool IsSupported(Blake2bKernel kernel);
+};
+
+} // namespace Casper
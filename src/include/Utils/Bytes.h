@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+
+namespace Casper
+{
+/// <summary>
+/// Byte buffer for non-secret data: serialized values, hashes, public keys and
+/// signatures. Up to INLINE_CAPACITY bytes are stored in the object itself so
+/// the common small buffers never allocate. Private key material stays in
+/// CryptoPP::SecByteBlock, which is zeroized when freed.
+/// </summary>
+class Bytes
+{
+public:
+    /// <summary>
+    /// Enough for account hashes, public keys and signatures, including a
+    /// tagged secp256k1 signature or uncompressed key of 65 bytes.
+    /// </summary>
+    static constexpr size_t INLINE_CAPACITY = 72;
+
+    using value_type = uint8_t;
+    using size_type = size_t;
+    using iterator = uint8_t*;
+    using const_iterator = const uint8_t*;
+
+    Bytes() = default;
+
+    /// <summary>
+    /// `size` zero bytes.
+    /// </summary>
+    explicit Bytes(size_t size) { resize(size); }
+
+    Bytes(const uint8_t* data, size_t size) { Assign(data, size); }
+
+    Bytes(std::initializer_list<uint8_t> init) { Assign(init.begin(), init.size()); }
+
+    Bytes(const Bytes& other) { Assign(other.data(), other.size()); }
+
+    Bytes(Bytes&& other) noexcept { MoveFrom(other); }
+
+    ~Bytes() { delete[] _heap; }
+
+    Bytes& operator=(const Bytes& other)
+    {
+        if (this != &other)
+        {
+            Assign(other.data(), other.size());
+        }
+        return *this;
+    }
+
+    Bytes& operator=(Bytes&& other) noexcept
+    {
+        if (this != &other)
+        {
+            delete[] _heap;
+            _heap = nullptr;
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    uint8_t* data() { return _heap ? _heap : _inline; }
+
+    const uint8_t* data() const { return _heap ? _heap : _inline; }
+
+    /// <summary>
+    /// Same as data(), named like CryptoPP::SecByteBlock::BytePtr().
+    /// </summary>
+    uint8_t* BytePtr() { return data(); }
+
+    const uint8_t* BytePtr() const { return data(); }
+
+    size_t size() const { return _size; }
+
+    size_t SizeInBytes() const { return _size; }
+
+    size_t capacity() const { return _heap ? _capacity : INLINE_CAPACITY; }
+
+    bool empty() const { return _size == 0; }
+
+    /// <summary>
+    /// True while the content lives in the inline buffer.
+    /// </summary>
+    bool IsInline() const { return _heap == nullptr; }
+
+    iterator begin() { return data(); }
+
+    iterator end() { return data() + _size; }
+
+    const_iterator begin() const { return data(); }
+
+    const_iterator end() const { return data() + _size; }
+
+    uint8_t& operator[](size_t index) { return data()[index]; }
+
+    const uint8_t& operator[](size_t index) const { return data()[index]; }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity <= this->capacity())
+        {
+            return;
+        }
+        auto* heap = new uint8_t[capacity];
+        if (_size > 0)
+        {
+            std::memcpy(heap, data(), _size);
+        }
+        delete[] _heap;
+        _heap = heap;
+        _capacity = capacity;
+    }
+
+    /// <summary>
+    /// Keeps the content, added bytes are zero.
+    /// </summary>
+    void resize(size_t size)
+    {
+        if (size > capacity())
+        {
+            reserve(std::max(size, 2 * _size));
+        }
+        if (size > _size)
+        {
+            std::memset(data() + _size, 0, size - _size);
+        }
+        _size = size;
+    }
+
+    void clear() { _size = 0; }
+
+    void Assign(const uint8_t* data, size_t size)
+    {
+        _size = 0;
+        reserve(size);
+        if (size > 0)
+        {
+            std::memmove(this->data(), data, size);
+        }
+        _size = size;
+    }
+
+    void append(const uint8_t* data, size_t size)
+    {
+        if (size == 0)
+        {
+            return;
+        }
+        if (_size + size > capacity())
+        {
+            // `data` may point into this buffer, which reserve() moves
+            const uint8_t* old_data = this->data();
+            bool aliases = !std::less<const uint8_t*>()(data, old_data) &&
+                           std::less<const uint8_t*>()(data, old_data + _size);
+            size_t offset = aliases ? static_cast<size_t>(data - old_data) : 0;
+            reserve(std::max(_size + size, 2 * _size));
+            if (aliases)
+            {
+                data = this->data() + offset;
+            }
+        }
+        std::memmove(this->data() + _size, data, size);
+        _size += size;
+    }
+
+    Bytes& operator+=(const Bytes& other)
+    {
+        append(other.data(), other.size());
+        return *this;
+    }
+
+    friend Bytes operator+(const Bytes& lhs, const Bytes& rhs)
+    {
+        Bytes result;
+        result.reserve(lhs.size() + rhs.size());
+        result.append(lhs.data(), lhs.size());
+        result.append(rhs.data(), rhs.size());
+        return result;
+    }
+
+    friend bool operator==(const Bytes& lhs, const Bytes& rhs)
+    {
+        return lhs.size() == rhs.size() && (lhs.empty() || std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+    }
+
+    friend bool operator!=(const Bytes& lhs, const Bytes& rhs) { return !(lhs == rhs); }
+
+private:
+    void MoveFrom(Bytes& other) noexcept
+    {
+        _size = other._size;
+        if (other._heap)
+        {
+            _heap = other._heap;
+            _capacity = other._capacity;
+            other._heap = nullptr;
+        }
+        else if (_size > 0)
+        {
+            std::memcpy(_inline, other._inline, _size);
+        }
+        other._size = 0;
+    }
+
+    uint8_t* _heap = nullptr;
+    size_t _size = 0;
+    size_t _capacity = 0;
+    uint8_t _inline[INLINE_CAPACITY];
+};
+
+} // namespace Casper
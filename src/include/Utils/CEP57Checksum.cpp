@@ -1,31 +1,59 @@
 #include "Utils/CEP57Checksum.h"
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+#include "Utils/Blake2bBatch.h"
+#include "Utils/HexCodec.h"
 #include "Utils/StringUtil.h"
 namespace Casper
 {
-constexpr const int SMALL_BYTES_COUNT = 75;
+namespace
+{
 constexpr const char HexChars[]{'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
 
-CBytes CEP57Checksum::_bytes_to_nibbles(CBytes bytes)
+constexpr size_t kHashSize = 32;
+
+void Blake2b256(const uint8_t* data, size_t size, uint8_t* digest)
+{
+    CryptoPP::BLAKE2b hash(static_cast<unsigned int>(kHashSize));
+    hash.Update(data, size);
+    hash.Final(digest);
+}
+
+/// Hex digit of nibble `n`. Letters are upper case when the next bit of the
+/// hash, counted over letters only, is set.
+inline char ChecksumChar(uint8_t n, const uint8_t* hash, size_t& letter)
 {
-    CBytes nibbles(bytes.size() * 2);
-    for (int i = 0; i < bytes.size(); i++)
+    char c = HexChars[n];
+    if (n >= 10)
     {
-        nibbles[i * 2] = (bytes.data()[i] & 0xF0) >> 4;
-        nibbles[i * 2 + 1] = bytes.data()[i] & 0x0F;
+        bool upper = (hash[letter / 8] >> (letter % 8)) & 0x01;
+        letter++;
+        if (upper)
+        {
+            c = static_cast<char>(c - ('a' - 'A'));
+        }
     }
-    return nibbles;
+    return c;
 }
 
-std::vector<bool> CEP57Checksum::_bytes_to_bits_cycle(CBytes bytes)
+/// Lower and upper case letters both present, i.e. a checksum is applied.
+bool HasMixedCase(std::string_view encoded)
 {
-    size_t bit_size = bytes.size() * 8;
-    std::vector<bool> bits(bit_size);
-    for (int i = 0, k = 0; i < bytes.size(); i++)
-        for (int j = 0; j < 8; j++)
-            bits[k++] = ((bytes.data()[i] >> j) & 0x01) == 0x01;
-    return bits;
+    bool has_lower = false;
+    bool has_upper = false;
+    for (char c : encoded)
+    {
+        has_lower |= c >= 'a' && c <= 'f';
+        has_upper |= c >= 'A' && c <= 'F';
+    }
+    return has_lower && has_upper;
 }
 
+} // namespace
+
 bool CEP57Checksum::HasChecksum(const std::string& hex)
 {
     int mix = 0;
@@ -43,42 +71,156 @@ bool CEP57Checksum::HasChecksum(const std::string& hex)
     return mix > 2;
 }
 
-std::string CEP57Checksum::Encode(CBytes decoded)
+void CEP57Checksum::Encode(const uint8_t* data, size_t size, char* out)
+{
+    if (size > SMALL_BYTES_COUNT)
+    {
+        HexCodec::Encode(data, size, out);
+        return;
+    }
+
+    uint8_t hash[kHashSize];
+    Blake2b256(data, size, hash);
+
+    size_t letter = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        out[2 * i] = ChecksumChar(data[i] >> 4, hash, letter);
+        out[2 * i + 1] = ChecksumChar(data[i] & 0x0F, hash, letter);
+    }
+}
+
+std::string CEP57Checksum::Encode(const CBytes& decoded)
+{
+    std::string encoded(2 * decoded.size(), '0');
+    Encode(decoded.data(), decoded.size(), encoded.data());
+    return encoded;
+}
+
+bool CEP57Checksum::MatchesChecksum(const uint8_t* decoded, size_t size, std::string_view encoded)
+{
+    uint8_t hash[kHashSize];
+    Blake2b256(decoded, size, hash);
+    return MatchesChecksum(decoded, size, encoded, hash);
+}
+
+bool CEP57Checksum::MatchesChecksum(const uint8_t* decoded, size_t size, std::string_view encoded,
+                                    const uint8_t* hash)
 {
-    if (decoded.size() > SMALL_BYTES_COUNT)
+    size_t letter = 0;
+    for (size_t i = 0; i < size; i++)
     {
-        std::string encoded;
+        if (ChecksumChar(decoded[i] >> 4, hash, letter) != encoded[2 * i] ||
+            ChecksumChar(decoded[i] & 0x0F, hash, letter) != encoded[2 * i + 1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
-        CStringSource ss(decoded, decoded.size(), true,
-                         new CHexEncoder(new CStringSink(encoded)) // HexEncoder
-        );                                                         // StringSource
-        return encoded;
+bool CEP57Checksum::Verify(std::string_view encoded)
+{
+    if (encoded.size() % 2 != 0)
+    {
+        return false;
     }
 
-    CBytes nibbles = _bytes_to_nibbles(decoded);
+    uint8_t decoded[SMALL_BYTES_COUNT];
+    if (encoded.size() / 2 > SMALL_BYTES_COUNT)
+    {
+        // long inputs carry no checksum, only the digits are checked
+        for (char c : encoded)
+        {
+            if (!std::isxdigit(static_cast<unsigned char>(c)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 
-    CryptoPP::BLAKE2b hash(32u);
-    hash.Update(decoded.data(), decoded.size());
-    CBytes digest_bytes(hash.DigestSize());
-    hash.Final(digest_bytes.data());
+    try
+    {
+        HexCodec::Decode(encoded, decoded, HexMode::Strict);
+    }
+    catch (const std::invalid_argument&)
+    {
+        return false;
+    }
 
-    std::vector<bool> hashBits = _bytes_to_bits_cycle(digest_bytes);
+    return Verify(encoded, decoded);
+}
 
-    std::string encoded_bytes(nibbles.size(), '0');
+bool CEP57Checksum::Verify(std::string_view encoded, const uint8_t* decoded)
+{
+    if (encoded.size() / 2 > SMALL_BYTES_COUNT)
+    {
+        return true;
+    }
 
-    int k = 0;
-    int i = 0;
+    // all lower or all upper case means no checksum
+    if (!HasMixedCase(encoded))
+    {
+        return true;
+    }
+    return MatchesChecksum(decoded, encoded.size() / 2, encoded);
+}
 
-    for (auto& n : nibbles)
+size_t CEP57Checksum::VerifyBatch(std::span<const std::string> encoded)
+{
+    // decode everything first, then hash the checksummed ones in one batch
+    size_t decoded_size = 0;
+    for (const auto& hex : encoded)
     {
-        char c = HexChars[n];
-        if ((c >= 'a' && c <= 'f') && hashBits[k++])
-            encoded_bytes[i++] = (char)(c - ('a' - 'A'));
-        else
-            encoded_bytes[i++] = c;
+        decoded_size += std::min(hex.size() / 2, SMALL_BYTES_COUNT);
     }
+    std::vector<uint8_t> decoded(decoded_size);
+    std::vector<size_t> checked;
+    std::vector<std::span<const uint8_t>> inputs;
 
-    return encoded_bytes;
+    size_t first_invalid = encoded.size();
+    uint8_t* out = decoded.data();
+    for (size_t i = 0; i < encoded.size(); i++)
+    {
+        const auto& hex = encoded[i];
+        if (hex.size() % 2 != 0 || hex.size() / 2 > SMALL_BYTES_COUNT)
+        {
+            if (!Verify(hex))
+            {
+                first_invalid = i;
+                break;
+            }
+            continue;
+        }
+
+        try
+        {
+            HexCodec::Decode(hex, out, HexMode::Strict);
+        }
+        catch (const std::invalid_argument&)
+        {
+            first_invalid = i;
+            break;
+        }
+        if (HasMixedCase(hex))
+        {
+            checked.push_back(i);
+            inputs.emplace_back(out, hex.size() / 2);
+        }
+        out += hex.size() / 2;
+    }
+
+    std::vector<uint8_t> hashes(kHashSize * inputs.size());
+    Blake2bBatch::Hash(inputs, hashes.data());
+    for (size_t k = 0; k < checked.size(); k++)
+    {
+        if (!MatchesChecksum(inputs[k].data(), inputs[k].size(), encoded[checked[k]], &hashes[kHashSize * k]))
+        {
+            return checked[k];
+        }
+    }
+    return first_invalid;
 }
 
 CBytes CEP57Checksum::Decode(const std::string& encoded)
@@ -89,10 +231,9 @@ CBytes CEP57Checksum::Decode(const std::string& encoded)
         return decoded;
     }
 
-    std::string computed = Encode(decoded);
-    if (computed != encoded)
+    if (encoded.size() != 2 * decoded.size() || !MatchesChecksum(decoded.data(), decoded.size(), encoded))
     {
-        throw std::runtime_error("Invalid Checksum computed:" + computed + "\n encoded: " + encoded);
+        throw std::runtime_error("Invalid Checksum computed:" + Encode(decoded) + "\n encoded: " + encoded);
     }
 
     return decoded;
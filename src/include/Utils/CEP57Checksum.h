@@ -1,8 +1,10 @@
 #pragma once
 
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 // Utils
 #include "Utils/CryptoUtil.h"
@@ -20,17 +22,49 @@ namespace Casper
 {
 class CEP57Checksum
 {
-private:
-    static CBytes _bytes_to_nibbles(CBytes bytes);
-
-    static std::vector<bool> _bytes_to_bits_cycle(CBytes bytes);
-
 public:
+    /// <summary>
+    /// Inputs longer than this are encoded in plain lowercase hex.
+    /// </summary>
+    static constexpr size_t SMALL_BYTES_COUNT = 75;
+
     static bool HasChecksum(const std::string& hex);
 
-    static std::string Encode(CBytes decoded);
+    static std::string Encode(const CBytes& decoded);
 
     static CBytes Decode(const std::string& encoded);
+
+    /// <summary>
+    /// Writes the 2 * `size` checksummed hex digits of `data` to `out`,
+    /// without allocating.
+    /// </summary>
+    static void Encode(const uint8_t* data, size_t size, char* out);
+
+    /// <summary>
+    /// Returns true if `encoded` is valid hex and, when it carries a checksum,
+    /// the checksum matches. Does not allocate.
+    /// </summary>
+    static bool Verify(std::string_view encoded);
+
+    /// <summary>
+    /// Same as Verify() for hex that was already decoded into `decoded`, so
+    /// only the letter case is checked.
+    /// </summary>
+    static bool Verify(std::string_view encoded, const uint8_t* decoded);
+
+    /// <summary>
+    /// Verifies many hex strings, e.g. the deploy hashes of a block. The
+    /// checksums are hashed together with Blake2bBatch. Returns the index of
+    /// the first one failing, or encoded.size() if all pass.
+    /// </summary>
+    static size_t VerifyBatch(std::span<const std::string> encoded);
+
+private:
+    /// Compares the letter case of `encoded` with the checksum of `decoded`.
+    static bool MatchesChecksum(const uint8_t* decoded, size_t size, std::string_view encoded);
+
+    /// Same with the BLAKE2b-256 digest of `decoded` already computed.
+    static bool MatchesChecksum(const uint8_t* decoded, size_t size, std::string_view encoded, const uint8_t* hash);
 };
 
 } // namespace Casper
@@ -0,0 +1,45 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CASPER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CASPER_TARGET_AVX2
+#else
+#define CASPER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Casper
+{
+#ifdef CASPER_X86
+/// <summary>
+/// True when both the CPU and the OS support AVX2. Checked once.
+/// </summary>
+inline bool CpuHasAVX2()
+{
+    static const bool avx2 = []
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+        {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        bool has_avx2 = (info[1] & (1 << 5)) != 0;
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        return has_avx2 && osxsave && (_xgetbv(0) & 0x6) == 0x6;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }();
+    return avx2;
+}
+#endif
+
+} // namespace Casper
@@ -12,19 +12,13 @@ namespace Casper
 {
 CBytes CryptoUtil::hexDecode(const std::string& encoded)
 {
-    CStringSource ss(encoded, true, new CHexDecoder);
-    CBytes decoded((size_t)ss.MaxRetrievable());
-    ss.Get(decoded, decoded.size());
-    return decoded;
+    return Casper::hexDecode(encoded);
 }
 
-std::string CryptoUtil::hexEncode(CBytes decoded)
+std::string CryptoUtil::hexEncode(const CBytes& decoded)
 {
-    std::string encoded;
-
-    CStringSource ss(decoded, decoded.size(), true,
-                     new CHexEncoder(new CStringSink(encoded)) // HexEncoder
-    );
+    std::string encoded(2 * decoded.size(), '\0');
+    HexCodec::Encode(decoded.data(), decoded.size(), encoded.data(), HexCase::Upper);
     return encoded;
 }
 
@@ -11,7 +11,7 @@ struct CryptoUtil
 {
     static CBytes hexDecode(const std::string& hex);
 
-    static std::string hexEncode(CBytes bytes);
+    static std::string hexEncode(const CBytes& bytes);
 
     static std::string timeToRFC3339(time_t time);
 };
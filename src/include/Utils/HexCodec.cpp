@@ -0,0 +1,338 @@
+#include "Utils/HexCodec.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "Utils/CpuFeatures.h"
+
+namespace Casper
+{
+namespace
+{
+constexpr char kLowerDigits[] = "0123456789abcdef";
+constexpr char kUpperDigits[] = "0123456789ABCDEF";
+
+/// Value of each character, 0xff for the ones that are not hex digits.
+struct DecodeTable
+{
+    uint8_t values[256];
+
+    constexpr DecodeTable()
+        : values()
+    {
+        for (int c = 0; c < 256; c++)
+        {
+            values[c] = 0xff;
+        }
+        for (int c = '0'; c <= '9'; c++)
+        {
+            values[c] = static_cast<uint8_t>(c - '0');
+        }
+        for (int c = 'a'; c <= 'f'; c++)
+        {
+            values[c] = static_cast<uint8_t>(c - 'a' + 10);
+            values[c - 'a' + 'A'] = static_cast<uint8_t>(c - 'a' + 10);
+        }
+    }
+};
+
+constexpr DecodeTable kDecodeTable;
+
+[[noreturn]] void ThrowInvalid(size_t position)
+{
+    throw std::invalid_argument("HexCodec: invalid hex digit at position " + std::to_string(position));
+}
+
+void EncodeScalar(const uint8_t* data, size_t size, char* out, HexCase hexCase)
+{
+    const char* digits = hexCase == HexCase::Lower ? kLowerDigits : kUpperDigits;
+    for (size_t i = 0; i < size; i++)
+    {
+        out[2 * i] = digits[data[i] >> 4];
+        out[2 * i + 1] = digits[data[i] & 0x0f];
+    }
+}
+
+/// Decodes pairs of digits starting at `offset`, `written` bytes are already
+/// in `out`. Used for the tail left by the vector kernels and for the
+/// lenient mode once a non digit character is found.
+size_t DecodeScalar(std::string_view hex, size_t offset, uint8_t* out, size_t written, HexMode mode)
+{
+    if (mode == HexMode::Strict)
+    {
+        for (size_t i = offset; i + 1 < hex.size(); i += 2)
+        {
+            uint8_t high = kDecodeTable.values[static_cast<uint8_t>(hex[i])];
+            uint8_t low = kDecodeTable.values[static_cast<uint8_t>(hex[i + 1])];
+            if ((high | low) == 0xff)
+            {
+                ThrowInvalid(high == 0xff ? i : i + 1);
+            }
+            out[written++] = static_cast<uint8_t>((high << 4) | low);
+        }
+        return written;
+    }
+
+    int pending = -1;
+    for (size_t i = offset; i < hex.size(); i++)
+    {
+        uint8_t value = kDecodeTable.values[static_cast<uint8_t>(hex[i])];
+        if (value == 0xff)
+        {
+            continue;
+        }
+        if (pending < 0)
+        {
+            pending = value;
+        }
+        else
+        {
+            out[written++] = static_cast<uint8_t>((pending << 4) | value);
+            pending = -1;
+        }
+    }
+    return written;
+}
+
+#ifdef CASPER_X86
+/// ASCII digits of the 16 nibbles in `nibbles`, all in 0..15.
+inline __m128i NibblesToAscii(__m128i nibbles, __m128i letter_offset)
+{
+    __m128i is_letter = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), _mm_and_si128(is_letter, letter_offset));
+}
+
+void EncodeSSE2(const uint8_t* data, size_t size, char* out, HexCase hexCase)
+{
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    const __m128i letter_offset = _mm_set1_epi8(hexCase == HexCase::Lower ? 'a' - '0' - 10 : 'A' - '0' - 10);
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i high = NibblesToAscii(_mm_and_si128(_mm_srli_epi16(bytes, 4), mask), letter_offset);
+        __m128i low = NibblesToAscii(_mm_and_si128(bytes, mask), letter_offset);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    EncodeScalar(data + i, size - i, out + 2 * i, hexCase);
+}
+
+/// Lanes where x <= limit, comparing as unsigned bytes.
+inline __m128i AtMost(__m128i x, char limit)
+{
+    __m128i l = _mm_set1_epi8(limit);
+    return _mm_cmpeq_epi8(_mm_max_epu8(x, l), l);
+}
+
+/// Turns 16 characters into their values and sets `valid` to false if one of
+/// them is not a hex digit.
+inline __m128i AsciiToNibbles(__m128i chars, bool& valid)
+{
+    __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_digit = AtMost(digit, 9);
+    __m128i is_letter = AtMost(letter, 5);
+
+    valid = _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) == 0xffff;
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                        _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+/// Packs the 16 nibbles of a register into 8 bytes held in 16-bit lanes.
+inline __m128i CombineNibbles(__m128i nibbles)
+{
+    __m128i high = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00ff)), 4);
+    return _mm_or_si128(high, _mm_srli_epi16(nibbles, 8));
+}
+
+/// Decodes from `offset` on like DecodeScalar(), so that errors name the
+/// position in the whole input.
+size_t DecodeSSE2(std::string_view hex, size_t offset, uint8_t* out, size_t written, HexMode mode)
+{
+    size_t i = offset;
+    for (; i + 32 <= hex.size(); i += 32)
+    {
+        bool valid_first;
+        bool valid_second;
+        __m128i first =
+            AsciiToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex.data() + i)), valid_first);
+        __m128i second =
+            AsciiToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex.data() + i + 16)), valid_second);
+        if (!valid_first || !valid_second)
+        {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written),
+                         _mm_packus_epi16(CombineNibbles(first), CombineNibbles(second)));
+        written += 16;
+    }
+    return DecodeScalar(hex, i, out, written, mode);
+}
+
+CASPER_TARGET_AVX2 inline __m256i NibblesToAscii(__m256i nibbles, __m256i letter_offset)
+{
+    __m256i is_letter = _mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9));
+    return _mm256_add_epi8(_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')),
+                           _mm256_and_si256(is_letter, letter_offset));
+}
+
+CASPER_TARGET_AVX2 void EncodeAVX2(const uint8_t* data, size_t size, char* out, HexCase hexCase)
+{
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    const __m256i letter_offset = _mm256_set1_epi8(hexCase == HexCase::Lower ? 'a' - '0' - 10 : 'A' - '0' - 10);
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        // unpack works within 128-bit lanes, so put the quadwords in the
+        // order 0, 2, 1, 3 first to get the output in order
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        bytes = _mm256_permute4x64_epi64(bytes, 0xd8);
+        __m256i high = NibblesToAscii(_mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask), letter_offset);
+        __m256i low = NibblesToAscii(_mm256_and_si256(bytes, mask), letter_offset);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_unpacklo_epi8(high, low));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_unpackhi_epi8(high, low));
+    }
+
+    // clear the upper halves before running legacy SSE code, which would
+    // otherwise pay for a state transition
+    _mm256_zeroupper();
+    EncodeSSE2(data + i, size - i, out + 2 * i, hexCase);
+}
+
+CASPER_TARGET_AVX2 inline __m256i AtMost(__m256i x, char limit)
+{
+    __m256i l = _mm256_set1_epi8(limit);
+    return _mm256_cmpeq_epi8(_mm256_max_epu8(x, l), l);
+}
+
+CASPER_TARGET_AVX2 inline __m256i AsciiToNibbles(__m256i chars, bool& valid)
+{
+    __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i is_digit = AtMost(digit, 9);
+    __m256i is_letter = AtMost(letter, 5);
+
+    valid = _mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) == -1;
+    return _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+                           _mm256_and_si256(is_letter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+}
+
+CASPER_TARGET_AVX2 inline __m256i CombineNibbles(__m256i nibbles)
+{
+    __m256i high = _mm256_slli_epi16(_mm256_and_si256(nibbles, _mm256_set1_epi16(0x00ff)), 4);
+    return _mm256_or_si256(high, _mm256_srli_epi16(nibbles, 8));
+}
+
+CASPER_TARGET_AVX2 size_t DecodeAVX2(std::string_view hex, uint8_t* out, HexMode mode)
+{
+    size_t i = 0;
+    size_t written = 0;
+    for (; i + 64 <= hex.size(); i += 64)
+    {
+        bool valid_first;
+        bool valid_second;
+        __m256i first =
+            AsciiToNibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex.data() + i)), valid_first);
+        __m256i second =
+            AsciiToNibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex.data() + i + 32)), valid_second);
+        if (!valid_first || !valid_second)
+        {
+            break;
+        }
+        // pack works within 128-bit lanes too, restore the quadword order
+        __m256i packed = _mm256_packus_epi16(CombineNibbles(first), CombineNibbles(second));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written), _mm256_permute4x64_epi64(packed, 0xd8));
+        written += 32;
+    }
+
+    // the SSE2 kernel takes the remaining 32 character block, if any
+    _mm256_zeroupper();
+    return DecodeSSE2(hex, i, out, written, mode);
+}
+#endif
+
+HexKernel SelectKernel()
+{
+#ifdef CASPER_X86
+    return CpuHasAVX2() ? HexKernel::AVX2 : HexKernel::SSE2;
+#else
+    return HexKernel::Scalar;
+#endif
+}
+
+} // namespace
+
+HexKernel HexCodec::ActiveKernel()
+{
+    static const HexKernel kernel = SelectKernel();
+    return kernel;
+}
+
+bool HexCodec::IsSupported(HexKernel kernel)
+{
+    switch (kernel)
+    {
+    case HexKernel::Scalar:
+        return true;
+#ifdef CASPER_X86
+    case HexKernel::SSE2:
+        return true;
+    case HexKernel::AVX2:
+        return ActiveKernel() == HexKernel::AVX2;
+#endif
+    default:
+        return false;
+    }
+}
+
+void HexCodec::Encode(const uint8_t* data, size_t size, char* out, HexCase hexCase)
+{
+    Encode(ActiveKernel(), data, size, out, hexCase);
+}
+
+size_t HexCodec::Decode(std::string_view hex, uint8_t* out, HexMode mode)
+{
+    return Decode(ActiveKernel(), hex, out, mode);
+}
+
+void HexCodec::Encode(HexKernel kernel, const uint8_t* data, size_t size, char* out, HexCase hexCase)
+{
+    switch (kernel)
+    {
+#ifdef CASPER_X86
+    case HexKernel::AVX2:
+        EncodeAVX2(data, size, out, hexCase);
+        return;
+    case HexKernel::SSE2:
+        EncodeSSE2(data, size, out, hexCase);
+        return;
+#endif
+    default:
+        EncodeScalar(data, size, out, hexCase);
+    }
+}
+
+size_t HexCodec::Decode(HexKernel kernel, std::string_view hex, uint8_t* out, HexMode mode)
+{
+    if (mode == HexMode::Strict && hex.size() % 2 != 0)
+    {
+        throw std::invalid_argument("HexCodec: odd number of hex digits");
+    }
+
+    switch (kernel)
+    {
+#ifdef CASPER_X86
+    case HexKernel::AVX2:
+        return DecodeAVX2(hex, out, mode);
+    case HexKernel::SSE2:
+        return DecodeSSE2(hex, 0, out, 0, mode);
+#endif
+    default:
+        return DecodeScalar(hex, 0, out, 0, mode);
+    }
+}
+
+} // namespace Casper
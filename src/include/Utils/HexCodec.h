@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Casper
+{
+/// <summary>
+/// How HexCodec::Decode treats malformed input.
+/// </summary>
+enum class HexMode
+{
+    /// <summary>
+    /// Even length and hex digits only, anything else throws
+    /// std::invalid_argument.
+    /// </summary>
+    Strict,
+    /// <summary>
+    /// Characters that are not hex digits are skipped and an unpaired last
+    /// digit is dropped, like CryptoPP::HexDecoder does.
+    /// </summary>
+    Lenient
+};
+
+enum class HexCase
+{
+    Lower,
+    Upper
+};
+
+/// <summary>
+/// Implementation used by HexCodec, the fastest one the CPU supports is
+/// picked at startup.
+/// </summary>
+enum class HexKernel
+{
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+/// <summary>
+/// Hex encoder and decoder working on caller provided buffers. Uses SSE2 or
+/// AVX2 on x86-64 when available and a table based scalar loop otherwise.
+/// </summary>
+struct HexCodec
+{
+    /// <summary>
+    /// Writes the 2 * `size` hex digits of `data` to `out`.
+    /// </summary>
+    static void Encode(const uint8_t* data, size_t size, char* out, HexCase hexCase = HexCase::Lower);
+
+    /// <summary>
+    /// Decodes `hex` into `out`, which must have room for hex.size() / 2
+    /// bytes. Returns the number of bytes written.
+    /// </summary>
+    static size_t Decode(std::string_view hex, uint8_t* out, HexMode mode = HexMode::Strict);
+
+    /// <summary>
+    /// Same as Encode() and Decode() but with the given kernel, for tests and
+    /// benchmarks. The kernel must be supported.
+    /// </summary>
+    static void Encode(HexKernel kernel, const uint8_t* data, size_t size, char* out,
+                       HexCase hexCase = HexCase::Lower);
+
+    static size_t Decode(HexKernel kernel, std::string_view hex, uint8_t* out, HexMode mode = HexMode::Strict);
+
+    /// <summary>
+    /// The kernel used by Encode() and Decode().
+    /// </summary>
+    static HexKernel ActiveKernel();
+
+    static bool IsSupported(HexKernel kernel);
+};
+
+} // namespace Casper
@@ -1,7 +1,10 @@
 #include "Utils/StringUtil.h"
+#include "ByteSerializers/ByteReader.h"
+#include "ByteSerializers/ByteWriter.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <codecvt>
 #include <iostream>
 #include <locale>
@@ -65,29 +68,78 @@ std::string StringUtil::hexToUTF8(const std::string& str)
 
 std::string StringUtil::hexToString(const std::string& bytes_str)
 {
-    // first 2 chars are the length of the string
-    uint32_t str_size = 2 * hexStrToUint32(bytes_str.substr(0, 2));
-
-    // get the meaningful string hex bytes
-    std::string str = bytes_str.substr(bytes_str.length() - str_size);
-
-    std::stringstream ss;
-    for (int i = 0; i < str_size / 2; i++)
-    {
-        ss << hexToUTF8(str.substr(i * 2, 2));
-    }
-
-    std::string str_utf8 = ss.str();
-    return str_utf8;
+    // u32 length followed by the UTF-8 bytes
+    CBytes bytes = hexDecode(bytes_str);
+    ByteReader reader(std::span<const uint8_t>(bytes.data(), bytes.size()));
+    return std::string(reader.ReadString());
 }
 
-void swapAndReverse(std::string& str)
+bool StringUtil::isValidUtf8(std::string_view str)
 {
-    std::reverse(str.begin(), str.end());
-    for (int32_t i = 0; i < str.length() / 2; i += 2)
+    const auto* data = reinterpret_cast<const unsigned char*>(str.data());
+    const size_t size = str.size();
+
+    size_t i = 0;
+    while (i < size)
     {
-        std::swap(str[i], str[i + 1]);
+        if (i + 8 <= size)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            if ((word & 0x8080808080808080ull) == 0)
+            {
+                i += 8;
+                continue;
+            }
+        }
+
+        const unsigned char lead = data[i];
+        if (lead < 0x80)
+        {
+            i++;
+            continue;
+        }
+
+        // number of continuation bytes and the allowed range of the first one,
+        // see table 3-7 of the Unicode standard
+        size_t continuation;
+        unsigned char low = 0x80;
+        unsigned char high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            continuation = 1;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            continuation = 2;
+            low = lead == 0xE0 ? 0xA0 : 0x80;
+            high = lead == 0xED ? 0x9F : 0xBF;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            continuation = 3;
+            low = lead == 0xF0 ? 0x90 : 0x80;
+            high = lead == 0xF4 ? 0x8F : 0xBF;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (size - i <= continuation || data[i + 1] < low || data[i + 1] > high)
+        {
+            return false;
+        }
+        for (size_t k = 2; k <= continuation; k++)
+        {
+            if ((data[i + k] & 0xC0) != 0x80)
+            {
+                return false;
+            }
+        }
+        i += continuation + 1;
     }
+    return true;
 }
 
 // using wstring_utf8_converter =
@@ -101,14 +153,6 @@ void swapAndReverse(std::string& str)
 
 // }
 
-std::wstring from_utf8(std::string_view s)
-{
-    std::wstring wstr;
-    utf8::unchecked::utf8to16(s.begin(), s.end(), back_inserter(wstr));
-
-    return wstr;
-}
-
 // std::string StringUtil::getStringBytesWithoutLength(const std::string& str) {
 //   std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
 //   std::wstring wstr = from_utf8(str);
@@ -126,18 +170,7 @@ std::wstring from_utf8(std::string_view s)
 
 std::string StringUtil::getStringBytesWithoutLength(const std::string& str)
 {
-    std::wstring wstr = from_utf8(str);
-
-    std::stringstream input_ss;
-    input_ss << std::hex << std::setfill('0');
-
-    for (auto c : wstr)
-    {
-        input_ss << std::setw(2) << static_cast<uint32_t>(c);
-    }
-    std::string output_str = input_ss.str();
-
-    return output_str;
+    return hexEncode(reinterpret_cast<const uint8_t*>(str.data()), str.size());
 }
 
 // std::string StringUtil::stringToHex(const std::string& str) {
@@ -167,28 +200,9 @@ std::string StringUtil::getStringBytesWithoutLength(const std::string& str)
 
 std::string StringUtil::stringToHex(const std::string& str)
 {
-    std::wstring wstr = from_utf8(str);
-
-    /// add length of string and extra 0s, total is 4 bytes
-    std::stringstream len_ss;
-    len_ss << std::hex << std::setfill('0');
-
-    int32_t str_length = wstr.length();
-    len_ss << std::setw(8) << str_length;
-
-    std::string len_str = len_ss.str();
-    swapAndReverse(len_str);
-
-    std::stringstream input_ss;
-    input_ss << std::hex << std::setfill('0');
-
-    for (auto c : wstr)
-    {
-        input_ss << std::setw(2) << static_cast<uint32_t>(c);
-    }
-    std::string output_str = len_str + input_ss.str();
-
-    return output_str;
+    ByteWriter bytes(sizeof(uint32_t) + str.size());
+    bytes.WriteString(str);
+    return hexEncode(bytes.ToBytes());
 }
 
 } // namespace Casper
@@ -21,6 +21,12 @@ struct StringUtil
     static std::string hexToString(const std::string& bytes_str);
 
     static std::string stringToHex(const std::string& str);
+
+    /// <summary>
+    /// Checks that `str` is well formed UTF-8: no overlong forms, surrogates
+    /// or code points above U+10FFFF. ASCII runs are checked 8 bytes at a time.
+    /// </summary>
+    static bool isValidUtf8(std::string_view str);
 };
 
 } // namespace Casper
\ No newline at end of file
@@ -264,6 +264,13 @@ void CLValue_ByteSer_U512_Test(void)
     std::string expected_opt_u512_none = "01000000000d08";
     std::string actual_opt_u512_none = hexEncode(ser.ToBytes(clv_opt_u512_none));
     TEST_ASSERT(expected_opt_u512_none == actual_opt_u512_none);
+
+    // limb codec: zero has no value bytes, leading zero bytes are dropped
+    TEST_ASSERT(u512ToHex(uint512_t(0)) == "00");
+    TEST_ASSERT(u512ToHex(uint512_t(0x0100)) == "020001");
+    TEST_ASSERT(u512FromHex("020001") == uint512_t(0x0100));
+    TEST_ASSERT(u512FromHex(u512ToHex(u512_val_2)) == u512_val_2);
+    TEST_ASSERT(u128FromHex(u128ToHex(uint128_t(UINT64_MAX) << 40)) == (uint128_t(UINT64_MAX) << 40));
 }
 
 /// Unit Byte Serialization
@@ -318,6 +325,23 @@ void CLValue_ByteSer_String_Test(void)
     std::string expected_opt_none_str = "01000000000d0a";
     std::string actual_opt_none_str = hexEncode(ser.ToBytes(clv_opt_none_str));
     TEST_ASSERT(expected_opt_none_str == actual_opt_none_str);
+
+    // Non-ASCII String, the length counts UTF-8 bytes
+    CLValue clv_utf8_str = CLValue::String("Gr\u00fc\u00dfe \u2713");
+    std::string expected_utf8_str = "0f0000000b0000004772c3bcc39f6520e29c930a";
+    TEST_ASSERT(expected_utf8_str == hexEncode(ser.ToBytes(clv_utf8_str)));
+    TEST_ASSERT(stringDecode(stringEncode("Gr\u00fc\u00dfe \u2713")) == "Gr\u00fc\u00dfe \u2713");
+
+    // UTF-8 validation on decode
+    TEST_ASSERT(StringUtil::isValidUtf8("plain ascii text, longer than one word"));
+    TEST_ASSERT(StringUtil::isValidUtf8("\xf0\x9f\x98\x80"));
+    TEST_ASSERT(!StringUtil::isValidUtf8("\xc0\xaf"));         // overlong '/'
+    TEST_ASSERT(!StringUtil::isValidUtf8("\xed\xa0\x80"));     // surrogate
+    TEST_ASSERT(!StringUtil::isValidUtf8("\xf4\x90\x80\x80")); // above U+10FFFF
+    TEST_ASSERT(!StringUtil::isValidUtf8("abcdefgh\xe2\x9c"));  // truncated
+    CBytes invalid = hexDecode("02000000c328");
+    ByteReader reader(std::span<const uint8_t>(invalid.data(), invalid.size()));
+    TEST_EXCEPTION(reader.ReadString(), std::runtime_error);
 }
 
 /// URef Byte Serialization
@@ -3,9 +3,14 @@
 #include "ServerEventsClient.h"
 #include "Types/GlobalStateKey.cpp"
 #include "Types/PublicKey.h"
+#include "Types/PublicKeyTable.h"
+#include "Utils/Blake2bBatch.h"
 #include "Utils/CryptoUtil.h"
+#include <set>
 #include <sstream>
+#include <unordered_set>
 #include "Types/CLType.h"
+#include "Types/CLTypeTable.h"
 #include "Types/CLConverter.h"
 
 #include "ByteSerializers/GlobalStateKeyByteSerializer.h"
@@ -15,7 +20,11 @@
 #include "Types/ED25519Key.h"
 #include "Types/Secp256k1Key.h"
 #include <cryptopp/osrng.h>
+#include <atomic>
 #include <chrono>
+#include <coroutine>
+#include <future>
+#include <thread>
 #include "data/TestSourceSecretKey.hpp"
 
 // Tests
@@ -69,6 +78,87 @@ void publicKey_getAccountHashTest()
     TEST_ASSERT(iequals(lower_case_account_hash, expected_account_hash));
 }
 
+/// <summary>
+/// Validator keys are decoded once and shared through the PublicKeyTable
+/// </summary>
+void publicKeyTable_test()
+{
+    const std::string hex = "0203297ebdcc8cb840e6e5ffb427420ec754ac35364c502f4ac58b0ffea799e57f11";
+    auto& table = PublicKeyTable::Instance();
+
+    PublicKeyHandle handle = table.Intern(hex);
+    size_t size = table.Size();
+    TEST_ASSERT(table.Intern(hex) == handle);
+    PublicKey key = PublicKey::FromHexString(hex);
+    TEST_ASSERT(table.Intern(key.ToAccountHex()) == handle);
+    TEST_ASSERT(table.Size() == size);
+
+    const PublicKeyDescriptor& descriptor = table.Get(handle);
+    TEST_ASSERT(descriptor.key == key);
+    TEST_ASSERT(descriptor.hex == key.ToAccountHex());
+    TEST_ASSERT(descriptor.account_hash == key.GetAccountHash());
+    TEST_ASSERT(table.Intern(key) == handle);
+
+    nlohmann::json j = {{"public_key", hex}, {"weight", "100"}};
+    TEST_ASSERT(j.get<ValidatorWeight>().public_key == key);
+    TEST_ASSERT(table.Size() == size);
+
+    PublicKey ed25519 =
+        PublicKey::FromHexString("01cd807fb41345d8dd5a61da7991e1468173acbee53920e4dfe0d28cb8825ac664");
+    TEST_ASSERT(ed25519 < key && !(key < ed25519) && ed25519 != key);
+
+    std::vector<PublicKey> keys;
+    for (uint8_t i = 0; i < 50; i++)
+    {
+        PublicKey delegator = ed25519;
+        delegator.raw_bytes[31] = i;
+        keys.push_back(delegator);
+    }
+    // an interned key and repeated keys mixed with the others
+    keys.push_back(key);
+    keys.push_back(keys[3]);
+    std::vector<std::string> account_hashes = table.AccountHashes(keys, 4);
+    TEST_ASSERT(account_hashes.size() == keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        TEST_CHECK(account_hashes[i] == keys[i].GetAccountHash());
+    }
+    TEST_ASSERT(table.AccountHashes(keys, 1) == account_hashes);
+    TEST_ASSERT(table.AccountHash(ed25519) == "account-hash-" + ed25519.GetAccountHashBytes().ToChecksumString());
+
+    // hashing keys does not intern them
+    TEST_ASSERT(table.Size() == size);
+    TEST_ASSERT(AccountHashKey(ed25519).ToString() == ed25519.GetAccountHash());
+
+    // delegator keys are read without interning them
+    PublicKey delegator = ed25519;
+    delegator.raw_bytes[31] = 200;
+    nlohmann::json delegator_json = {{"delegator_public_key", delegator.ToAccountHex()}};
+    TEST_ASSERT(delegator_json.get<Delegator>().delegator_public_key == delegator);
+    TEST_ASSERT(table.Size() == size);
+
+    // a full table leaves new keys out, they still parse
+    PublicKeyTable small(1);
+    PublicKeyHandle first = small.Intern(hex);
+    TEST_ASSERT(first != PUBLIC_KEY_NOT_INTERNED);
+    TEST_ASSERT(small.Intern(ed25519) == PUBLIC_KEY_NOT_INTERNED);
+    TEST_ASSERT(small.Intern(ed25519.ToAccountHex()) == PUBLIC_KEY_NOT_INTERNED);
+    TEST_ASSERT(small.Key(ed25519.ToAccountHex()) == ed25519);
+    TEST_ASSERT(small.Intern(hex) == first && small.Size() == 1);
+
+    TEST_EXCEPTION(table.Intern("03" + hex.substr(2)), std::invalid_argument);
+    TEST_EXCEPTION(table.Intern(hex.substr(0, 20)), std::invalid_argument);
+
+    // a key one byte short must not alias the key padded with a zero byte
+    PublicKey padded = ed25519;
+    padded.raw_bytes[31] = 0;
+    PublicKey truncated = padded;
+    truncated.raw_bytes = CBytes(padded.raw_bytes.data(), 31);
+    table.Intern(padded);
+    TEST_EXCEPTION(table.Intern(truncated), std::invalid_argument);
+    TEST_EXCEPTION(table.AccountHash(truncated), std::invalid_argument);
+}
+
 // to store list inside map map["List"]: list_inner_type
 CLTypeRVA createContainerMap(std::string key, CLTypeRVA value)
 {
@@ -266,6 +356,81 @@ void clType_tuple3_test()
     TEST_ASSERT(threeWayCompare(tuple3_type));
 }
 
+/// Map<String, List<Tuple2<ByteArray(32), Option<U512>>>> interned in the type table
+void clType_table_test()
+{
+    auto make_type = []()
+    {
+        std::map<std::string, int32_t> byte_array;
+        byte_array["ByteArray"] = 32;
+        return createMap(CLTypeEnum::String,
+                         createList(createTuple2(byte_array, createOption(CLTypeEnum::U512))));
+    };
+
+    auto& table = CLTypeTable::Instance();
+
+    // primitives are preregistered with their tag as handle
+    TEST_ASSERT(CLType(CLTypeEnum::U512).Handle() == static_cast<CLTypeHandle>(CLTypeEnum::U512));
+
+    // equal types built separately share one handle and one descriptor
+    CLType type(make_type());
+    CLTypeHandle handle = type.Handle();
+    size_t size = table.Size();
+    TEST_ASSERT(CLType(make_type()).Handle() == handle);
+    TEST_ASSERT(table.Size() == size);
+    TEST_ASSERT(CLType(createList(CLTypeEnum::U512)).Handle() != handle);
+
+    // types read from json are interned when they are built
+    nlohmann::json type_json;
+    to_json(type_json, type);
+    CLType from_json_type;
+    from_json(type_json, from_json_type);
+    TEST_ASSERT(from_json_type.Handle() == handle);
+
+    // equality, ordering and hashing go through the handle
+    TEST_ASSERT(from_json_type == type && !(type == CLType(createList(CLTypeEnum::U512))));
+    TEST_ASSERT(!(type < type) && !(type < from_json_type));
+    TEST_ASSERT(CLType(CLTypeEnum::U8) < type || type < CLType(CLTypeEnum::U8));
+    std::set<CLType> ordered{type, from_json_type, CLType(CLTypeEnum::U8), CLType(createList(CLTypeEnum::U8))};
+    std::unordered_set<CLType> hashed(ordered.begin(), ordered.end());
+    hashed.insert(CLType(make_type()));
+    TEST_ASSERT(ordered.size() == 3 && hashed.size() == 3);
+    TEST_ASSERT(std::hash<CLType>{}(type) == std::hash<CLType>{}(from_json_type));
+
+    // the precomputed encoding matches the serializer
+    const CLTypeDescriptor& descriptor = table.Get(handle);
+    TEST_ASSERT(descriptor.tag == CLTypeEnum::Map);
+    TEST_ASSERT(descriptor.inner.size() == 2);
+    TEST_ASSERT(table.Get(descriptor.inner[0]).tag == CLTypeEnum::String);
+
+    CLValue value(CBytes(), type);
+    CLValueByteSerializer ser;
+    CBytes bytes = ser.ToBytes(value);
+    TEST_ASSERT(std::equal(descriptor.bytes.begin(), descriptor.bytes.end(), bytes.begin() + sizeof(uint32_t)));
+    TEST_ASSERT(descriptor.bytes.size() == bytes.size() - sizeof(uint32_t));
+
+    // the precomputed JSON matches the one built from the tree
+    nlohmann::json tree_json;
+    to_json(tree_json, type.Type());
+    TEST_ASSERT(type.Json() == &descriptor.json && descriptor.json == tree_json && type_json == tree_json);
+    nlohmann::json u512_json;
+    to_json(u512_json, CLType(CLTypeEnum::U512));
+    TEST_ASSERT(u512_json == "U512");
+
+    // a full table leaves new types out, they are still encoded the same
+    TEST_ASSERT(CLTypeTable::Encode(type.Type()) == descriptor.bytes);
+
+    size_t primitives = CLTypeTable(0).Size();
+    CLTypeTable small(primitives + 1);
+    CLTypeHandle list = small.Intern(createList(CLTypeEnum::U8));
+    TEST_ASSERT(list != CL_TYPE_NOT_INTERNED);
+    TEST_ASSERT(small.Intern(CLType(32).Type()) == CL_TYPE_NOT_INTERNED);
+    TEST_ASSERT(small.Intern(make_type()) == CL_TYPE_NOT_INTERNED);
+    TEST_ASSERT(small.Intern(createList(CLTypeEnum::U8)) == list);
+    TEST_ASSERT(small.Intern(CLTypeEnum::U512) == static_cast<CLTypeHandle>(CLTypeEnum::U512));
+    TEST_ASSERT(small.Size() == primitives + 1);
+}
+
 void clTypeParsed_test()
 {
     std::string json_str = R"(
@@ -280,7 +445,7 @@ void clTypeParsed_test()
     CLValue cl;
     from_json(j, cl);
 
-    TEST_ASSERT(boost::get<CLTypeEnum>(cl.cl_type.type) == CLTypeEnum::U512);
+    TEST_ASSERT(boost::get<CLTypeEnum>(cl.GetType().Type()) == CLTypeEnum::U512);
 
     nlohmann::json j2;
     to_json(j2, cl);
@@ -288,6 +453,157 @@ void clTypeParsed_test()
     TEST_ASSERT(j2.dump() == j.dump());
 }
 
+/// test that the parsed value of a CLValue is built on demand
+void clValue_lazyParsed_test()
+{
+    nlohmann::json j = nlohmann::json::parse(R"({"bytes": "06da6662305f01", "parsed": "1508345276122", "cl_type": "U512"})");
+
+    // from json, the parsed node is converted on first access
+    CLValue from_json_value;
+    from_json(j, from_json_value);
+    TEST_ASSERT(boost::get<CLTypeParsedU512>(from_json_value.GetParsed()).Value() == u512FromDec("1508345276122"));
+
+    // from bytes only, the parsed value is decoded from the bytes
+    CLValue from_bytes_value(hexDecode("06da6662305f01"), CLTypeRVA(CLTypeEnum::U512));
+    TEST_ASSERT(boost::get<CLTypeParsedU512>(from_bytes_value.GetParsed()).Value() == u512FromDec("1508345276122"));
+
+    nlohmann::json j2;
+    to_json(j2, from_bytes_value);
+    TEST_ASSERT(j2.dump() == j.dump());
+
+    // from json, only the text of the parsed node is kept, not a copy of its tree
+    nlohmann::json list_json = nlohmann::json::parse(
+        R"({"bytes": "0200000006da6662305f010107", "parsed": ["1508345276122", "7"], "cl_type": {"List": "U512"}})");
+    CLValue list_value;
+    from_json(list_json, list_value);
+    TEST_ASSERT(list_value.ParsedJsonText() && *list_value.ParsedJsonText() == R"(["1508345276122","7"])");
+    list_json.at("parsed").clear();
+    nlohmann::json j3;
+    to_json(j3, list_value);
+    TEST_ASSERT(j3.at("parsed").dump() == R"(["1508345276122","7"])");
+    TEST_ASSERT(parsedList(list_value.GetParsed()).size() == 2);
+    TEST_ASSERT(from_bytes_value.ParsedJsonText() == nullptr);
+
+    // a copy made before the first access builds the same parsed value
+    CLValue original(hexDecode("06da6662305f01"), CLTypeRVA(CLTypeEnum::U512));
+    CLValue copy = original;
+    TEST_ASSERT(copy.GetParsed() == original.GetParsed());
+
+    // new bytes or a new type drop the cache the copies shared
+    copy.SetBytes(hexDecode("0107"));
+    TEST_ASSERT(boost::get<CLTypeParsedU512>(copy.GetParsed()).Value() == 7);
+    TEST_ASSERT(boost::get<CLTypeParsedU512>(original.GetParsed()).Value() == u512FromDec("1508345276122"));
+    copy.SetType(CLType(CLTypeEnum::U8));
+    copy.SetBytes(hexDecode("07"));
+    TEST_ASSERT(boost::get<uint8_t>(copy.GetParsed()) == 7);
+
+    // threads sharing a value all see the same parsed value, built once
+    CLValue shared(hexDecode("06da6662305f01"), CLTypeRVA(CLTypeEnum::U512));
+    std::vector<const CLTypeParsedRVA*> seen(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < seen.size(); i++)
+    {
+        threads.emplace_back([&, i] { seen[i] = &shared.GetParsed(); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (const auto* parsed : seen)
+    {
+        TEST_CHECK(parsed == seen[0]);
+    }
+    TEST_CHECK(boost::get<CLTypeParsedU512>(*seen[0]).Value() == u512FromDec("1508345276122"));
+
+    // bytes left over after the value are rejected, from bytes and on first access
+    CLValue trailing(hexDecode("06da6662305f0100"), CLTypeRVA(CLTypeEnum::U512));
+    TEST_EXCEPTION(trailing.GetParsed(), std::runtime_error);
+
+    CLValueByteSerializer serializer;
+    CBytes serialized = hexDecode("0800000006da6662305f010008");
+    TEST_EXCEPTION(serializer.FromBytes(std::span<const uint8_t>(serialized.data(), serialized.size())),
+                   std::runtime_error);
+}
+
+/// test that lists of fixed width primitives are parsed into contiguous arrays
+void clTypeParsedArray_test()
+{
+    TEST_ASSERT(sizeof(CLTypeParsedRVA) <= 40);
+
+    auto parse = [](std::string json_text, bool from_bytes)
+    {
+        nlohmann::json j = nlohmann::json::parse(json_text);
+        CLType type;
+        from_json(j.at("cl_type"), type);
+        if (from_bytes)
+        {
+            return CLValue(hexDecode(j.at("bytes").get<std::string>()), type.Type()).GetParsed();
+        }
+        CLTypeParsedRVA parsed;
+        from_json(j.at("parsed"), parsed, type);
+        return parsed;
+    };
+
+    std::vector<std::pair<std::string, std::string>> lists = {
+        {R"({"bytes": "0400000001010100", "parsed": [1, 1, 1, 0], "cl_type": {"List": "U8"}})", "[1,1,1,0]"},
+        {R"({"bytes": "02000000ffffffff07000000", "parsed": [-1, 7], "cl_type": {"List": "I32"}})", "[-1,7]"},
+        {R"({"bytes": "020000000100", "parsed": [true, false], "cl_type": {"List": "Bool"}})", "[true,false]"},
+        {R"({"bytes": "02000000010800", "parsed": ["8", "0"], "cl_type": {"List": "U256"}})", R"(["8","0"])"},
+    };
+    for (const auto& [json_text, expected] : lists)
+    {
+        for (bool from_bytes : {false, true})
+        {
+            CLTypeParsedRVA parsed = parse(json_text, from_bytes);
+            TEST_ASSERT(parsed.which() == 17);
+            TEST_ASSERT(nlohmann::json(parsed).dump() == expected);
+            TEST_ASSERT(nlohmann::json(parsedList(parsed)).dump() == expected);
+        }
+    }
+
+    CLTypeParsedRVA small = parse(R"({"bytes": "020000000108010a", "parsed": ["8", "10"], "cl_type": {"List": "U512"}})",
+                                  true);
+    TEST_ASSERT(boost::get<CLTypeParsedArray>(small).Get<uint64_t>(1) == 10);
+    TEST_ASSERT(boost::get<CLTypeParsedU512>(parsedList(small)[0]).Value() == 8);
+
+    // a value above 64 bits keeps the list in the generic form
+    std::string big = R"({"bytes": "02000000010809010000000000000001", "parsed": ["8", "18446744073709551617"],
+                          "cl_type": {"List": "U512"}})";
+    for (bool from_bytes : {false, true})
+    {
+        CLTypeParsedRVA parsed = parse(big, from_bytes);
+        TEST_ASSERT(parsed.which() == 13);
+        TEST_ASSERT(nlohmann::json(parsed).dump() == R"(["8","18446744073709551617"])");
+    }
+
+    // a U512 that fits in 64 bits is stored inline, a larger one is boxed
+    CLTypeParsedU512 small_u512(uint512_t(10));
+    CLTypeParsedU512 big_u512(u512FromDec("18446744073709551617"));
+    TEST_ASSERT(small_u512.IsSmall() && !big_u512.IsSmall());
+    CLTypeParsedU512 big_copy = big_u512;
+    TEST_ASSERT(big_copy == big_u512 && small_u512 < big_copy);
+    TEST_ASSERT(big_copy.Value() == u512FromDec("18446744073709551617"));
+    CLTypeParsedRVA balances =
+        parse(R"({"bytes": "0100000001000000610109", "cl_type": {"Map": {"key": "String", "value": "U512"}}})", true);
+    const auto& balance = boost::get<CLTypeParsedU512>(
+        boost::get<std::map<CLTypeParsedRVA, CLTypeParsedRVA>>(balances).at(std::string("a")));
+    TEST_ASSERT(balance.IsSmall() && balance.Value() == 9);
+
+    // lists built in code take the same form as the parsed ones
+    CLValue built = CLValue::List({CLValue::U8(1), CLValue::U8(1), CLValue::U8(1), CLValue::U8(0)});
+    TEST_ASSERT(built.GetParsed().which() == 17);
+    TEST_ASSERT(built.GetParsed() == parse(lists[0].first, true));
+    CLValue built_big = CLValue::List({CLValue::U512(8), CLValue::U512(u512FromDec("18446744073709551617"))});
+    TEST_ASSERT(built_big.GetParsed().which() == 13);
+    CLValue built_small = CLValue::List({CLValue::U512(8), CLValue::U512(10)});
+    TEST_ASSERT(built_small.GetParsed() == small);
+
+    // a Bool is 0 or 1, in a list or on its own
+    TEST_EXCEPTION(CLValue(hexDecode("020000000102"), CLType(CLTypeEnum::Bool, CLTypeEnum::List)).GetParsed(),
+                   std::runtime_error);
+    TEST_EXCEPTION(CLValue(hexDecode("02"), CLTypeRVA(CLTypeEnum::Bool)).GetParsed(), std::runtime_error);
+}
+
 /// test the serialization of a CLValue using a json file as input
 void clValue_with_jsonFile(std::string file_name)
 {
@@ -379,6 +695,897 @@ void clValue_with_U512_0Test()
     clValue_with_jsonFile("U512-0.json");
 }
 
+/// every hex kernel gives the same result as the scalar one
+void hexCodec_test()
+{
+    std::vector<uint8_t> data(300);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    const HexKernel kernels[] = {HexKernel::Scalar, HexKernel::SSE2, HexKernel::AVX2};
+    for (size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 64, 100, 300})
+    {
+        std::string expected(2 * size, '\0');
+        HexCodec::Encode(HexKernel::Scalar, data.data(), size, expected.data());
+        std::string expected_upper(2 * size, '\0');
+        HexCodec::Encode(HexKernel::Scalar, data.data(), size, expected_upper.data(), HexCase::Upper);
+        TEST_ASSERT(iequals(expected, expected_upper));
+
+        for (auto kernel : kernels)
+        {
+            if (!HexCodec::IsSupported(kernel))
+            {
+                continue;
+            }
+            std::string encoded(2 * size, '\0');
+            HexCodec::Encode(kernel, data.data(), size, encoded.data());
+            TEST_ASSERT(encoded == expected);
+
+            std::vector<uint8_t> decoded(size);
+            TEST_ASSERT(HexCodec::Decode(kernel, expected_upper, decoded.data()) == size);
+            TEST_ASSERT(std::equal(decoded.begin(), decoded.end(), data.begin()));
+            TEST_MSG("kernel %d, size %zu", static_cast<int>(kernel), size);
+        }
+    }
+
+    // strict mode rejects anything but an even number of hex digits, also
+    // when the bad character sits inside a vector block
+    std::string bad(96, 'a');
+    bad[70] = 'g';
+    std::vector<uint8_t> out(48);
+    for (auto kernel : kernels)
+    {
+        if (HexCodec::IsSupported(kernel))
+        {
+            try
+            {
+                HexCodec::Decode(kernel, bad, out.data());
+                TEST_CHECK(false);
+            }
+            catch (const std::invalid_argument& e)
+            {
+                // the position is the one in the whole input, whichever kernel finds it
+                TEST_CHECK(std::string_view(e.what()).ends_with("position 70"));
+            }
+            TEST_EXCEPTION(HexCodec::Decode(kernel, "abc", out.data()), std::invalid_argument);
+
+            // lenient mode skips what is not a digit, like CryptoPP::HexDecoder
+            TEST_ASSERT(HexCodec::Decode(kernel, bad, out.data(), HexMode::Lenient) == 47);
+            TEST_ASSERT(HexCodec::Decode(kernel, "0a:0B 1", out.data(), HexMode::Lenient) == 2);
+            TEST_ASSERT(out[0] == 0x0a && out[1] == 0x0b);
+        }
+    }
+
+    TEST_ASSERT(hexEncode(hexDecode("00ff10Ab")) == "00ff10ab");
+    TEST_ASSERT(CryptoUtil::hexEncode(hexDecode("00ff10ab")) == "00FF10AB");
+}
+
+/// CEP-57 checksummed hex
+void cep57Checksum_test()
+{
+    const std::string checksummed = "308d2a0eCF66bDAcAC5Cf6184C732D83DCeB48A859169e5680FE17cF32Bb974F";
+    CBytes bytes = hexDecode(checksummed);
+
+    char out[64];
+    CEP57Checksum::Encode(bytes.data(), bytes.size(), out);
+    TEST_ASSERT(std::string(out, sizeof(out)) == checksummed);
+    TEST_ASSERT(CEP57Checksum::Encode(bytes) == checksummed);
+
+    // single case strings carry no checksum
+    std::string lower = checksummed;
+    StringUtil::toLower(lower);
+    TEST_ASSERT(CEP57Checksum::Verify(checksummed));
+    TEST_ASSERT(CEP57Checksum::Verify(lower));
+
+    std::string wrong_case = checksummed;
+    wrong_case[8] = 'c';
+    TEST_ASSERT(!CEP57Checksum::Verify(wrong_case));
+    TEST_ASSERT(!CEP57Checksum::Verify(checksummed.substr(1)));
+    TEST_ASSERT(!CEP57Checksum::Verify("zz"));
+    TEST_EXCEPTION(CEP57Checksum::Decode(wrong_case), std::runtime_error);
+    TEST_ASSERT(CEP57Checksum::Decode(checksummed) == bytes);
+
+    std::vector<std::string> hashes{checksummed, lower, wrong_case, checksummed};
+    TEST_ASSERT(CEP57Checksum::VerifyBatch(hashes) == 2);
+    hashes.resize(2);
+    TEST_ASSERT(CEP57Checksum::VerifyBatch(hashes) == hashes.size());
+
+    // longer inputs are plain lowercase hex
+    CBytes long_bytes(CEP57Checksum::SMALL_BYTES_COUNT + 1);
+    std::fill(long_bytes.begin(), long_bytes.end(), 0xab);
+    TEST_ASSERT(CEP57Checksum::Encode(long_bytes) == hexEncode(long_bytes));
+}
+
+/// BLAKE2b-256 of many inputs at once, same digests with every kernel
+void blake2bBatch_test()
+{
+    std::vector<std::vector<uint8_t>> messages;
+    for (size_t size : {0, 1, 3, 31, 32, 43, 127, 128, 129, 256, 257, 1000, 4096})
+    {
+        std::vector<uint8_t> message(size);
+        for (size_t i = 0; i < size; i++)
+        {
+            message[i] = static_cast<uint8_t>(i * 7 + size);
+        }
+        messages.push_back(std::move(message));
+    }
+    std::vector<std::span<const uint8_t>> inputs(messages.begin(), messages.end());
+
+    std::vector<uint8_t> expected(Blake2bBatch::DIGEST_SIZE * inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        CryptoPP::BLAKE2b hash(32u);
+        hash.Update(inputs[i].data(), inputs[i].size());
+        hash.Final(&expected[Blake2bBatch::DIGEST_SIZE * i]);
+    }
+
+    for (auto kernel : {Blake2bKernel::Scalar, Blake2bKernel::AVX2})
+    {
+        if (!Blake2bBatch::IsSupported(kernel))
+        {
+            continue;
+        }
+        std::vector<uint8_t> digests(expected.size());
+        Blake2bBatch::Hash(kernel, inputs, digests.data());
+        TEST_CHECK(digests == expected);
+        TEST_MSG("kernel %d", static_cast<int>(kernel));
+    }
+
+    const std::string abc = "abc";
+    std::span<const uint8_t> abc_input(reinterpret_cast<const uint8_t*>(abc.data()), abc.size());
+    Hash32 abc_hash;
+    Blake2bBatch::Hash(std::span(&abc_input, 1), abc_hash.bytes.data());
+    TEST_ASSERT(abc_hash.ToString() == "bddd813c634239723171ef3fee98579b94964e3bb1cb3e427262c8c068d52319");
+
+    std::vector<PublicKey> keys = {
+        PublicKey::FromHexString("01cd807fb41345d8dd5a61da7991e1468173acbee53920e4dfe0d28cb8825ac664"),
+        PublicKey::FromHexString("0203297ebdcc8cb840e6e5ffb427420ec754ac35364c502f4ac58b0ffea799e57f11")};
+    std::vector<Hash32> account_hashes = PublicKey::GetAccountHashBytes(keys);
+    TEST_ASSERT(account_hashes.size() == 2);
+    TEST_ASSERT(account_hashes[0] == keys[0].GetAccountHashBytes());
+    TEST_ASSERT(account_hashes[1] == keys[1].GetAccountHashBytes());
+
+    std::vector<Deploy> deploys;
+    for (uint64_t id = 1; id <= 5; id++)
+    {
+        DeployHeader header(keys[0], "2022-01-01T00:00:00.000Z", "30m", 1, Hash32(), {}, "casper-test");
+        TransferDeployItem session(u512FromDec("2500000000"), AccountHashKey(keys[1]), id, true);
+        deploys.emplace_back(header, ModuleBytes(u512FromDec("100000000")), session);
+    }
+    TEST_ASSERT(Deploy::ValidateHashesBatch(deploys) == deploys.size());
+    deploys[3].header.gas_price = 2;
+    TEST_ASSERT(Deploy::ValidateHashesBatch(deploys) == 3);
+
+    // more deploys than one window, the bad one in a later window
+    deploys.clear();
+    for (uint64_t id = 1; id <= 2 * Deploy::VALIDATE_HASHES_WINDOW + 5; id++)
+    {
+        DeployHeader header(keys[0], "2022-01-01T00:00:00.000Z", "30m", 1, Hash32(), {}, "casper-test");
+        TransferDeployItem session(u512FromDec("2500000000"), AccountHashKey(keys[1]), id, true);
+        deploys.emplace_back(header, ModuleBytes(u512FromDec("100000000")), session);
+    }
+    TEST_ASSERT(Deploy::ValidateHashesBatch(deploys) == deploys.size());
+    const size_t bad = Deploy::VALIDATE_HASHES_WINDOW + 3;
+    deploys[bad].session = TransferDeployItem(u512FromDec("1"), AccountHashKey(keys[1]), 1, true);
+    TEST_ASSERT(Deploy::ValidateHashesBatch(deploys) == bad);
+    deploys[bad + Deploy::VALIDATE_HASHES_WINDOW].header.gas_price = 2;
+    TEST_ASSERT(Deploy::ValidateHashesBatch(deploys) == bad);
+}
+
+/// httplib::Server on a free local port answering POST /rpc with `handler`
+struct LocalRpcServer
+{
+    explicit LocalRpcServer(httplib::Server::Handler handler)
+    {
+        server.Post("/rpc", std::move(handler));
+        server.set_tcp_nodelay(true);
+        port = server.bind_to_any_port("127.0.0.1");
+        listener = std::thread([this] { server.listen_after_bind(); });
+        while (!server.is_running())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    ~LocalRpcServer() { Stop(); }
+
+    std::string Host() const { return "http://127.0.0.1:" + std::to_string(port); }
+
+    void Stop()
+    {
+        if (listener.joinable())
+        {
+            server.stop();
+            listener.join();
+        }
+    }
+
+    httplib::Server server;
+    int port = 0;
+    std::thread listener;
+};
+
+/// concurrent requests through the connection pool against a local server
+void httpConnectionPool_test()
+{
+    LocalRpcServer server(
+        [](const httplib::Request& req, httplib::Response& res)
+        { res.set_content(R"({"jsonrpc":"2.0","id":1,"result":)" + req.body + "}", "application/json"); });
+    std::string host = server.Host();
+
+    ConnectionPoolConfig config;
+    config.max_connections = 3;
+    HttpLibConnector connector(host, config);
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 6; t++)
+    {
+        callers.emplace_back(
+            [&, t]
+            {
+                for (int i = 0; i < 20; i++)
+                {
+                    std::string request = std::to_string(t * 100 + i);
+                    auto response = nlohmann::json::parse(connector.Send(request));
+                    if (response.at("result").get<int>() != t * 100 + i)
+                    {
+                        mismatches++;
+                    }
+                }
+            });
+    }
+    for (auto& caller : callers)
+    {
+        caller.join();
+    }
+
+    ConnectionPoolStats stats = connector.Stats();
+    TEST_ASSERT(mismatches == 0);
+    TEST_ASSERT(stats.requests == 120);
+    TEST_ASSERT(stats.created >= 1 && stats.created <= 3);
+    TEST_ASSERT(stats.reused == stats.requests - stats.created);
+    TEST_ASSERT(stats.open == stats.created && stats.in_use == 0 && stats.failed == 0);
+
+    // without an idle timeout every request finds the previous connection expired
+    config.idle_timeout = std::chrono::milliseconds(0);
+    HttpLibConnector expiring(host, config);
+    for (int i = 0; i < 3; i++)
+    {
+        expiring.Send("1");
+    }
+    TEST_ASSERT(expiring.Stats().created == 3 && expiring.Stats().evicted == 2);
+
+    server.Stop();
+
+    // the server is gone, the failed connection is dropped
+    TEST_EXCEPTION(connector.Send("1"), jsonrpccxx::JsonRpcException);
+    TEST_ASSERT(connector.Stats().failed == 1 && connector.Stats().open == connector.Stats().created - 1);
+
+    // hosts that can not be reached or not even be used give their slot back
+    config.max_connections = 1;
+    HttpLibConnector unreachable(host, config);
+    HttpLibConnector unsupported("ftp://127.0.0.1:1", config);
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_EXCEPTION(unreachable.Send("1"), jsonrpccxx::JsonRpcException);
+        TEST_EXCEPTION(unsupported.Send("1"), std::invalid_argument);
+    }
+    TEST_ASSERT(unreachable.Stats().open == 0 && unreachable.Stats().failed == 3);
+    TEST_ASSERT(unsupported.Stats().open == 0 && unsupported.Stats().failed == 3);
+}
+
+/// responses compressed by the server in the encodings the connector asks for
+void httpCompression_test()
+{
+    nlohmann::json bids = nlohmann::json::array();
+    for (int i = 0; i < 2000; i++)
+    {
+        bids.push_back({{"public_key", "01" + std::string(64, "0123456789abcdef"[i % 16])}, {"staked_amount", i}});
+    }
+    const std::string response =
+        nlohmann::json{{"jsonrpc", "2.0"}, {"id", 1}, {"result", {{"bids", bids}}}}.dump();
+
+    std::mutex mutex;
+    std::string accept_encoding;
+    LocalRpcServer server(
+        [&](const httplib::Request& req, httplib::Response& res)
+        {
+            std::lock_guard lock(mutex);
+            accept_encoding = req.get_header_value("Accept-Encoding");
+            res.set_content(response, "application/json");
+        });
+
+    HttpLibConnector compressed(server.Host());
+    TEST_ASSERT(compressed.Send("{}") == response);
+    {
+        std::lock_guard lock(mutex);
+        TEST_ASSERT(accept_encoding == HttpLibConnector::AcceptEncoding());
+    }
+#ifdef CPPHTTPLIB_ZLIB_SUPPORT
+    TEST_ASSERT(HttpLibConnector::AcceptEncoding().find("gzip") != std::string::npos);
+#endif
+
+    ConnectionPoolConfig config;
+    config.compression = false;
+    HttpLibConnector plain(server.Host(), config);
+    TEST_ASSERT(plain.Send("{}") == response);
+    std::lock_guard lock(mutex);
+    TEST_ASSERT(accept_encoding.empty());
+}
+
+/// JSON-RPC batches split by size, answered out of order, with per call errors
+void rpcBatch_test()
+{
+    std::atomic<int> posts{0};
+    std::atomic<bool> reject{false};
+    LocalRpcServer server(
+        [&](const httplib::Request& req, httplib::Response& res)
+        {
+            posts++;
+            auto calls = nlohmann::json::parse(req.body);
+            if (!calls.is_array())
+            {
+                calls = nlohmann::json::array({calls});
+            }
+            if (reject || calls[0].at("method") != "state_get_balance")
+            {
+                res.set_content(
+                    R"({"jsonrpc":"2.0","id":null,"error":{"code":-32000,"message":"request too large"}})",
+                    "application/json");
+                return;
+            }
+
+            auto replies = nlohmann::json::array();
+            for (auto it = calls.rbegin(); it != calls.rend(); ++it)
+            {
+                std::string purse = it->at("params").at("purse_uref");
+                nlohmann::json reply = {{"jsonrpc", "2.0"}, {"id", it->at("id")}};
+                if (purse == "bad")
+                {
+                    reply["error"] = {{"code", -32001}, {"message", "purse not found"}};
+                }
+                else
+                {
+                    reply["result"] = {{"api_version", "1.5.2"}, {"balance_value", purse}, {"merkle_proof", "01"}};
+                }
+                replies.push_back(reply);
+            }
+            res.set_content(nlohmann::json::parse(req.body).is_array() ? replies.dump() : replies[0].dump(),
+                            "application/json");
+        });
+    Client client(server.Host());
+
+    auto balances = client.GetAccountBalances({"1", "2", "bad", "4", "5"}, "srh", 2);
+    TEST_ASSERT(posts == 3);
+    TEST_ASSERT(balances.size() == 5);
+    TEST_ASSERT(balances[0].Value().balance_value == 1 && balances[4].Value().balance_value == 5);
+    TEST_ASSERT(!balances[2].Ok() && balances[2].Error()->Code() == -32001);
+    TEST_EXCEPTION(balances[2].Value(), jsonrpccxx::JsonRpcException);
+
+    // a batch answered with a single error fails each of its calls, later batches are still sent as batches
+    RpcBatch batch;
+    size_t peers = batch.Add("info_get_peers");
+    TEST_ASSERT(!batch.Get<nlohmann::json>(peers).Ok());
+    int posts_before = posts;
+    client.ExecuteBatch(batch);
+    TEST_ASSERT(posts == posts_before + 1);
+    TEST_ASSERT(batch.Get<nlohmann::json>(peers).Error()->Code() == -32000);
+    TEST_ASSERT(batch.Get<nlohmann::json>(peers).Error()->Message() == "request too large");
+    TEST_ASSERT(client.GetEndpointStats()[0].batch_supported);
+
+    // a result with an invalid value fails its own call only
+    RpcBatch balances_batch;
+    nlohmann::json params{{"state_root_hash", "srh"}, {"purse_uref", "1"}};
+    size_t good = balances_batch.Add("state_get_balance", params);
+    params["purse_uref"] = "not a number";
+    size_t malformed = balances_batch.Add("state_get_balance", params);
+    posts_before = posts;
+    client.ExecuteBatch(balances_batch);
+    TEST_ASSERT(posts == posts_before + 1);
+    TEST_ASSERT(balances_batch.Get<GetBalanceResult>(good).Ok());
+    TEST_ASSERT(balances_batch.Get<GetBalanceResult>(malformed).Error()->Code() == jsonrpccxx::parse_error);
+
+    // a failed run does not leave the results of an earlier one behind
+    reject = true;
+    client.ExecuteBatch(balances_batch);
+    TEST_ASSERT(!balances_batch.Get<GetBalanceResult>(good).Ok());
+    TEST_ASSERT(balances_batch.Get<GetBalanceResult>(good).Error()->Code() == -32000);
+    reject = false;
+
+    // a node without batch support: one rejected batch, then every call on its own
+    std::atomic<int> single_posts{0};
+    std::atomic<int> single_batches{0};
+    LocalRpcServer single(
+        [&](const httplib::Request& req, httplib::Response& res)
+        {
+            single_posts++;
+            auto call = nlohmann::json::parse(req.body);
+            if (call.is_array())
+            {
+                single_batches++;
+                res.set_content(R"({"jsonrpc":"2.0","id":null,"error":{"code":-32600,"message":"Invalid Request"}})",
+                                "application/json");
+                return;
+            }
+            std::string purse = call.at("params").at("purse_uref");
+            nlohmann::json result = {{"api_version", "1.5.2"}, {"balance_value", purse}, {"merkle_proof", "01"}};
+            res.set_content(nlohmann::json{{"jsonrpc", "2.0"}, {"id", call.at("id")}, {"result", result}}.dump(),
+                            "application/json");
+        });
+    Client single_client(single.Host());
+    auto single_balances = single_client.GetAccountBalances({"1", "2", "3"}, "srh", 2);
+    TEST_ASSERT(single_posts == 4);
+    TEST_ASSERT(single_balances[0].Value().balance_value == 1 && single_balances[2].Value().balance_value == 3);
+    single_balances = single_client.GetAccountBalances({"4", "5"}, "srh");
+    TEST_ASSERT(single_posts == 6 && single_balances[1].Value().balance_value == 5);
+    TEST_ASSERT(!single_client.GetEndpointStats()[0].batch_supported);
+
+    // with several nodes, only the one refusing batches stops getting them
+    Client both({single.Host(), server.Host()}, EndpointRouterConfig{});
+    single_posts = 0;
+    single_batches = 0;
+    posts_before = posts;
+    auto both_balances = both.GetAccountBalances({"1", "2", "3"}, "srh", 2);
+    TEST_ASSERT(both_balances[0].Value().balance_value == 1 && both_balances[2].Value().balance_value == 3);
+    TEST_ASSERT(single_batches == 1 && single_posts == 1);
+    TEST_ASSERT(posts == posts_before + 2);
+    TEST_ASSERT(!both.GetEndpointStats()[0].batch_supported && both.GetEndpointStats()[1].batch_supported);
+}
+
+/// coroutine that starts at once and is never awaited, enough to co_await in a test
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+DetachedTask sumBalances(Client& client, std::vector<std::string> purses, std::promise<uint512_t>& total)
+{
+    uint512_t sum = 0;
+    for (const auto& purse : purses)
+    {
+        sum += (co_await client.GetAccountBalanceAsync(purse, "srh")).balance_value;
+    }
+    total.set_value(sum);
+}
+
+/// asynchronous calls coalesced into batches, with callbacks, coroutines and cancellation
+void asyncRpc_test()
+{
+    std::atomic<int> posts{0};
+    std::promise<void> entered;
+    std::promise<void> opened;
+    opened.set_value();
+    std::shared_future<void> gate = opened.get_future().share();
+    std::promise<void> open_gate;
+    bool gated = false;
+    std::mutex gate_mutex;
+
+    LocalRpcServer server(
+        [&](const httplib::Request& req, httplib::Response& res)
+        {
+            posts++;
+            std::shared_future<void> wait_for;
+            {
+                std::lock_guard lock(gate_mutex);
+                if (gated)
+                {
+                    gated = false;
+                    entered.set_value();
+                    gate = open_gate.get_future().share();
+                }
+                wait_for = gate;
+            }
+            wait_for.wait();
+
+            auto reply = [](const nlohmann::json& call)
+            {
+                std::string purse = call.at("params").at("purse_uref");
+                nlohmann::json reply = {{"jsonrpc", "2.0"}, {"id", call.at("id")}};
+                if (purse == "bad")
+                {
+                    reply["error"] = {{"code", -32001}, {"message", "purse not found"}};
+                }
+                else
+                {
+                    reply["result"] = {{"api_version", "1.5.2"}, {"balance_value", purse}, {"merkle_proof", "01"}};
+                }
+                return reply;
+            };
+            auto calls = nlohmann::json::parse(req.body);
+            if (!calls.is_array())
+            {
+                res.set_content(reply(calls).dump(), "application/json");
+                return;
+            }
+            auto replies = nlohmann::json::array();
+            for (const auto& call : calls)
+            {
+                replies.push_back(reply(call));
+            }
+            res.set_content(replies.dump(), "application/json");
+        });
+
+    // queued calls are coalesced into batches by default
+    TEST_ASSERT(AsyncConfig{}.max_coalesced_calls > 1);
+    AsyncConfig async_config;
+    async_config.threads = 1;
+    async_config.max_coalesced_calls = RpcBatch::DEFAULT_MAX_SIZE;
+    Client client(server.Host(), ConnectionPoolConfig{}, async_config);
+
+    // futures, one per call, each with its own id
+    std::vector<AsyncCall<GetBalanceResult>> calls;
+    for (int i = 1; i <= 100; i++)
+    {
+        calls.push_back(client.GetAccountBalanceAsync(std::to_string(i), "srh"));
+    }
+    auto bad = client.GetAccountBalanceAsync("bad", "srh").Future();
+    for (size_t i = 0; i < calls.size(); i++)
+    {
+        TEST_ASSERT(calls[i].Get().balance_value == i + 1);
+        TEST_ASSERT(i == 0 || calls[i].Id() > calls[i - 1].Id());
+    }
+    TEST_EXCEPTION(bad.get(), jsonrpccxx::JsonRpcException);
+    TEST_ASSERT(!calls[0].Cancel());
+
+    // a result that can not be converted fails the call instead of leaving it pending
+    try
+    {
+        client.GetAccountBalanceAsync("not a number", "srh").Get();
+        TEST_CHECK(false);
+    }
+    catch (const jsonrpccxx::JsonRpcException& e)
+    {
+        TEST_ASSERT(e.Code() == jsonrpccxx::parse_error);
+    }
+    std::promise<bool> malformed_ok;
+    client.GetAccountBalanceAsync("not a number", "srh",
+                                  [&](BatchResult<GetBalanceResult> result) { malformed_ok.set_value(result.Ok()); });
+    TEST_ASSERT(!malformed_ok.get_future().get());
+    TEST_ASSERT(client.GetPendingAsyncCalls() == 0);
+
+    // callbacks, run on the executor thread
+    std::promise<uint512_t> callback_total;
+    int remaining = 3;
+    uint512_t sum = 0;
+    for (std::string purse : {"5", "6", "7"})
+    {
+        client.GetAccountBalanceAsync(purse, "srh",
+                                      [&](BatchResult<GetBalanceResult> result)
+                                      {
+                                          sum += result.Value().balance_value;
+                                          if (--remaining == 0)
+                                          {
+                                              callback_total.set_value(sum);
+                                          }
+                                      });
+    }
+    TEST_ASSERT(callback_total.get_future().get() == 18);
+
+    // a coroutine resumed by each result
+    std::promise<uint512_t> coroutine_total;
+    sumBalances(client, {"10", "20", "30"}, coroutine_total);
+    TEST_ASSERT(coroutine_total.get_future().get() == 60);
+
+    // the next request is held by the server, the calls queued behind it go out together
+    {
+        std::lock_guard lock(gate_mutex);
+        gated = true;
+    }
+    int posts_before = posts;
+    auto held = client.GetAccountBalanceAsync("1", "srh");
+    entered.get_future().wait();
+
+    std::vector<AsyncCall<GetBalanceResult>> queued;
+    for (int i = 2; i <= 6; i++)
+    {
+        queued.push_back(client.GetAccountBalanceAsync(std::to_string(i), "srh"));
+    }
+    TEST_ASSERT(client.CancelAsync(queued[1].Id()));
+    TEST_ASSERT(held.Cancel());
+    TEST_ASSERT(!held.Cancel());
+    try
+    {
+        held.Get();
+        TEST_CHECK(false);
+    }
+    catch (const jsonrpccxx::JsonRpcException& e)
+    {
+        TEST_ASSERT(e.Code() == RPC_CANCELLED);
+    }
+
+    open_gate.set_value();
+    TEST_ASSERT(queued[0].Get().balance_value == 2 && queued[4].Get().balance_value == 6);
+    TEST_EXCEPTION(queued[1].Get(), jsonrpccxx::JsonRpcException);
+    TEST_ASSERT(posts == posts_before + 2);
+
+    // with the default settings, a node without batch support gets the coalesced calls one by one
+    std::atomic<int> refused_batches{0};
+    LocalRpcServer no_batches(
+        [&](const httplib::Request& req, httplib::Response& res)
+        {
+            auto call = nlohmann::json::parse(req.body);
+            if (call.is_array())
+            {
+                refused_batches++;
+                res.set_content(
+                    R"({"jsonrpc":"2.0","id":null,"error":{"code":-32601,"message":"Method not found"}})",
+                    "application/json");
+                return;
+            }
+            nlohmann::json result = {{"api_version", "1.5.2"},
+                                     {"balance_value", call.at("params").at("purse_uref")},
+                                     {"merkle_proof", "01"}};
+            res.set_content(nlohmann::json{{"jsonrpc", "2.0"}, {"id", call.at("id")}, {"result", result}}.dump(),
+                            "application/json");
+        });
+    AsyncConfig one_thread;
+    one_thread.threads = 1;
+    Client no_batch_client(no_batches.Host(), ConnectionPoolConfig{}, one_thread);
+    std::vector<AsyncCall<GetBalanceResult>> unbatched;
+    for (int i = 1; i <= 20; i++)
+    {
+        unbatched.push_back(no_batch_client.GetAccountBalanceAsync(std::to_string(i), "srh"));
+    }
+    for (size_t i = 0; i < unbatched.size(); i++)
+    {
+        TEST_ASSERT(unbatched[i].Get().balance_value == i + 1);
+    }
+    TEST_ASSERT(refused_batches <= 1);
+}
+
+/// stand-in node with a name, a block height and an injected latency, failing while `failing` is set
+httplib::Server::Handler standInNode(std::string name, uint64_t height, int latency_ms,
+                                     const std::atomic<bool>* failing = nullptr)
+{
+    return [=](const httplib::Request& req, httplib::Response& res)
+    {
+        if (failing && *failing)
+        {
+            res.status = 500;
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(latency_ms));
+
+        auto call = nlohmann::json::parse(req.body);
+        nlohmann::json result = {{"node", name}};
+        if (call.at("method") == "info_get_status")
+        {
+            result = {{"last_added_block_info", {{"height", height}}}};
+        }
+        res.set_content(nlohmann::json{{"jsonrpc", "2.0"}, {"id", call.at("id")}, {"result", result}}.dump(),
+                        "application/json");
+    };
+}
+
+/// calls routed by latency, failed nodes ejected and probed back, height sensitive calls pinned
+void endpointRouter_test()
+{
+    const std::string peers = R"({"id":1,"jsonrpc":"2.0","method":"info_get_peers"})";
+    auto nodeOf = [](const std::string& response)
+    { return nlohmann::json::parse(response).at("result").at("node").get<std::string>(); };
+
+    std::atomic<bool> failing{false};
+    LocalRpcServer fast(standInNode("fast", 100, 0, &failing));
+    LocalRpcServer slow(standInNode("slow", 100, 25));
+
+    EndpointRouterConfig config;
+    config.probe_interval = std::chrono::milliseconds(20);
+    EndpointRouter router({fast.Host(), slow.Host()}, config);
+
+    // each node is tried once, then the fast one takes every call
+    int slow_calls = 0;
+    for (int i = 0; i < 20; i++)
+    {
+        slow_calls += nodeOf(router.Send(peers)) == "slow";
+    }
+    TEST_ASSERT(slow_calls == 1);
+    TEST_ASSERT(router.Endpoints()[0].latency_ms < router.Endpoints()[1].latency_ms);
+
+    // failed calls are retried on the other node until the failing one is ejected
+    failing = true;
+    for (int i = 0; i < 4; i++)
+    {
+        TEST_ASSERT(nodeOf(router.Send(peers)) == "slow");
+    }
+    auto stats = router.Endpoints();
+    TEST_ASSERT(!stats[0].healthy && stats[0].ejections == 1 && stats[0].failures == 2);
+    TEST_ASSERT(stats[1].healthy && stats[1].failures == 0);
+
+    // the probes put it back once it answers again
+    failing = false;
+    for (int i = 0; i < 200 && !router.Endpoints()[0].healthy; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    TEST_ASSERT(router.Endpoints()[0].healthy);
+    TEST_ASSERT(nodeOf(router.Send(peers)) == "fast");
+
+    // a single node that fails is still the one called
+    slow.Stop();
+    EndpointRouter single({slow.Host()}, config);
+    TEST_EXCEPTION(single.Send(peers), jsonrpccxx::JsonRpcException);
+    TEST_EXCEPTION(single.Send(peers), jsonrpccxx::JsonRpcException);
+    TEST_ASSERT(!single.Endpoints()[0].healthy && single.Endpoints()[0].requests == 2);
+
+    // a node without samples yet gets one call at a time, not every concurrent one
+    LocalRpcServer quick(standInNode("quick", 100, 0));
+    LocalRpcServer sluggish(standInNode("sluggish", 100, 300));
+    EndpointRouter fresh({quick.Host(), sluggish.Host()}, config);
+    TEST_ASSERT(nodeOf(fresh.Send(peers)) == "quick");
+    std::atomic<int> sluggish_calls{0};
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 8; i++)
+    {
+        callers.emplace_back([&] { sluggish_calls += nodeOf(fresh.Send(peers)) == "sluggish"; });
+    }
+    for (auto& caller : callers)
+    {
+        caller.join();
+    }
+    TEST_ASSERT(sluggish_calls == 1);
+
+    // failed status probes lower the health of a node but are not requests
+    std::atomic<bool> probe_failing{true};
+    LocalRpcServer probed(standInNode("probed", 100, 0, &probe_failing));
+    EndpointRouterConfig probing = config;
+    probing.pin_height_sensitive_calls = true;
+    EndpointRouter pinned({probed.Host()}, probing);
+    for (int i = 0; i < 200 && pinned.Endpoints()[0].healthy; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    TEST_ASSERT(!pinned.Endpoints()[0].healthy && pinned.Endpoints()[0].ejections == 1);
+    TEST_ASSERT(pinned.Endpoints()[0].requests == 0 && pinned.Endpoints()[0].failures == 0);
+
+    // other errors of the connector also release the node and count as failures
+    EndpointRouter unsupported({"ftp://127.0.0.1:1"}, EndpointRouterConfig{});
+    TEST_EXCEPTION(unsupported.Send(peers), std::invalid_argument);
+    TEST_ASSERT(unsupported.Endpoints()[0].in_flight == 0 && unsupported.Endpoints()[0].failures == 1);
+
+    // a fast node lagging behind gets the other calls but no height sensitive one
+    LocalRpcServer lagging(standInNode("lagging", 90, 0));
+    LocalRpcServer synced(standInNode("synced", 100, 10));
+    config.pin_height_sensitive_calls = true;
+    config.max_height_lag = 5;
+    Client client({lagging.Host(), synced.Host()}, config);
+    for (int i = 0; i < 200; i++)
+    {
+        auto endpoints = client.GetEndpointStats();
+        if (endpoints[0].height && endpoints[1].height)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    TEST_ASSERT(client.GetEndpointStats()[0].height == 90 && client.GetEndpointStats()[1].height == 100);
+    for (int i = 0; i < 3; i++)
+    {
+        TEST_ASSERT(client.CallAsync<nlohmann::json>("chain_get_block").Get().at("node") == "synced");
+        TEST_ASSERT(client.CallAsync<nlohmann::json>("info_get_peers").Get().at("node") == "lagging");
+    }
+
+    // only the method of the call counts, not a parameter of the same name
+    nlohmann::json params{{"method", "chain_get_block"}};
+    TEST_ASSERT(client.CallAsync<nlohmann::json>("info_get_peers", params).Get().at("node") == "lagging");
+}
+
+/// byte buffers with inline storage for small sizes
+void bytes_test()
+{
+    CBytes small(Bytes::INLINE_CAPACITY);
+    TEST_ASSERT(small.IsInline());
+    TEST_ASSERT(std::all_of(small.begin(), small.end(), [](uint8_t b) { return b == 0; }));
+
+    CBytes hash = hexDecode("989ca079a5e446071866331468ab949483162588d57ec13ba6bb051f1e15f8b7");
+    CBytes copy = hash;
+    TEST_ASSERT(copy == hash && copy.IsInline());
+
+    // a tagged secp256k1 signature fits inline
+    CBytes signature(65);
+    CBytes signature_copy = signature;
+    TEST_ASSERT(signature.IsInline() && signature_copy.IsInline());
+
+    // appending past the inline buffer moves to the heap, also from itself
+    CBytes grown = hash;
+    grown += grown;
+    grown += grown;
+    TEST_ASSERT(!grown.IsInline() && grown.size() == 4 * hash.size());
+    TEST_ASSERT(CBytes(grown.data() + 96, 32) == hash);
+
+    CBytes moved = std::move(grown);
+    TEST_ASSERT(moved.size() == 128 && grown.empty());
+    moved.resize(130);
+    TEST_ASSERT(moved[129] == 0 && moved != hash);
+
+    CBytes joined = CBytes{0x01} + hash;
+    TEST_ASSERT(joined.size() == 33 && joined[0] == 0x01 && joined[1] == hash[0]);
+}
+
+/// fixed size hashes parsed from and formatted to hex
+void hash32_test()
+{
+    const std::string checksummed = "308d2a0eCF66bDAcAC5Cf6184C732D83DCeB48A859169e5680FE17cF32Bb974F";
+    std::string lower = checksummed;
+    StringUtil::toLower(lower);
+
+    Hash32 hash = Hash32::FromString(checksummed);
+    TEST_ASSERT(hash == Hash32::FromString(lower));
+    TEST_ASSERT(hash.ToString() == lower);
+    TEST_ASSERT(hash.ToChecksumString() == checksummed);
+    TEST_ASSERT(hash.ToCBytes() == hexDecode(lower));
+    TEST_ASSERT(Hash32::FromBytes(hash.ToCBytes()) == hash);
+    TEST_ASSERT(!hash.IsZero() && Hash32().IsZero());
+
+    std::string wrong_case = checksummed;
+    wrong_case[8] = 'c';
+    TEST_EXCEPTION(Hash32::FromString(wrong_case), std::invalid_argument);
+    TEST_EXCEPTION(Hash32::FromString(lower.substr(2)), std::invalid_argument);
+    TEST_EXCEPTION(Hash32::FromString(lower.substr(2) + "zz"), std::invalid_argument);
+    TEST_EXCEPTION(Hash32::FromBytes(CBytes(31)), std::invalid_argument);
+
+    nlohmann::json j = hash;
+    TEST_ASSERT(j.get<std::string>() == lower);
+    TEST_ASSERT(j.get<Hash32>() == hash);
+
+    std::unordered_set<Hash32> set{hash, Hash32::FromString(lower), Hash32()};
+    TEST_ASSERT(set.size() == 2);
+
+    // the hash fields still read as strings and compare with them, a string is only parsed when asked
+    std::string text = hash;
+    TEST_ASSERT(text == lower);
+    TEST_ASSERT(hash == lower && hash == checksummed && hash == lower.c_str());
+    TEST_ASSERT(!(hash == lower.substr(2)) && !(hash == std::string(64, 'z')));
+    TEST_ASSERT(!(hash == "g" + lower.substr(1)) && !(Hash32() == lower));
+    static_assert(!std::is_convertible_v<std::string, Hash32>);
+    Deploy deploy;
+    deploy.hash = Hash32(checksummed);
+    TEST_ASSERT(deploy.hash == hash);
+    std::ostringstream os;
+    os << hash;
+    TEST_ASSERT(os.str() == lower);
+}
+
+/// decimal strings of U128/U256/U512 amounts
+void uint512_decimal_test()
+{
+    const std::string max512 = "1340780792994259709957402499820584612747936582059239337772356144372176403007354697680187"
+                               "4298166903427690031858186486050853753882811946569946433649006084095";
+    const std::string values[] = {"0", "7", "18446744073709551615", "18446744073709551616", "1000000000000000000000000000",
+                                  "340282366920938463463374607431768211455", "99999999999999999999999999999999999999",
+                                  "100000000000000000000000000000000000000", max512};
+
+    for (const auto& value : values)
+    {
+        TEST_ASSERT(u512ToDec(u512FromDec(value)) == value);
+        TEST_MSG("value: %s", value.c_str());
+    }
+
+    TEST_ASSERT(u512FromDec("1000000000000000000000") == uint512_t(1000000000000000000ull) * 1000u);
+    TEST_ASSERT(u128ToDec(u128FromDec("340282366920938463463374607431768211455")) ==
+                "340282366920938463463374607431768211455");
+    TEST_ASSERT(u256ToDec(uint256_t(1) << 200) ==
+                "1606938044258990275541962092341162602522202993782792835301376");
+
+    // leading zeros are accepted, the result is printed without them
+    TEST_ASSERT(u512ToDec(u512FromDec("000000000000000000000042")) == "42");
+
+    TEST_EXCEPTION(u512FromDec(""), std::invalid_argument);
+    TEST_EXCEPTION(u512FromDec("12a4"), std::invalid_argument);
+    TEST_EXCEPTION(u512FromDec("-1"), std::invalid_argument);
+    TEST_EXCEPTION(u128FromDec("340282366920938463463374607431768211456"), std::out_of_range);
+    TEST_EXCEPTION(u512FromDec(max512 + "0"), std::out_of_range);
+}
+
 void clValue_with_UnitTest()
 {
     clValue_with_jsonFile("Unit.json");
@@ -532,9 +1739,74 @@ void globalStateKey_serializer_test()
     EraInfoKey era_info_key("era-2685");
 
     std::string expected_era_bytes_str = "057d0a000000000000";
-    // TODO:
-    // globalStateKey_serialize<EraInfoKey>(era_info_key,
-    // expected_era_bytes_str);
+    globalStateKey_serialize<EraInfoKey>(era_info_key, expected_era_bytes_str);
+}
+
+/// keys parsed from their prefixed strings and decoded from bytes
+void globalStateKey_parse_test()
+{
+    const std::string address = "989ca079a5e446071866331468ab949483162588d57ec13ba6bb051f1e15f8b7";
+
+    GlobalStateKey hash_key = GlobalStateKey::FromString("hash-" + address);
+    TEST_ASSERT(hash_key.key_identifier == KeyIdentifier::Hash);
+    TEST_ASSERT(hash_key.GetRawBytes() == hexDecode(address));
+    TEST_ASSERT(GlobalStateKey::FromString("contract-" + address) == hash_key);
+    TEST_ASSERT(GlobalStateKey::FromString("contract-wasm-" + address) == hash_key);
+    TEST_ASSERT(GlobalStateKey::FromString("contract-package-wasm" + address) == hash_key);
+
+    for (const std::string prefix : {"account-hash-", "transfer-", "deploy-", "balance-", "bid-", "withdraw-",
+                                     "dictionary-"})
+    {
+        GlobalStateKey key = GlobalStateKey::FromString(prefix + address);
+        TEST_CHECK(key.ToString() == prefix + CEP57Checksum::Encode(hexDecode(address)));
+        TEST_CHECK(GlobalStateKey::FromBytes(key.GetBytes()) == key);
+        TEST_MSG("prefix: %s", prefix.c_str());
+    }
+
+    GlobalStateKey uref = GlobalStateKey::FromString("uref-" + address + "-007");
+    TEST_ASSERT(uref.key_identifier == KeyIdentifier::URef);
+    TEST_ASSERT(uref.access_rights == AccessRights::READ_ADD_WRITE);
+    TEST_ASSERT(URef(uref.ToString()) == uref);
+
+    GlobalStateKey era = GlobalStateKey::FromString("era-2685");
+    TEST_ASSERT(era.ToString() == "era-2685");
+    TEST_ASSERT(EraInfoKey(2685) == era);
+    TEST_ASSERT(hexEncode(era.GetBytes()) == "057d0a000000000000");
+
+    TEST_EXCEPTION(GlobalStateKey::FromString("key-" + address), std::invalid_argument);
+    TEST_EXCEPTION(GlobalStateKey::FromString("hash-" + address.substr(2)), std::invalid_argument);
+    TEST_EXCEPTION(GlobalStateKey::FromString("era-12a"), std::invalid_argument);
+    TEST_EXCEPTION(HashKey("transfer-" + address), std::invalid_argument);
+    TEST_EXCEPTION(URef("uref-" + address + "-008"), std::runtime_error);
+}
+
+void uref_parse_test()
+{
+    const std::string address = "989ca079a5e446071866331468ab949483162588d57ec13ba6bb051f1e15f8b7";
+    const std::string checksummed = CEP57Checksum::Encode(hexDecode(address));
+
+    URef uref = URef::FromString("uref-" + address + "-005");
+    TEST_ASSERT(uref.access_rights == AccessRights::READ_ADD);
+    TEST_ASSERT(uref.GetRawBytes() == hexDecode(address));
+    TEST_ASSERT(uref.ToString() == "uref-" + checksummed + "-005");
+    TEST_ASSERT(URef::byteToStringWithAccessRights(hexDecode(address + "05")) == uref.ToString());
+    TEST_ASSERT(urefDecode(address + "05") == uref);
+
+    std::vector<std::string> purses = {"uref-" + checksummed + "-007", "uref-" + address + "-001"};
+    std::vector<URef> parsed = URef::FromStrings(purses);
+    TEST_ASSERT(parsed.size() == 2);
+    TEST_ASSERT(parsed[0].ToString() == purses[0]);
+    TEST_ASSERT(parsed[1].access_rights == AccessRights::READ);
+
+    std::string wrong_case = "uref-" + checksummed + "-007";
+    size_t letter = wrong_case.find_first_of("abcdefABCDEF", 5);
+    wrong_case[letter] ^= 0x20;
+    purses.push_back(wrong_case);
+    TEST_EXCEPTION(URef::FromStrings(purses), std::runtime_error);
+    TEST_EXCEPTION(URef::FromString("uref-" + address + "-07"), std::runtime_error);
+    TEST_EXCEPTION(URef::FromString("uref-" + address + "_007"), std::runtime_error);
+    TEST_EXCEPTION(URef::FromString("uref-" + address.substr(1) + "x-007"), std::runtime_error);
+    TEST_EXCEPTION(URef::FromString("hash-" + address), std::runtime_error);
 }
 
 // Executable Deploy Item Byte Serializer Tests //
@@ -605,14 +1877,20 @@ TEST_LIST = {
     {"StoredVersionedContractByHashSerialization", DeployItem_ByteSer_StoredVersionedContractByHash_Test},
     {"StoredVersionedContractByNameSerialization", DeployItem_ByteSer_StoredVersionedContractByName_Test},
     {"TransferDeployItemSerialization", DeployItem_ByteSer_Transfer_Test},
+    {"Deploy body and header hashes", Deploy_ByteSer_ComputeHashes_Test},
+    {"Deploy size calculator", Deploy_ByteSer_SizeOf_Test},
+    {"Deploy decoding from bytes", Deploy_ByteSer_FromBytes_Test},
 #endif
 
 #if UTILS_TEST == 1
     {"ED25519 Key Test", ed25KeyTest},
     {"PublicKey Load fromFile", publicKey_load_fromFileTest},
     {"getAccountHash checks internal PublicKey to AccountHash converter", publicKey_getAccountHashTest},
+    {"PublicKeyTable", publicKeyTable_test},
     {"toLower checks internal lower case converter", stringUtil_toLowerTest},
     {"gsk test", globalStateKey_serializer_test},
+    {"GlobalStateKey parsing", globalStateKey_parse_test},
+    {"URef parsing", uref_parse_test},
 #endif
 
 #if RPC_TEST == 1
@@ -653,11 +1931,14 @@ TEST_LIST = {
     {"CLType json", cltype_json_test},
     {"CLType List<String>", cltype_str_list_test},
     {"CLValue parsed", clTypeParsed_test},
+    {"CLValue lazy parsed", clValue_lazyParsed_test},
+    {"CLValue parsed arrays", clTypeParsedArray_test},
 
     {"CLType Tuple1", clType_tuple1_test},
     {"CLType Tuple2", clType_tuple2_test},
     {"CLType Tuple2 recursive", clType_tuple2_recursiveTest},
     {"CLType Tuple3", clType_tuple3_test},
+    {"CLType table", clType_table_test},
     {"CLType Option", clType_option_test},
     {"CLType Option recursive", clType_option_recursiveTest},
 #endif
@@ -675,6 +1956,17 @@ TEST_LIST = {
     {"CLValue using U256-2", clValue_with_U256_2Test},
     {"CLValue using U512", clValue_with_U512Test},
     {"CLValue using U512-0", clValue_with_U512_0Test},
+    {"U512 decimal conversion", uint512_decimal_test},
+    {"Hex codec", hexCodec_test},
+    {"BLAKE2b batch", blake2bBatch_test},
+    {"HTTP connection pool", httpConnectionPool_test},
+    {"HTTP compression", httpCompression_test},
+    {"JSON-RPC batch", rpcBatch_test},
+    {"Asynchronous RPC", asyncRpc_test},
+    {"Endpoint routing", endpointRouter_test},
+    {"CEP-57 checksum", cep57Checksum_test},
+    {"Bytes", bytes_test},
+    {"Hash32", hash32_test},
     {"CLValue using Unit", clValue_with_UnitTest},
     {"CLValue using String", clValue_with_StringTest},
     {"CLValue using URef", clValue_with_URefTest},
@@ -26,7 +26,7 @@ void DeployItem_ByteSer_StoredContractByHash_Test()
     ExecutableDeployItemByteSerializer ser;
     Casper::HashKey hash_key("hash-0102030401020304010203040102030401020304010203040102030401020304");
     StoredContractByHash stored_contract_by_hash(hash_key.ToHexString(), "counter_inc");
-    TEST_ASSERT(stored_contract_by_hash.hash == CEP57Checksum::Encode(hash_key.raw_bytes));
+    TEST_ASSERT(stored_contract_by_hash.hash == CEP57Checksum::Encode(hash_key.GetRawBytes()));
     TEST_ASSERT(stored_contract_by_hash.entry_point == "counter_inc");
     TEST_ASSERT(stored_contract_by_hash.args.size() == 0);
 
@@ -65,7 +65,7 @@ void DeployItem_ByteSer_StoredVersionedContractByHash_Test()
     ExecutableDeployItemByteSerializer ser;
     Casper::HashKey hash_key("hash-0102030401020304010203040102030401020304010203040102030401020304");
     StoredVersionedContractByHash stored_versioned_contract_by_hash(hash_key.ToHexString(), 1, "counter_inc");
-    TEST_ASSERT(stored_versioned_contract_by_hash.hash == CEP57Checksum::Encode(hash_key.raw_bytes));
+    TEST_ASSERT(stored_versioned_contract_by_hash.hash == CEP57Checksum::Encode(hash_key.GetRawBytes()));
     TEST_ASSERT(stored_versioned_contract_by_hash.version == 1);
     TEST_ASSERT(stored_versioned_contract_by_hash.entry_point == "counter_inc");
     TEST_ASSERT(stored_versioned_contract_by_hash.args.size() == 0);
@@ -118,4 +118,222 @@ void DeployItem_ByteSer_Transfer_Test()
     TEST_ASSERT(expected_transfer_item_str == actual_transfer_bytes);
 }
 
+/// Deploy body and header hashes streamed through the BLAKE2b sink
+void Deploy_ByteSer_ComputeHashes_Test()
+{
+    std::string file_path = __FILE__;
+    std::string dir_path = file_path.substr(0, file_path.rfind("/"));
+    std::ifstream ifs(dir_path + "/data/Deploy/Transfer.json");
+    nlohmann::json input_json = nlohmann::json::parse(ifs);
+
+    Deploy deploy;
+    from_json(input_json, deploy);
+
+    TEST_ASSERT(hexEncode(deploy.ComputeBodyHash(deploy.payment, deploy.session)) ==
+                "a3f5147282396f8c0bdb7984c62374d9899b6c6cc953a3909c6c1fa1232cd93c");
+    TEST_ASSERT(hexEncode(deploy.ComputeHeaderHash(deploy.header)) ==
+                "bba5fb89a48f71e6d00077a56854df3bbafb7ad4c1332f3956f1c2f2f97257fe");
+
+    // the ttl of the header is serialized as given, not as 30 minutes
+    DeployHeader hour_header = deploy.header;
+    hour_header.ttl = "1h";
+    TEST_ASSERT(hexEncode(deploy.ComputeHeaderHash(hour_header)) ==
+                "00ca95baa6a17cd6686edf70c352e07ec108d4620b0c37ff8376e1185bc22c0e");
+    DeployHeader day_header = deploy.header;
+    day_header.ttl = "1day 2h";
+    TEST_ASSERT(hexEncode(deploy.ComputeHeaderHash(day_header)) ==
+                "4ce401fca989342329aec9849a9e4fc67d923884f5059d5b3cf8e76179d7600a");
+
+    std::string message;
+    TEST_ASSERT(deploy.ValidateHashes(message));
+}
+
+/// Size calculator matches the serializer output
+void Deploy_ByteSer_SizeOf_Test()
+{
+    std::string file_path = __FILE__;
+    std::string dir_path = file_path.substr(0, file_path.rfind("/"));
+
+    CLValueByteSerializer valueSerializer;
+    for (const std::string file_name :
+         {"Any.json", "Bool-True.json", "ByteArray.json", "I64.json", "Key.json", "List.json", "ListByteArray32.json",
+          "ListOptionString.json", "Map.json", "OptionListKey-NULL.json", "OptionU64.json", "PublicKey.json",
+          "String.json", "Tuple1.json", "Tuple2.json", "Tuple3.json", "U512.json", "URef.json", "Unit.json"})
+    {
+        std::ifstream ifs(dir_path + "/data/CLValue/" + file_name);
+        CLValue value;
+        from_json(nlohmann::json::parse(ifs), value);
+
+        TEST_CHECK(ByteSizeCalculator::SizeOf(value) == valueSerializer.ToBytes(value).size());
+        TEST_MSG("CLValue file: %s", file_name.c_str());
+    }
+
+    // measuring a type does not intern it
+    std::map<std::string, int32_t> byte_array{{"ByteArray", 12345}};
+    std::map<std::string, CLTypeRVA> ok_err{{"Ok", byte_array}, {"Err", CLTypeEnum::String}};
+    std::map<std::string, CLTypeRVA> result{{"Result", ok_err}};
+    std::map<std::string, CLTypeRVA> list{{"List", result}};
+    size_t types = CLTypeTable::Instance().Size();
+    TEST_CHECK(ByteSizeCalculator::SizeOf(CLTypeRVA(list)) == CLTypeTable::Encode(list).size());
+    TEST_CHECK(CLTypeTable::Instance().Size() == types);
+
+    ExecutableDeployItemByteSerializer itemSerializer;
+    Casper::HashKey hash_key("hash-0102030401020304010203040102030401020304010203040102030401020304");
+    std::vector<ExecutableDeployItem> items = {
+        ExecutableDeployItem(ModuleBytes(u512FromDec("1000"))),
+        ExecutableDeployItem(StoredContractByHash(hash_key.ToHexString(), "counter_inc")),
+        ExecutableDeployItem(StoredVersionedContractByHash(hash_key.ToHexString(), 1, "counter_inc")),
+        ExecutableDeployItem(StoredVersionedContractByName("counter", "counter_inc")),
+    };
+    for (const auto& item : items)
+    {
+        TEST_CHECK(ByteSizeCalculator::SizeOf(item) == itemSerializer.ToBytes(item).size());
+    }
+
+    std::ifstream ifs(dir_path + "/data/Deploy/Transfer.json");
+    Deploy deploy;
+    from_json(nlohmann::json::parse(ifs), deploy);
+
+    DeployByteSerializer deploySerializer;
+    TEST_CHECK(ByteSizeCalculator::SizeOf(deploy) == deploySerializer.ToBytes(deploy).size());
+    TEST_CHECK(deploy.GetDeploySizeInBytes() == 369);
+}
+
+/// Decoding serialized deploys, deploy items and CLValues gives back the same values
+void Deploy_ByteSer_FromBytes_Test()
+{
+    std::string file_path = __FILE__;
+    std::string dir_path = file_path.substr(0, file_path.rfind("/"));
+
+    CLValueByteSerializer valueSerializer;
+    for (const std::string file_name :
+         {"Bool-False.json", "ByteArray.json", "I32.json", "Key.json", "ListByteArray32.json", "ListU8.json",
+          "ListU256.json", "Map.json", "OptionU64-NULL.json", "PublicKey.json", "String.json", "Tuple3.json",
+          "U128.json", "U512-0.json", "URef.json", "Unit.json"})
+    {
+        std::ifstream ifs(dir_path + "/data/CLValue/" + file_name);
+        CLValue value;
+        from_json(nlohmann::json::parse(ifs), value);
+
+        CBytes bytes = valueSerializer.ToBytes(value);
+        CLValue decoded = valueSerializer.FromBytes(std::span<const uint8_t>(bytes.data(), bytes.size()));
+
+        nlohmann::json expected_json;
+        nlohmann::json decoded_json;
+        to_json(expected_json, value);
+        to_json(decoded_json, decoded);
+        TEST_CHECK(iequals(expected_json.dump(), decoded_json.dump()));
+        TEST_MSG("CLValue file: %s", file_name.c_str());
+    }
+
+    ExecutableDeployItemByteSerializer itemSerializer;
+    Casper::HashKey hash_key("hash-0102030401020304010203040102030401020304010203040102030401020304");
+    std::vector<ExecutableDeployItem> items = {
+        ExecutableDeployItem(ModuleBytes(u512FromDec("1000"))),
+        ExecutableDeployItem(StoredContractByHash(hash_key.ToHexString(), "counter_inc")),
+        ExecutableDeployItem(StoredContractByName("counter", "counter_inc")),
+        ExecutableDeployItem(StoredVersionedContractByHash(hash_key.ToHexString(), 1, "counter_inc")),
+        ExecutableDeployItem(StoredVersionedContractByName("counter", "counter_inc")),
+    };
+    for (const auto& item : items)
+    {
+        CBytes bytes = itemSerializer.ToBytes(item);
+        ExecutableDeployItem decoded = itemSerializer.FromBytes(std::span<const uint8_t>(bytes.data(), bytes.size()));
+        TEST_CHECK(itemSerializer.ToBytes(decoded) == bytes);
+    }
+
+    std::ifstream ifs(dir_path + "/data/Deploy/Transfer.json");
+    Deploy deploy;
+    from_json(nlohmann::json::parse(ifs), deploy);
+
+    DeployByteSerializer deploySerializer;
+    CBytes bytes = deploySerializer.ToBytes(deploy);
+    Deploy decoded = deploySerializer.FromBytes(std::span<const uint8_t>(bytes.data(), bytes.size()));
+
+    TEST_CHECK(decoded.header.timestamp == "2022-04-23T09:38:21.700Z");
+    TEST_CHECK(decoded.header.ttl == "30m");
+    TEST_CHECK(strToDuration("1day 2h") == 93600000);
+    TEST_EXCEPTION(strToDuration("999999999999d"), std::out_of_range);
+    TEST_CHECK(iequals(decoded.toString(), deploy.toString()));
+    TEST_CHECK(deploySerializer.ToBytes(decoded) == bytes);
+
+    // truncated input must be rejected, not read past the end
+    bool threw = false;
+    try
+    {
+        deploySerializer.FromBytes(std::span<const uint8_t>(bytes.data(), bytes.size() - 1));
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+
+    // an empty value with a deep stack of List tags must not recurse without bound
+    std::vector<uint8_t> nested(4, 0);
+    nested.resize(nested.size() + 100000, static_cast<uint8_t>(CLTypeEnum::List));
+    nested.push_back(static_cast<uint8_t>(CLTypeEnum::U8));
+    TEST_EXCEPTION(valueSerializer.FromBytes(nested), std::invalid_argument);
+
+    // the deepest nesting allowed still decodes
+    std::vector<uint8_t> deepest(4, 0);
+    deepest.resize(deepest.size() + CLValueByteSerializer::MAX_TYPE_DEPTH, static_cast<uint8_t>(CLTypeEnum::Option));
+    deepest.push_back(static_cast<uint8_t>(CLTypeEnum::U8));
+    ByteReader deepest_reader(deepest);
+    deepest_reader.ReadSizedBytes();
+    valueSerializer.CLTypeFromBytes(deepest_reader);
+    TEST_CHECK(deepest_reader.IsEmpty());
+
+    // Option and Result tags are 0 or 1, like Bool bytes
+    auto u8 = static_cast<uint8_t>(CLTypeEnum::U8);
+    std::vector<uint8_t> option = {2, 0, 0, 0, 2, 7, static_cast<uint8_t>(CLTypeEnum::Option), u8};
+    TEST_EXCEPTION(valueSerializer.FromBytes(option), std::runtime_error);
+    option[4] = 1;
+    TEST_CHECK(valueSerializer.ToBytes(valueSerializer.FromBytes(option)) == CBytes(option.data(), option.size()));
+    std::vector<uint8_t> result = {2, 0, 0, 0, 2, 7, static_cast<uint8_t>(CLTypeEnum::Result), u8, u8};
+    TEST_EXCEPTION(valueSerializer.FromBytes(result), std::runtime_error);
+
+    // a List or Map count beyond what the remaining bytes can hold is rejected
+    auto list = static_cast<uint8_t>(CLTypeEnum::List);
+    auto unit = static_cast<uint8_t>(CLTypeEnum::Unit);
+    std::vector<uint8_t> units = {4, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, list, unit};
+    TEST_EXCEPTION(valueSerializer.FromBytes(units), std::runtime_error);
+    std::vector<uint8_t> three_units = {4, 0, 0, 0, 3, 0, 0, 0, list, unit};
+    TEST_CHECK(valueSerializer.ToBytes(valueSerializer.FromBytes(three_units)) ==
+               CBytes(three_units.data(), three_units.size()));
+    std::vector<uint8_t> bytes_list = {5, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, 7, list, u8};
+    TEST_EXCEPTION(valueSerializer.FromBytes(bytes_list), std::runtime_error);
+    std::vector<uint8_t> unit_keys = {6, 0, 0, 0, 2, 0, 0, 0, 7, 7, static_cast<uint8_t>(CLTypeEnum::Map), unit, u8};
+    TEST_EXCEPTION(valueSerializer.FromBytes(unit_keys), std::runtime_error);
+
+    // the counts of nested Lists share one budget, a few bytes can not add up to a huge value
+    // 100 inner Lists of 65536 Units each, in 404 bytes
+    std::vector<uint8_t> nested_units = {0x94, 0x01, 0, 0, 100, 0, 0, 0};
+    for (size_t i = 0; i < 100; i++)
+    {
+        nested_units.insert(nested_units.end(), {0, 0, 1, 0});
+    }
+    nested_units.insert(nested_units.end(), {list, list, unit});
+    TEST_EXCEPTION(valueSerializer.FromBytes(nested_units), std::runtime_error);
+    std::vector<uint8_t> few_nested_units = {12, 0, 0, 0, 2, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, list, list, unit};
+    TEST_CHECK(valueSerializer.ToBytes(valueSerializer.FromBytes(few_nested_units)) ==
+               CBytes(few_nested_units.data(), few_nested_units.size()));
+
+    // Any takes up the rest of the bytes, so it is only read as the whole value
+    auto any = static_cast<uint8_t>(CLTypeEnum::Any);
+    std::vector<uint8_t> whole_any = {3, 0, 0, 0, 1, 2, 3, any};
+    TEST_CHECK(valueSerializer.ToBytes(valueSerializer.FromBytes(whole_any)) ==
+               CBytes(whole_any.data(), whole_any.size()));
+    std::vector<uint8_t> any_list = {6, 0, 0, 0, 2, 0, 0, 0, 1, 2, list, any};
+    TEST_EXCEPTION(valueSerializer.FromBytes(any_list), std::runtime_error);
+    std::vector<uint8_t> any_tuple = {2, 0, 0, 0, 1, 2, static_cast<uint8_t>(CLTypeEnum::Tuple2), any, u8};
+    TEST_EXCEPTION(valueSerializer.FromBytes(any_tuple), std::runtime_error);
+
+    // so is the tag of the optional version of a stored versioned contract
+    CBytes versioned = itemSerializer.ToBytes(ExecutableDeployItem(StoredVersionedContractByName("counter", "inc")));
+    std::vector<uint8_t> bad_version(versioned.begin(), versioned.end());
+    bad_version[1 + 4 + 7] = 2;
+    TEST_EXCEPTION(itemSerializer.FromBytes(std::span<const uint8_t>(bad_version)), std::runtime_error);
+}
+
 } // namespace Casper
\ No newline at end of file
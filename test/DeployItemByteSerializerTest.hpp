@@ -4,6 +4,7 @@
 #include "Types/GlobalStateKey.h"
 #include "Types/PublicKey.h"
 #include "Utils/CryptoUtil.h"
+#include <fstream>
 #include <sstream>
 #include "Types/CLType.h"
 #include "Types/CLConverter.h"
@@ -24,4 +25,10 @@ void DeployItem_ByteSer_StoredVersionedContractByName_Test(void);
 
 void DeployItem_ByteSer_Transfer_Test(void);
 
+void Deploy_ByteSer_ComputeHashes_Test(void);
+
+void Deploy_ByteSer_SizeOf_Test(void);
+
+void Deploy_ByteSer_FromBytes_Test(void);
+
 } // namespace Casper
\ No newline at end of file
@@ -30,7 +30,7 @@ std::string getTimestampNow()
 
 Casper::DeployHeader getHeader(const std::string& pubKey)
 {
-    return {Casper::PublicKey::FromHexString(pubKey), getTimestampNow(), "30m", 1, "", {}, "casper-test"};
+    return {Casper::PublicKey::FromHexString(pubKey), getTimestampNow(), "30m", 1, {}, {}, "casper-test"};
 }
 
 Casper::PutDeployResult putDeploy(Casper::Deploy& deploy, Casper::Secp256k1Key& secp256k1Key)
@@ -67,7 +67,7 @@ void sendCoins(const std::string& sender, const std::string& receiver, const std
 
     Casper::Secp256k1Key secp256k1Key(privateKeyPem);
 
-    std::string signature = secp256k1Key.sign(deploy.hash);
+    std::string signature = secp256k1Key.sign(deploy.hash.ToString());
 
     putDeploy(deploy, secp256k1Key);
 }
@@ -113,7 +113,7 @@ void chainGetStateRootHash_with_blockHeightTest(void)
     Client client(CASPER_TEST_ADDRESS);
 
     uint64_t block_height = 10;
-    std::string result = client.GetStateRootHash(block_height).state_root_hash;
+    std::string result = client.GetStateRootHash(block_height).state_root_hash.ToString();
     std::string expected_result = "4d180287e6eb3dad5173864e30d7653c01fcdef8bc3ee31db4a0707367154ccf";
 
     TEST_ASSERT(iequals(result, expected_result));
@@ -132,7 +132,7 @@ void chainGetStateRootHash_with_invalidBlockHeightTest(void)
     uint64_t block_height = 100000000;
     try
     {
-        std::string result = client.GetStateRootHash(block_height).state_root_hash;
+        std::string result = client.GetStateRootHash(block_height).state_root_hash.ToString();
     }
     catch (const jsonrpccxx::JsonRpcException& e)
     {
@@ -152,7 +152,7 @@ void chainGetStateRootHash_with_blockHashTest(void)
     Client client(CASPER_TEST_ADDRESS);
 
     std::string block_hash = "9511adf5ed36ccba48d71840fd558d4397c9eb0470d1e25711b5419632a6f55a";
-    std::string result = client.GetStateRootHash(block_hash).state_root_hash;
+    std::string result = client.GetStateRootHash(block_hash).state_root_hash.ToString();
     std::string expected_result = "9aa3c10d4db2e02adb464458c7a09d1df2ed551be02d2c7bbdbe847d3731e84f";
 
     TEST_ASSERT(iequals(result, expected_result));
@@ -167,7 +167,7 @@ void chainGetStateRootHash_with_emptyParameterTest(void)
 {
     Client client(CASPER_TEST_ADDRESS);
 
-    std::string result = client.GetStateRootHash().state_root_hash;
+    std::string result = client.GetStateRootHash().state_root_hash.ToString();
 
     TEST_ASSERT(result != "");
 }
@@ -235,7 +235,7 @@ void infoGetStatus_with_emptyParameterTest(void)
     std::string expected_chainspec_name = "casper-test";
     TEST_ASSERT(iequals(result.chainspec_name, expected_chainspec_name));
 
-    TEST_ASSERT(result.starting_state_root_hash != "");
+    TEST_ASSERT(!result.starting_state_root_hash.IsZero());
 
     if (result.our_public_signing_key.has_value())
     {
@@ -245,10 +245,10 @@ void infoGetStatus_with_emptyParameterTest(void)
     if (result.last_added_block_info.has_value())
     {
         auto& last_block = result.last_added_block_info.value();
-        TEST_ASSERT(last_block.hash != "");
+        TEST_ASSERT(!last_block.hash.IsZero());
         TEST_ASSERT(last_block.height >= 0);
         TEST_ASSERT(last_block.timestamp != "");
-        TEST_ASSERT(last_block.state_root_hash != "");
+        TEST_ASSERT(!last_block.state_root_hash.IsZero());
         TEST_ASSERT(last_block.creator.ToString() != "");
     }
 
@@ -289,7 +289,7 @@ void chainGetBlockTransfers_with_blockHashTest(void)
     TEST_ASSERT(result.api_version != "");
 
     TEST_ASSERT(result.block_hash.has_value());
-    TEST_ASSERT(iequals(result.block_hash.value(), expected_block_hash));
+    TEST_ASSERT(iequals(result.block_hash.value().ToString(), expected_block_hash));
 
     // check transfers
     TEST_ASSERT(result.transfers.has_value());
@@ -297,12 +297,12 @@ void chainGetBlockTransfers_with_blockHashTest(void)
 
     auto& transfers = result.transfers.value();
     auto test_transfer = std::find_if(transfers.begin(), transfers.end(),
-                                      [&](const Transfer& x) { return iequals(x.deploy_hash, expected_deploy_hash); });
+                                      [&](const Transfer& x) { return iequals(x.deploy_hash.ToString(), expected_deploy_hash); });
     TEST_ASSERT(test_transfer != transfers.end());
 
     // Actual Values
     uint512_t current_amount = test_transfer->amount;
-    std::string current_deploy_hash = test_transfer->deploy_hash;
+    std::string current_deploy_hash = test_transfer->deploy_hash.ToString();
     std::string current_from = test_transfer->from.ToString();
     uint512_t current_gas = test_transfer->gas;
     std::string current_source = test_transfer->source.ToString();
@@ -333,19 +333,19 @@ void chainGetBlock_with_blockHashTest(void)
     TEST_ASSERT(blockResult.block.has_value());
     auto& current_block = blockResult.block.value();
 
-    TEST_ASSERT(iequals(current_block.hash, "c512989d5a850bd9cc32fbf54a2046ee422f8a14e1e9003189a7cf987340d073"));
+    TEST_ASSERT(iequals(current_block.hash.ToString(), "c512989d5a850bd9cc32fbf54a2046ee422f8a14e1e9003189a7cf987340d073"));
 
     // block header
     TEST_ASSERT(
-        iequals(current_block.header.parent_hash, "45a089f5d0575227721526d59b24ab6e860b560d709d9b1760b4378a363c142b"));
+        iequals(current_block.header.parent_hash.ToString(), "45a089f5d0575227721526d59b24ab6e860b560d709d9b1760b4378a363c142b"));
 
-    TEST_ASSERT(iequals(current_block.header.state_root_hash,
+    TEST_ASSERT(iequals(current_block.header.state_root_hash.ToString(),
                         "116c27db7fbc6ea1c8dcd41b21f655e22913478962a27c746ac68796644f528c"));
 
     TEST_ASSERT(
-        iequals(current_block.header.body_hash, "9b79475df86baafbf93ac59a5b11a462157383fe0101ee235cd8aee58daf14cd"));
+        iequals(current_block.header.body_hash.ToString(), "9b79475df86baafbf93ac59a5b11a462157383fe0101ee235cd8aee58daf14cd"));
 
-    TEST_ASSERT(iequals(current_block.header.accumulated_seed,
+    TEST_ASSERT(iequals(current_block.header.accumulated_seed.ToString(),
                         "5f93e8f2fb07f0df9a1bc5e76fa752d603f844e5cfa55ed6f2d6fff2faefd6f7"));
 
     TEST_ASSERT(current_block.header.timestamp != "");
@@ -380,9 +380,9 @@ void chainGetEraInfoBySwitchBlock_with_blockHashTest(void)
     TEST_ASSERT(result.api_version != "");
     TEST_ASSERT(result.era_summary.has_value());
     TEST_ASSERT(result.era_summary.value().era_id != 0);
-    TEST_ASSERT(result.era_summary.value().block_hash != "");
+    TEST_ASSERT(!result.era_summary.value().block_hash.IsZero());
     TEST_ASSERT(result.era_summary.value().merkle_proof != "");
-    TEST_ASSERT(result.era_summary.value().state_root_hash != "");
+    TEST_ASSERT(!result.era_summary.value().state_root_hash.IsZero());
     TEST_ASSERT(result.era_summary.value().stored_value.era_info.has_value());
     TEST_ASSERT(result.era_summary.value().stored_value.era_info.value().seigniorage_allocations.size() > 0);
 
@@ -444,7 +444,7 @@ void stateGetItem_with_keyTest(void)
     auto& current_transfer = result.stored_value.transfer.value();
 
     TEST_ASSERT(
-        iequals(current_transfer.deploy_hash, "8e535d2baed76141ab47fd93b04dd61f65a07893b7c950022978a2b29628edd7"));
+        iequals(current_transfer.deploy_hash.ToString(), "8e535d2baed76141ab47fd93b04dd61f65a07893b7c950022978a2b29628edd7"));
 
     TEST_ASSERT(iequals(current_transfer.from.ToString(),
                         "account-hash-"
@@ -565,7 +565,7 @@ void stateGetAuctionInfo_with_blockHashTest(void)
     // tests
     TEST_ASSERT(auction_result.api_version != "");
 
-    TEST_ASSERT(iequals(auction_result.auction_state.state_root_hash,
+    TEST_ASSERT(iequals(auction_result.auction_state.state_root_hash.ToString(),
                         "fb9847a919b0745e3bea1cc25f3ad4ad5fee0e18fe4bebd303a9e7a93508ddb8"));
 
     TEST_ASSERT(auction_result.auction_state.block_height == 569706);
@@ -641,8 +641,9 @@ void PutDeploy_StoredContractByHash_Test(void)
 
 void globalStateKey_Simple_Test(void)
 {
-    GlobalStateKey key, key2;
-    key.key = "uref-2f9ac53033ea0b3bae7df8047be450478b69b48d91db7243791b26598af9fcf0-007";
+    GlobalStateKey key = GlobalStateKey::FromString(
+        "uref-2f9ac53033ea0b3bae7df8047be450478b69b48d91db7243791b26598af9fcf0-007");
+    GlobalStateKey key2;
     nlohmann::json j;
     to_json(j, key);
     from_json(j, key2);